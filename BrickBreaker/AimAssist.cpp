@@ -0,0 +1,105 @@
+/**
+ * \file AimAssist.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the preview of the path a ball attached to the paddle would take once released
+ */
+#include <algorithm>
+#include <cmath>
+#include "AimAssist.h"
+#include "Constants.h"
+
+using namespace sf;
+using namespace std;
+
+AimAssist::AimAssist()
+        : radius_(0),
+          gridVersion_(0),
+          numVertices_(0)
+{
+}
+
+bool AimAssist::update(const Vector2f& start, const Vector2f& velocity, float radius, const FloatRect& stage,
+                       const BrickGrid& grid) {
+    if (numVertices_ > 0 && start == start_ && velocity == velocity_ && radius == radius_
+        && grid.getVersion() == gridVersion_) {
+        return false;
+    }
+
+    start_ = start;
+    velocity_ = velocity;
+    radius_ = radius;
+    gridVersion_ = grid.getVersion();
+    numVertices_ = 0;
+
+    float speed = sqrtf(velocity.x * velocity.x + velocity.y * velocity.y);
+    if (speed == 0)
+        return true;
+
+    // Where the ball's center turns around at each wall
+    float left = stage.left + radius;
+    float right = stage.left + stage.width - radius;
+    float top = stage.top + radius;
+
+    Vector2f position = start;
+    Vector2f direction = velocity / speed;
+    float remaining = AIM_ASSIST_LENGTH;
+    addPoint(position);
+
+    for (unsigned int bounce = 0; bounce <= AIM_ASSIST_BOUNCES && remaining > 0; ++bounce) {
+        // The nearest wall ahead, or the paddle's height on the way back down, which ends the path
+        float distance = remaining;
+        Vector2f normal(0, 0);
+        if (direction.x < 0 && (left - position.x) / direction.x < distance) {
+            distance = max((left - position.x) / direction.x, 0.f);
+            normal = Vector2f(1, 0);
+        }
+        else if (direction.x > 0 && (right - position.x) / direction.x < distance) {
+            distance = max((right - position.x) / direction.x, 0.f);
+            normal = Vector2f(-1, 0);
+        }
+        if (direction.y < 0 && (top - position.y) / direction.y < distance) {
+            distance = max((top - position.y) / direction.y, 0.f);
+            normal = Vector2f(0, 1);
+        }
+        else if (direction.y > 0 && (start.y - position.y) / direction.y < distance) {
+            distance = max((start.y - position.y) / direction.y, 0.f);
+            normal = Vector2f(0, 0);
+        }
+
+        // Unless a brick is in the way first
+        BrickGrid::Hit hit;
+        if (grid.rayCast(position, direction, distance, radius, hit)) {
+            distance = hit.distance;
+            normal = hit.normal;
+        }
+
+        position += direction * distance;
+        remaining -= distance;
+        addPoint(position);
+        if (normal == Vector2f(0, 0))
+            break;
+
+        // Reflect off whatever was hit
+        direction -= normal * (2 * (direction.x * normal.x + direction.y * normal.y));
+    }
+
+    // Fade out towards the end of the path
+    for (unsigned int i = 0; i < numVertices_; ++i)
+        vertices_[i].color.a = Uint8(200 - 150 * i / (AIM_ASSIST_BOUNCES + 1));
+
+    return true;
+}
+
+void AimAssist::draw(RenderWindow& window) const {
+    if (numVertices_ > 1)
+        window.draw(vertices_, numVertices_, LinesStrip);
+}
+
+void AimAssist::addPoint(const Vector2f& point) {
+    if (numVertices_ < AIM_ASSIST_BOUNCES + 2)
+        vertices_[numVertices_++] = Vertex(point, BALL_COLOR);
+}
@@ -0,0 +1,74 @@
+/**
+ * \file AimAssist.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the preview of the path a ball attached to the paddle would take once released
+ */
+
+#ifndef BRICKBREAKER_AIMASSIST_H
+#define BRICKBREAKER_AIMASSIST_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "BrickGrid.h"
+
+const unsigned int AIM_ASSIST_BOUNCES = 3;      ///< How many bounces off the barrier and bricks the preview shows
+
+const float AIM_ASSIST_LENGTH = 3000;           ///< The longest the previewed path can be, in pixels
+
+/**
+ * \class AimAssist
+ * \brief Traces where an attached ball would go if it were released now, and draws it as a single line strip
+ *
+ * \details The ball is followed in straight lines from bounce to bounce, off the inside of the barrier and off bricks
+ *      found with the game's BrickGrid, until it has bounced AIM_ASSIST_BOUNCES times or comes back down to the paddle.
+ *      Bricks are treated as boxes grown by the ball's radius, so the preview is close to but not exactly what the
+ *      simulation does at a brick's corners.
+ *
+ *      The path only depends on where the ball starts, the velocity it leaves the paddle with (which takes in the
+ *      paddle's rotation), and the bricks, so it is only traced again when one of those changes.
+ */
+class AimAssist {
+public:
+    AimAssist();
+
+    /**
+     * \brief Traces the path again if anything it depends on has changed since it was last traced
+     *
+     * \param start     Where the ball's center is
+     *        velocity  The velocity it would leave the paddle with (see Ball::getLaunchVelocity())
+     *        radius    The ball's radius
+     *        stage     The open area inside the barrier
+     *        grid      The game's bricks, up to date
+     *
+     * \return true if the path was traced again, false if the last one still holds
+     */
+    bool update(const sf::Vector2f& start, const sf::Vector2f& velocity, float radius, const sf::FloatRect& stage,
+                const BrickGrid& grid);
+
+    /**
+     * \brief Draws the path in one draw call
+     */
+    void draw(sf::RenderWindow& window) const;
+
+private:
+    /**
+     * \brief Adds a point to the end of the path
+     */
+    void addPoint(const sf::Vector2f& point);
+
+    // What the path was traced from
+    sf::Vector2f start_;
+    sf::Vector2f velocity_;
+    float radius_;
+    unsigned long gridVersion_;
+
+    sf::Vertex vertices_[AIM_ASSIST_BOUNCES + 2];   ///< The start, each bounce, and where the path ends
+    unsigned int numVertices_;
+};
+
+#endif //BRICKBREAKER_AIMASSIST_H
@@ -0,0 +1,109 @@
+/**
+ * \file Autopilot.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a simple computer player
+ */
+#include "Autopilot.h"
+#include "Ball.h"
+#include "Paddle.h"
+
+using namespace sf;
+
+Autopilot::Autopilot(GraphicsRunner& game, std::vector<Event>* events)
+        : game_(game),
+          events_(events),
+          heldKey_(Keyboard::Unknown),
+          spaceDown_(false),
+          returnDown_(false)
+{
+}
+
+void Autopilot::play() {
+    // Restart the game once it is over
+    if (game_.getStatus() == 'o') {
+        tap(Keyboard::Return, returnDown_);
+        return;
+    }
+
+    // Nothing to do while paused or between levels
+    if (game_.getStatus() != '\0') {
+        return;
+    }
+
+    std::vector<Object*>& objects = game_.getObjects();
+    float paddleX = dynamic_cast<Paddle*>(game_.getPaddle())->getPos()->x;
+
+    // Find the ball to chase. Prefer the lowest ball moving down, otherwise just the lowest ball.
+    const Ball* target = nullptr;
+    bool targetFalling = false;
+    bool anyAttached = false;
+    for (long i = game_.indexOfFirstSafetyBrick_ + game_.numSafetyBricks_ + game_.numBricks_;
+         i < long(objects.size()); ++i) {
+        const Ball* ball = dynamic_cast<const Ball*>(objects[i]);
+
+        if (ball->isAttached()) {
+            anyAttached = true;
+            continue;
+        }
+
+        bool falling = ball->getVelocity().y > 0;
+        if (target == nullptr || (falling && !targetFalling)
+            || (falling == targetFalling && ball->getPosition().y > target->getPosition().y)) {
+            target = ball;
+            targetFalling = falling;
+        }
+    }
+
+    // Keep releasing balls while any are attached
+    if (anyAttached || spaceDown_) {
+        tap(Keyboard::Space, spaceDown_);
+    }
+
+    // Move toward the target, stopping once the paddle is close enough to it
+    Keyboard::Key wantedKey = Keyboard::Unknown;
+    if (target != nullptr) {
+        float offset = target->getPosition().x - paddleX;
+        if (offset > PADDLE_WIDTH / 4) {
+            wantedKey = Keyboard::L;
+        }
+        else if (offset < -PADDLE_WIDTH / 4) {
+            wantedKey = Keyboard::J;
+        }
+    }
+
+    if (wantedKey != heldKey_) {
+        if (heldKey_ != Keyboard::Unknown) {
+            sendKey(Event::KeyReleased, heldKey_);
+        }
+        if (wantedKey != Keyboard::Unknown) {
+            sendKey(Event::KeyPressed, wantedKey);
+        }
+        heldKey_ = wantedKey;
+    }
+}
+
+void Autopilot::sendKey(Event::EventType type, Keyboard::Key key) {
+    Event event;
+    event.type = type;
+    event.key.code = key;
+    event.key.alt = false;
+    event.key.control = false;
+    event.key.shift = false;
+    event.key.system = false;
+
+    if (events_ != nullptr) {
+        events_->push_back(event);
+    }
+    else {
+        game_.handleEvent(event);
+    }
+}
+
+void Autopilot::tap(Keyboard::Key key, bool& isDown) {
+    sendKey(isDown ? Event::KeyReleased : Event::KeyPressed, key);
+    isDown = !isDown;
+}
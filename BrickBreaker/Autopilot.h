@@ -0,0 +1,61 @@
+/**
+ * \file Autopilot.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a simple computer player
+ */
+
+#ifndef BRICKBREAKER_AUTOPILOT_H
+#define BRICKBREAKER_AUTOPILOT_H
+
+#include <vector>
+#include <SFML/Window/Event.hpp>
+#include "GraphicsRunner.h"
+
+/**
+ * \class Autopilot
+ * \brief Plays a game by sending it the same key events a player would
+ *
+ * \details Keeps the paddle under the lowest falling ball, releases attached balls, and restarts the game when it is
+ *      over. Since it only uses key events its games can be recorded and replayed like a player's.
+ */
+class Autopilot {
+public:
+    /**
+     * \brief Parametrized constructor for an autopilot
+     *
+     * \param game      The game to play
+     *        events    If given, key events are added to it instead of being sent to the game, for games that take
+     *                  their input some other way (see VersusSession)
+     */
+    Autopilot(GraphicsRunner& game, std::vector<sf::Event>* events = nullptr);
+
+    /**
+     * \brief Decides what to do this tick and sends the matching key events. Call once before each update or step.
+     */
+    void play();
+
+private:
+    /**
+     * \brief Sends a key press or release event to the game
+     */
+    void sendKey(sf::Event::EventType type, sf::Keyboard::Key key);
+
+    /**
+     * \brief Presses key if it isn't down, or releases it if it is. Keys have to be released before they can be
+     *      pressed again, so tapping a key takes two ticks.
+     */
+    void tap(sf::Keyboard::Key key, bool& isDown);
+
+    GraphicsRunner& game_;  ///< The game being played
+    std::vector<sf::Event>* events_;
+
+    sf::Keyboard::Key heldKey_;     ///< The movement key being held (J or L), Unknown if neither
+    bool spaceDown_;
+    bool returnDown_;
+};
+
+#endif //BRICKBREAKER_AUTOPILOT_H
@@ -12,6 +12,7 @@
 #include <iostream>
 #include "Ball.h"
 #include "Paddle.h"
+#include "Barrier.h"
 
 using namespace sf;
 
@@ -20,7 +21,10 @@ Ball::Ball(GraphicsRunner& game, float xPos, float yPos, float xVel, float yVel,
           circle_(radius, 50),    // 50 is the number of points in the polygon approximation for the circle
           vel_(xVel, yVel),
           attachedPos_(nullptr),
-          collisionState_(false)
+          id_(game.nextBallId_++),
+          resizeTimer_(0),
+          trailStart_(0),
+          trailSize_(0)
 {
     // Measure position from the center of the ball
     circle_.setOrigin(radius,radius);
@@ -32,6 +36,7 @@ Ball::Ball(GraphicsRunner& game, float xPos, float yPos, float xVel, float yVel,
     circle_.setFillColor(color);
 
     circle_.setPosition(xPos, yPos);
+    previousPosition_ = circle_.getPosition();
 }
 
 Ball::Ball(GraphicsRunner& game, Color color, float radius)
@@ -39,7 +44,10 @@ Ball::Ball(GraphicsRunner& game, Color color, float radius)
           circle_(radius, 50),   // 50 is the number of points in the polygon approximation for the circle
           vel_(0,0),
           attachedPos_(dynamic_cast<Paddle*>(game_.getPaddle())->getPos()),
-          collisionState_(false)
+          id_(game.nextBallId_++),
+          resizeTimer_(0),
+          trailStart_(0),
+          trailSize_(0)
 {
     // Measure position from the center of the ball
     circle_.setOrigin(radius,radius);
@@ -49,51 +57,110 @@ Ball::Ball(GraphicsRunner& game, Color color, float radius)
     circle_.setOutlineColor(DEFAULT_COLOR);
 
     circle_.setFillColor(color);
+
+    // Start on the paddle rather than at the origin, in case the ball is released before it first moves
+    circle_.setPosition(attachedPos_->x, attachedPos_->y - radius);
+    previousPosition_ = circle_.getPosition();
 }
 
 void Ball::draw(sf::RenderWindow& window) const {
     window.draw(circle_);
 }
 
+void Ball::drawInterpolated(sf::RenderWindow& window, float alpha) const {
+    Transform transform;
+    transform.translate((previousPosition_ - circle_.getPosition()) * (1 - alpha));
+    window.draw(circle_, transform);
+}
+
+void Ball::rememberPosition() {
+    previousPosition_ = circle_.getPosition();
+
+    // A ball on the paddle has no trail, and starts a new one once it is released
+    if (isAttached()) {
+        trailSize_ = 0;
+        return;
+    }
+
+    // Overwrite the oldest position once the buffer is full
+    if (trailSize_ < BALL_TRAIL_LENGTH) {
+        trail_[(trailStart_ + trailSize_) % BALL_TRAIL_LENGTH] = previousPosition_;
+        ++trailSize_;
+    }
+    else {
+        trail_[trailStart_] = previousPosition_;
+        trailStart_ = (trailStart_ + 1) % BALL_TRAIL_LENGTH;
+    }
+}
+
+unsigned int Ball::writeTrail(Vertex* vertices, float alpha) const {
+    if (trailSize_ == 0)
+        return 0;
+
+    // Walk back from where the ball is drawn, so the trail is always attached to it
+    Vector2f point = previousPosition_ + (circle_.getPosition() - previousPosition_) * alpha;
+    float speed = sqrtf(vel_.x * vel_.x + vel_.y * vel_.y);
+    Vector2f normal = speed > 0 ? Vector2f(-vel_.y / speed, vel_.x / speed) : Vector2f(0, 0);
+    unsigned int numVertices = 0;
+    for (unsigned int i = 0; i <= trailSize_; ++i) {
+        // Side to side across the trail, keeping the last direction where the ball didn't move
+        Vector2f next = i < trailSize_ ? trail_[(trailStart_ + trailSize_ - 1 - i) % BALL_TRAIL_LENGTH] : point;
+        Vector2f along = point - next;
+        float length = sqrtf(along.x * along.x + along.y * along.y);
+        if (length > .01f)
+            normal = Vector2f(-along.y / length, along.x / length);
+
+        // As wide as the ball at its head, narrowing and fading to nothing at its tail
+        float fraction = 1 - float(i) / BALL_TRAIL_LENGTH;
+        Vector2f offset = normal * (circle_.getRadius() * fraction);
+        Color color = circle_.getFillColor();
+        color.a = Uint8(110 * fraction);
+
+        vertices[numVertices++] = Vertex(point + offset, color);
+        vertices[numVertices++] = Vertex(point - offset, color);
+        point = next;
+    }
+
+    return numVertices;
+}
+
 void Ball::move() {
     // Deal with collision handling:
 
-    // First save the ball's bounds
-    FloatRect bounds = circle_.getGlobalBounds();
+    // First get the ball's shape, which every test below takes without changing it
+    Circle shape = getShape();
 
     // Quick check to see if the ball has left the stage
-    if (bounds.top > game_.windowSize_.y) {
+    if (shape.center.y - shape.radius > game_.windowSize_.y) {
         // If it has, mark it for deletion.
         delete_ = true;
         return;
     }
 
-    // Save a list of the game's objects for repeated access in collision checking
-    std::vector<Object*>& objects = game_.getObjects();
-
-    // This if statement allows for collision checking to terminate if the ball is attached, or if a collision occurs.
-    if (isAttached()                                   ||      // Ensure the ball isn't attached
-        (handleBarrierCollisions(bounds))           ||      // Check for barrier collision, if none,
-        (handlePaddleCollisions(bounds))            ||      // Check for paddle collision, if none,
-        (handleBrickCollisions(bounds, objects))    ||      // check for any brick collisions, if none,
-        (handleBallCollisions(bounds, objects)))            // check for a collision with any of the balls.
-    {
-        // If the ball did collide (wasn't attached) then move it a bit extra to help prevent it from getting stuck
-        if (!isAttached()) {
-            circle_.move(vel_.x * .5f, vel_.y * .5f);
-        }
+    // If the ball has been big or tiny long enough, return it to normal (does nothing if it is already normal)
+    if (game_.getGameTime() >= resizeTimer_ && circle_.getRadius() != BALL_RADIUS) {
+        setRadius(BALL_RADIUS);
+        shape = getShape();
     }
 
-    // Collision check is done, so mark the ball as such
-    collisionState_ = !collisionState_;
-
     // If the ball is attached, match its position to that of its attached object
     if (isAttached()) {
         circle_.setPosition(attachedPos_->x, attachedPos_->y - circle_.getRadius());
     }
 
-    // Slow down the ball if it is moving too fast (prevents collision issues at high speeds)
-    if (vel_.x > BALL_MAX_SPEED || vel_.y > BALL_MAX_SPEED) {
+    // Otherwise gather every contact with the barrier, paddle and bricks before responding to any of them, so the ball
+    // bounces off all of them at once whatever order they are tested in. Collisions with other balls were resolved for
+    // every ball at once before any of them moved (see BallContacts).
+    else {
+        ContactSum sum{Vector2f(0, 0), Vector2f(0, 0), 0, false};
+        addBarrierContacts(shape, sum);
+        addPaddleContact(shape, sum);
+        addBrickContacts(shape, game_.getObjects(), sum);
+        respond(sum);
+    }
+
+    // Slow down the ball if it is moving too fast either way (prevents collision issues at high speeds)
+    if (fabsf(vel_.x) > BALL_MAX_SPEED || fabsf(vel_.y) > BALL_MAX_SPEED) {
         vel_.x *= .99;
         vel_.y *= .99;
     }
@@ -102,35 +169,42 @@ void Ball::move() {
     circle_.move(vel_);
 }
 
-const char Ball::collision(FloatRect& boundingBox) const {
-    // Attached balls do not collide
-    if (isAttached()) {return 'n';}
-
-    // Save the center of both balls for repeated access
-    Vector2f thisCenter = circle_.getPosition();
-    Vector2f otherCenter(boundingBox.left + boundingBox.width / 2, boundingBox.top + boundingBox.height / 2);
-
-    // If the two balls are less than the sum of their radii apart, and not at the same location, they have collided.
-    // Use radius/4 to prevent rounding issues where the distance should be 0 but is actually a very small number.
-    float distance = powf(powf(thisCenter.x - otherCenter.x, 2) + powf(thisCenter.y - otherCenter.y, 2), .5);
-    if (distance < boundingBox.width / 2 + circle_.getRadius() && distance > circle_.getRadius() / 4) {
-        // Store position and velocity data for this ball in the referenced bounding box
-        boundingBox.left = thisCenter.x;
-        boundingBox.top = thisCenter.y;
-        boundingBox.width = vel_.x;
-        boundingBox.height = vel_.y;
-
-        return 'y';
-    }
-
-    // Otherwise they have not
-    return 'n';
+Circle Ball::getShape() const {
+    // The outline is part of the ball as far as collisions go
+    return Circle{circle_.getPosition(), circle_.getRadius() + circle_.getOutlineThickness(), vel_};
 }
 
 void Ball::setVelocity(const Vector2f& velocity) {
     vel_ = velocity;
 }
 
+const Vector2f& Ball::getPosition() const {
+    return circle_.getPosition();
+}
+
+float Ball::getRadius() const {
+    return circle_.getRadius();
+}
+
+void Ball::resize(float radius) {
+    setRadius(radius);
+    resizeTimer_ = game_.getGameTime() + BALL_RESIZE_TIME;
+}
+
+void Ball::setRadius(float radius) {
+    // Keep the ball's center where it is
+    circle_.setRadius(radius);
+    circle_.setOrigin(radius, radius);
+}
+
+uint32_t Ball::getId() const {
+    return id_;
+}
+
+const Vector2f& Ball::getVelocity() const {
+    return vel_;
+}
+
 bool Ball::isAttached() const {
     return (attachedPos_ != nullptr);
 }
@@ -141,238 +215,146 @@ void Ball::detach() {
     // and move it one step back upward so it will collide with the paddle and bounce at the appropriate angle
     circle_.move(-vel_);
 
-    // Add a slight deviation to make the game a little harder
-    vel_.x = ((rand() % 10) - 5) / 20.0f;
+    // Add a slight deviation to make the game a little harder. Uses the game's generator so replays are deterministic.
+    vel_.x = (int(game_.random_() % 10) - 5) / 20.0f;
 
     // And detach the ball
     attachedPos_ = nullptr;
 }
 
-bool Ball::handlePaddleCollisions(const sf::FloatRect& bounds) {
-    // Copy the other objects bounds since it could be modified by a call to collision()
-    FloatRect boundsCopy = bounds;
-
-    // Get the type of collision (vertical or circle).
-    char c = game_.getPaddle()->collision(boundsCopy);
-
-    // If the ball hit the top or bottom of the paddle
-    if (c == 'v') {
-        // The ball has collided with the circular sides of the paddle
-        // Get the angle of collision so we can rotate into a simpler collision frame
-        float contactAngle = -boundsCopy.left;
-
-        // Create a vector out of the paddle's velocity
-        Vector2f otherVel(boundsCopy.width, boundsCopy.height);
-
-        // Create a rotation transformation and move the ball's and the paddle's velocity into the contact point frame
-        Transform rotation;
-        rotation.rotate(contactAngle);
-        vel_ = rotation.transformPoint(vel_);
-        otherVel = rotation.transformPoint(otherVel);
+Vector2f Ball::getLaunchVelocity() const {
+    std::minstd_rand random = game_.random_;
+    Vector2f vel((int(random() % 10) - 5) / 20.0f, BALL_MAX_SPEED*.75f);
+
+    // Bounce off the top of the paddle, just as respond() does
+    const Paddle* paddle = dynamic_cast<Paddle*>(game_.getPaddle());
+    const PaddleOrientation& orientation = paddle->getOrientation();
+    const float* reflection = orientation.reflection;
+    float push = paddle->getVelocity() * orientation.normalX * 1.1f;
+    return Vector2f(reflection[0] * vel.x + reflection[1] * vel.y + push * orientation.normalX,
+                    reflection[2] * vel.x + reflection[3] * vel.y + push * orientation.normalY);
+}
 
-        // Once in this frame, invert this ball's y velocity and add the paddle's velocity to it
-        vel_.y *= -1;
-        vel_.y += otherVel.y * 1.1;
+void Ball::bounce(const Vector2f& normal, const Vector2f& otherVel) {
+    // Reflecting takes away twice the velocity along the normal, the other object's motion adds some back
+    float along = vel_.x * normal.x + vel_.y * normal.y;
+    float push = (otherVel.x * normal.x + otherVel.y * normal.y) * 1.1f;
+    vel_ += normal * (push - 2 * along);
+}
 
-        // and rotate back into normal coordinates
-        rotation.rotate(-2 * contactAngle);
-        vel_ = rotation.transformPoint(vel_);
+void Ball::saveState(GameState::BallState& state) const {
+    state.x = circle_.getPosition().x;
+    state.y = circle_.getPosition().y;
+    state.xVel = vel_.x;
+    state.yVel = vel_.y;
+    state.attached = isAttached();
+    state.id = id_;
+    state.radius = circle_.getRadius();
+    state.resizeTimer = resizeTimer_;
+    state.deleted = delete_;
+}
 
-        // And move the ball slightly so it doesn't get stuck in the paddle
-        //circle_.move(vel_);
+void Ball::restoreState(const GameState::BallState& state) {
+    circle_.setPosition(state.x, state.y);
+    previousPosition_ = circle_.getPosition();
+    trailSize_ = 0;
+    vel_ = Vector2f(state.xVel, state.yVel);
+    id_ = state.id;
+    setRadius(state.radius);
+    resizeTimer_ = state.resizeTimer;
+    delete_ = state.deleted;
+}
 
-        return true;
+bool Ball::addContact(const Contact& contact, ContactSum& sum) const {
+    // Only surfaces the ball is moving into count. One it is still overlapping after bouncing off it last tick is
+    // already behind it.
+    float approach = (vel_.x - contact.otherVel.x) * contact.normal.x
+                     + (vel_.y - contact.otherVel.y) * contact.normal.y;
+    if (approach >= 0) {
+        return false;
     }
 
-    // If the ball hit the circular sides of the paddle
-    else if (c == 's') {
-
-        // The ball has collided with the circular sides of the paddle
-        // Get the angle of collision so we can rotate into a simpler collision frame
-        float contactAngle = getContactAngle(circle_.getPosition(), boundsCopy);
-
-        // Create a vector out of the paddle's velocity
-        Vector2f otherVel(boundsCopy.width, boundsCopy.height);
-
-        // Create a rotation transformation and move both ball's velocity into the contact point frame
-        Transform rotation;
-        rotation.rotate(contactAngle);
-        vel_ = rotation.transformPoint(vel_);
-        otherVel = rotation.transformPoint(otherVel);
-
-        // Once in this frame, invert this ball's y velocity and add the paddle's velocity to it
-        vel_.y *= -1;
-        vel_.y += otherVel.y * 1.1;
+    sum.normal += contact.normal;
+    sum.otherVel += contact.otherVel;
+    ++sum.count;
+    return true;
+}
 
-        // and rotate back into normal coordinates
-        rotation.rotate(-2 * contactAngle);
-        vel_ = rotation.transformPoint(vel_);
+void Ball::addPaddleContact(const Circle& shape, ContactSum& sum) const {
+    const Paddle* paddle = static_cast<Paddle*>(game_.getPaddle());
 
-        // And move the ball slightly so it doesn't get stuck in the paddle
-        //circle_.move(vel_);
+    // Check if the ball is touching the paddle's capsule
+    Contact contact;
+    bool touching = collide(shape, paddle->getShape(), contact);
+    ++game_.profiler_.collisionTests_;
 
-        return true;
+    // If the ball hit the top or bottom of the paddle the normal is the paddle's own
+    if (touching && addContact(contact, sum)) {
+        const PaddleOrientation& orientation = paddle->getOrientation();
+        Vector2f normal(orientation.normalX, orientation.normalY);
+        sum.flatPaddle = contact.normal == normal || contact.normal == -normal;
     }
-
-    // Otherwise no collision has occurred
-    return false;
-};
-
-bool Ball::handleBarrierCollisions(const FloatRect& bounds) {
-    // Copy the other objects bounds since it could be modified by a call to collision()
-    FloatRect boundsCopy = bounds;
-
-    // Get the type of collision (vertical, horizontal or none).
-    char c = game_.getBarrier()->collision(boundsCopy);
-
-    // Colliding with a barrier is purely simple so just return the result of "handleSimpleCollision"
-    return handleSimpleCollision(c);
 }
 
-bool Ball::handleBrickCollisions(const FloatRect& bounds, std::vector<Object*>& objects) {
-
-    // Loop through all the brick objects (safety and regular)
-    for (int i = game_.indexOfFirstSafetyBrick_;
-         i < game_.indexOfFirstSafetyBrick_ + game_.numSafetyBricks_ + game_.numBricks_; ++i) {
-
-        // Copy the other objects bounds since it could be modified by a call to collision()
-        FloatRect boundsCopy = bounds;
-
-        // Get the type of collision (vertical, horizontal or with a point)
-        char c = objects[i]->collision(boundsCopy);
-
-        // First get rid of the brick if necessary
-        if (c != 'n') {
-            // Collision occurred with the brick, mark it for deletion
-            objects[i]->delete_ = true;
-        }
-        // Next handle the impact of the collision on the ball
-
-        // If the collision is simple (ball hitting the sides of a brick) this call will handle it appropriately
-        if (handleSimpleCollision(c)) {
-            return true;
+void Ball::addBarrierContacts(const Circle& shape, ContactSum& sum) const {
+    const Box* walls = static_cast<Barrier*>(game_.getBarrier())->getWalls();
+    Contact contact;
+    for (unsigned int i = 0; i < NUM_BARRIER_WALLS; ++i) {
+        bool touching = collide(shape, walls[i], contact);
+        ++game_.profiler_.collisionTests_;
+        if (touching) {
+            addContact(contact, sum);
         }
-
-        // If the ball hit a corner of the brick
-        else if (c == 'c') {
-            // Note: "boundsCopy" holds the coordinates of the corner collided (coming from the call to collision())
-
-            // Get the angle of collision so we can rotate into a simpler collision frame
-            float contactAngle = getContactAngle(circle_.getPosition(), boundsCopy);
-
-            // Create a rotation transformation and move the ball's velocity into the contact point frame
-            Transform rotation;
-            rotation.rotate(contactAngle);
-            vel_ = rotation.transformPoint(vel_);
-
-            // Once in this frame, simply invert the ball's y velocity
-            vel_.y *= -1;
-
-            // and rotate back into normal coordinates
-            rotation.rotate(-2 * contactAngle);
-            vel_ = rotation.transformPoint(vel_);
-            return true;
-        }
-        // Otherwise the ball did not collide with this brick
     }
-
-    // The ball did not collide with any brick
-    return false;
 }
 
-bool Ball::handleBallCollisions(const FloatRect& bounds, std::vector<Object*>& objects) {
-    // Loop through all the ball objects
-    // Balls occur after the index of the last brick
-    for (int i = game_.indexOfFirstSafetyBrick_ + game_.numSafetyBricks_ + game_.numBricks_;
-         i < objects.size(); ++i) {
-
-        // Get the object
-        Object* object = objects[i];
-
-        if (Ball* ball = dynamic_cast<Ball*>(object)) {
-            // If the other ball has already changed its collision state, it has done collision checking and thus
-            // this ball does not need to check if it has collided with the other one
-            if (ball->collisionState_ != collisionState_) {
-                continue;
-            }
-        }
-
-        // Copy the other objects bounds since it could be modified by a call to collision()
-        FloatRect boundsCopy = bounds;
-
-        // Get the type of collision (yes or no)
-        char c = objects[i]->collision(boundsCopy);
-
-        // Collision has occurred, bounds now holds the x and y coordinates and velocity of the incoming ball
-        if (c == 'y') {
-            // Get the angle of collision so we can rotate into a simpler collision frame
-            float contactAngle = getContactAngle(circle_.getPosition(), boundsCopy);
-
-            // Create a vector out of the other balls velocity
-            Vector2f otherVel(boundsCopy.width, boundsCopy.height);
-
-            // Create a rotation transformation and move both ball's velocity into the contact point frame
-            Transform rotation;
-            rotation.rotate(contactAngle);
-            vel_ = rotation.transformPoint(vel_);
-            otherVel = rotation.transformPoint(otherVel);
-
-            // Once in this frame, simply swap the two ball's y velocities
-            float temp = vel_.y;
-            vel_.y = otherVel.y;
-            otherVel.y = temp;
+void Ball::addBrickContacts(const Circle& shape, std::vector<Object*>& objects, ContactSum& sum) const {
+    Contact contact;
 
-            // and rotate back into normal coordinates
-            rotation.rotate(-2*contactAngle);
-            vel_ = rotation.transformPoint(vel_);
-            otherVel = rotation.transformPoint(otherVel);
+    // Only the bricks (safety and regular) in the grid cells the ball reaches, which is more than one for a big ball
+    for (long i : game_.getBrickGrid().query(shape)) {
 
-            // Now dynamic cast the current object to a ball
-            Ball* other = dynamic_cast<Ball*>(objects[i]);
-            // and set the other ball's velocity to its new value
-            other->setVelocity(otherVel);
+        // Check if the ball is touching the brick's sides or corners
+        bool touching = collide(shape, static_cast<Brick*>(objects[i])->getShape(), contact);
+        ++game_.profiler_.collisionTests_;
 
-            return true;
+        // Every brick the ball moves into is damaged (or its script is run), not just the first
+        if (touching && addContact(contact, sum)) {
+            game_.hitBrick(i);
         }
-        // Otherwise no collision so do nothing
     }
-
-    return false;
 }
 
-bool Ball::handleSimpleCollision(const char& c) {
-    // Vertical collision, flip y velocity
-    if (c == 'v') {
-        vel_.y *= -1;
-        return true;
+void Ball::respond(const ContactSum& sum) {
+    if (sum.count == 0) {
+        return;
     }
 
-    // Horizontal collision, flip x velocity
-    else if (c == 'h') {
-        vel_.x *= -1;
-        return true;
+    // The top or bottom of the paddle alone
+    if (sum.count == 1 && sum.flatPaddle) {
+        // The paddle's rotation is one of a few, each with its reflection worked out ahead of time
+        const PaddleOrientation& orientation = static_cast<Paddle*>(game_.getPaddle())->getOrientation();
+        Vector2f normal(orientation.normalX, orientation.normalY);
+        const float* reflection = orientation.reflection;
+
+        // Reflect the ball's velocity off the paddle, then add the paddle's velocity along its normal to it
+        float push = (sum.otherVel.x * normal.x + sum.otherVel.y * normal.y) * 1.1f;
+        vel_ = Vector2f(reflection[0] * vel_.x + reflection[1] * vel_.y + push * normal.x,
+                        reflection[2] * vel_.x + reflection[3] * vel_.y + push * normal.y);
+        return;
     }
 
-    // Otherwise, either no collision has occurred or more complex collision handling is needed.
-    return false;
-}
-
-float Ball::getContactAngle(const sf::Vector2f& object1, const sf::FloatRect& object2) const {
-    // The contact angle represents the angle from the positive x axis to the line tangent to the contact point
-    float contactAngle;
+    // Otherwise bounce off the average of the surfaces touched, such as a brick's side, its corner as though it were a
+    // surface facing the ball's center, a row of bricks or a brick and a wall together
+    Vector2f normal = sum.normal;
+    if (sum.count > 1) {
+        float length = sqrtf(normal.x * normal.x + normal.y * normal.y);
 
-    // Pre-calculate the denominator before calculating the arctan to handle the case of a 90° contact angle
-    float denominator = object1.y - object2.top;
-
-    // In a purely tangential collision the contact angle is 90°
-    if (denominator == 0) {
-        contactAngle = 1.570796327f;
-    }
-    // Otherwise need to use arctan to find the angle
-    else {
-        contactAngle =
-                atanf((object1.x - object2.left) / denominator);
+        // Squeezed between opposite surfaces, there is no way out to bounce towards
+        if (length < .001f) {
+            return;
+        }
+        normal = sum.normal / length;
     }
-
-    return contactAngle * 57.295779513f;   // Angle must be in degrees to be used by the rotate() function
+    bounce(normal, sum.otherVel);
 }
@@ -14,9 +14,12 @@
 
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 #include "Object.h"
+#include "Collision.h"
 #include "Constants.h"
 #include "GraphicsRunner.h"
+#include "GameState.h"
 
 /**
  * \class Ball
@@ -54,27 +57,35 @@ public:
     void draw(sf::RenderWindow& window) const;
 
     /**
-     * \brief Adds x and y components of velocity to shape's position
+     * \brief Draws the ball between where it was at the start of the last tick and where it is now
      */
-    void move();
+    void drawInterpolated(sf::RenderWindow& window, float alpha) const;
 
     /**
-     * \brief Checks if another ball has collided with this one
-     *
-     * \details Checks if the two ball's centers are within 2 radii apart, then stores the current balls position and
-     *      velocity data in the passed by reference boundingBox and finally returns the proper collision character.
+     * \brief Remembers where the ball is as the start of the next tick, for drawInterpolated() and the ball's trail
+     */
+    void rememberPosition();
+
+    /**
+     * \brief Writes the ball's trail as a triangle strip, narrowing and fading from where the ball is drawn back
+     *      through its last BALL_TRAIL_LENGTH remembered positions
      *
-     * \param boundingBox A reference to the rectangular bounding box for the incoming object. Also used as a way to
-     *                    "return" more information than just the collision type.
+     * \param vertices  Where to write, with room for at least 2 * (BALL_TRAIL_LENGTH + 1) vertices
+     *        alpha     How far between its last two ticks the ball is drawn (see drawInterpolated())
      *
-     * \return 'y' if a collision has occurred, 'n' otherwise.
-     *      If a collision has occurred, "boundingBox" is updated with the following data:
-     *      boundingBox.left stores this ball's x position
-     *      boundingBox.top stores this ball's y position
-     *      boundingBox.width stores this ball's x velocity
-     *      boundingBox.height stores this ball's y velocity
+     * \return The number of vertices written, 0 if the ball is attached or hasn't moved since it was released
      */
-    const char collision(sf::FloatRect& boundingBox) const;
+    unsigned int writeTrail(sf::Vertex* vertices, float alpha) const;
+
+    /**
+     * \brief Adds x and y components of velocity to shape's position
+     */
+    void move();
+
+    /**
+     * \brief Returns the circle other objects collide with, which includes the ball's outline
+     */
+    Circle getShape() const;
 
     /**
      * \brief Manually set the ball's velocity
@@ -83,6 +94,33 @@ public:
      */
     void setVelocity(const sf::Vector2f& velocity);
 
+    /**
+     * \brief Returns the position of the center of the ball
+     */
+    const sf::Vector2f& getPosition() const;
+
+    /**
+     * \brief Returns the ball's radius, not counting its outline
+     */
+    float getRadius() const;
+
+    /**
+     * \brief Makes the ball big or tiny for BALL_RESIZE_TIME seconds, after which it returns to BALL_RADIUS
+     *
+     * \param radius    The ball's new radius
+     */
+    void resize(float radius);
+
+    /**
+     * \brief Returns the id the game gave the ball, which no other ball in the game has had
+     */
+    uint32_t getId() const;
+
+    /**
+     * \brief Returns the ball's velocity
+     */
+    const sf::Vector2f& getVelocity() const;
+
     /**
      * \brief Returns whether the ball is attached to a paddle
      */
@@ -94,88 +132,93 @@ public:
     void detach();
 
     /**
-     * \brief This boolean flips every frame to prevent redundancy in ball to ball collisions
+     * \brief Returns the velocity an attached ball would leave the paddle with if it were released now
      *
-     * \details See implementation of handleBallCollisions()
+     * \details Works out the velocity detach() would give the ball from a copy of the game's random number generator,
+     *      so the game's own isn't advanced, then bounces it off the top of the paddle as respond() does.
      */
-    bool collisionState_;
+    sf::Vector2f getLaunchVelocity() const;
 
+    /**
+     * \brief Copies the ball's position, velocity and flags into a snapshot
+     */
+    void saveState(GameState::BallState& state) const;
 
-private:
     /**
-     * \brief Handles ball-paddle collisions
-     *
-     * \details If the ball hits the top of the paddle, responds with a simple vertical collision, otherwise responds
-     *      with collision handling for essentially a free ball hitting a rigid yet moving ball.
+     * \brief Sets the ball's position, velocity and flags from a snapshot
      *
-     * \param bounds    The rectangular bounds of the ball.
-     *
-     * \return true if a collision occurs, false otherwise
+     * \note Does not attach or detach the ball, construct it with the right constructor for state.attached first
      */
-    bool handlePaddleCollisions(const sf::FloatRect& bounds);
+    void restoreState(const GameState::BallState& state);
 
+private:
     /**
-     * \brief Handles ball-barrier collisions
-     *
-     * \details Uses simple 4 directional collision handling, responding with either a horizontal or vertical collision.
-     *
-     * \param bounds    The rectangular bounds of the ball.
-     *
-     * \return true if a collision occurs, false otherwise
+     * \struct ContactSum
+     * \brief Every contact the ball is moving into this tick, added together
      */
-    bool handleBarrierCollisions(const sf::FloatRect& bounds);
+    struct ContactSum {
+        sf::Vector2f normal;        ///< The sum of the contacts' normals
+        sf::Vector2f otherVel;      ///< The sum of the other objects' velocities, only the paddle's is ever not 0
+        unsigned int count;
+        bool flatPaddle;            ///< Whether one of the contacts is with the top or bottom of the paddle
+    };
 
     /**
-     * \brief Handles collisions between a ball and a brick
-     *
-     * \details First checks to see if the ball hit a side of the brick (simple vertical or horizontal collision). Then
-     *      checks all 4 corners of the brick in case the ball came in diagonally to an edge, and rebounds the ball
-     *      appropriately based on the angle it came in.
+     * \brief Adds a contact to the sum if the ball is moving into the other object, relative to its velocity
      *
-     * \param bounds    The rectangular bounds of the ball.
-     * \param objects   List of all the game's objects. Used for getting all the game's bricks.
-     *
-     * \return true if a collision occurs, false otherwise
+     * \return true if the contact was added
      */
-    bool handleBrickCollisions(const sf::FloatRect& bounds, std::vector<Object*>& objects);
+    bool addContact(const Contact& contact, ContactSum& sum) const;
 
     /**
-     * \brief Handles ball to ball collisions
-     *
-     * \details Checks if a collision has occurred with each ball, and if so, rotates into the collision
-     *      frame and swaps the y velocities of the two balls.
+     * \brief Adds the ball's contact with the paddle, if any
      *
-     * \note Assumes balls have equal mass and the collision is perfectly elastic
-     *
-     * \param bounds    The rectangular bounds of the (current) ball.
-     * \param objects   List of all the game's objects. Used for getting all the game's balls.
-     *
-     * \return true if a collision occurs, false otherwise
+     * \param shape     The ball's shape
+     *        sum       The contacts found so far
      */
-    bool handleBallCollisions(const sf::FloatRect& bounds, std::vector<Object*>& objects);
+    void addPaddleContact(const Circle& shape, ContactSum& sum) const;
 
     /**
-     * \brief Handles collisions with flat surfaces
-     *
-     * \details Checks if the collision was horizontal or vertical using the character, then flips the x or y velocity.
+     * \brief Adds the ball's contacts with each of the barrier's walls
      *
-     * \param c    The character representing the collision type.
+     * \param shape     The ball's shape
+     *        sum       The contacts found so far
+     */
+    void addBarrierContacts(const Circle& shape, ContactSum& sum) const;
+
+    /**
+     * \brief Adds the ball's contacts with every brick, and damages each brick it moves into
      *
-     * \return true if the collision was handled, false otherwise (no collision or complex collision)
+     * \param shape     The ball's shape
+     *        objects   List of all the game's objects. Used for getting all the game's bricks.
+     *        sum       The contacts found so far
      */
-    bool handleSimpleCollision(const char& c);
+    void addBrickContacts(const Circle& shape, std::vector<Object*>& objects, ContactSum& sum) const;
 
     /**
-     * \brief Gets the angle from the +x axis of a line perpendicular to one connecting the two given points.
+     * \brief Bounces the ball off everything it moved into at once
      *
-     * \details Uses arctan(x distance / y distance) to get proper angle.
+     * \details A lone contact with the top or bottom of the paddle uses the paddle's reflection from
+     *      PADDLE_ORIENTATIONS. Anything else bounces off the average of the contacts' normals, so two bricks side by
+     *      side bounce the ball once rather than twice, and a brick against a wall bounces it out of the corner.
+     */
+    void respond(const ContactSum& sum);
+
+    /**
+     * \brief Bounces the ball off a surface, reflecting its velocity and adding some of the surface's own
      *
-     * \param object1   The coordinates of the center of one object
-     * \param object2   The coordinates of the center of the other object stored in a float rect (.left and .top)
+     * \details Trigonometry free. Used for the barrier, bricks and the paddle's circular sides with the normal of the
+     *      contact found, while the paddle's flat sides use the reflections in PADDLE_ORIENTATIONS.
      *
-     * \return the contact angle in degrees
+     * \param normal      The surface's normal at the contact point, of length 1. Which way it points doesn't matter.
+     *        otherVel    The surface's velocity, 1.1 times which along the normal is added to the ball's
      */
-    float getContactAngle(const sf::Vector2f& object1, const sf::FloatRect& object2) const;
+    void bounce(const sf::Vector2f& normal, const sf::Vector2f& otherVel);
+
+    /**
+     * \brief Changes the ball's radius, keeping its center where it is
+     */
+    void setRadius(float radius);
 
 
     GraphicsRunner& game_;  ///< The game instance this object lies within
@@ -185,6 +228,18 @@ private:
     sf::Vector2f vel_;  ///< The x and y velocity of the ball
 
     const sf::Vector2f* attachedPos_;    ///< A pointer to the position that the ball should match if it attached to an object
+
+    uint32_t id_;                       ///< Names the ball's pairs with other balls, see BallContacts
+
+    double resizeTimer_;                ///< The game time at which a big or tiny ball returns to normal
+
+    sf::Vector2f previousPosition_;     ///< Where the ball was at the start of the last tick
+
+    sf::Vector2f trail_[BALL_TRAIL_LENGTH]; ///< Where the ball was at the start of recent ticks, as a ring buffer
+
+    unsigned int trailStart_;           ///< Index in trail_ of the oldest position
+
+    unsigned int trailSize_;            ///< How many positions trail_ holds, emptied while the ball is attached
 };
 
 
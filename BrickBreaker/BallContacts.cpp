@@ -0,0 +1,137 @@
+/**
+ * \file BallContacts.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the list of pairs of balls touching each other, found and resolved once per tick
+ */
+#include <algorithm>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include "BallContacts.h"
+#include "Ball.h"
+
+using namespace sf;
+using namespace std;
+
+unsigned int BallContacts::find(const vector<Object*>& objects, long firstBall) {
+    sweep_.clear();
+    pairs_.clear();
+
+    for (long i = firstBall; i < long(objects.size()); ++i) {
+        Ball* ball = static_cast<Ball*>(objects[i]);
+        if (ball->isAttached() || ball->delete_)
+            continue;
+
+        Circle shape = ball->getShape();
+        sweep_.push_back(Extent{shape.center.x - shape.radius, shape.center.x + shape.radius, shape, ball->getId(),
+                                ball});
+    }
+
+    // Ties are broken by id so the order is the same however the balls were listed
+    sort(sweep_.begin(), sweep_.end(), [](const Extent& a, const Extent& b) {
+        return a.left < b.left || (a.left == b.left && a.id < b.id);
+    });
+
+    // Each ball only needs testing against those after it that start before it ends, so every pair is tested once.
+    // Each candidate is seen from the ball with the lower id, and laid out for testing four at a time.
+    candidates_.clear();
+    offsetX_.clear();
+    offsetY_.clear();
+    reachSquared_.clear();
+    nearSquared_.clear();
+    for (uint32_t i = 0; i < sweep_.size(); ++i) {
+        for (uint32_t j = i + 1; j < sweep_.size() && sweep_[j].left < sweep_[i].right; ++j) {
+            uint32_t first = sweep_[i].id < sweep_[j].id ? i : j;
+            uint32_t second = sweep_[i].id < sweep_[j].id ? j : i;
+            const Circle& a = sweep_[first].shape;
+            const Circle& b = sweep_[second].shape;
+
+            candidates_.push_back(make_pair(first, second));
+            offsetX_.push_back(a.center.x - b.center.x);
+            offsetY_.push_back(a.center.y - b.center.y);
+            reachSquared_.push_back((a.radius + b.radius) * (a.radius + b.radius));
+            nearSquared_.push_back(a.radius * a.radius / 16);
+        }
+    }
+    unsigned int numTests = (unsigned int)candidates_.size();
+
+    // Pad to a whole number of groups of four with candidates that can't touch, which are never looked at again
+    while (offsetX_.size() % 4 != 0) {
+        offsetX_.push_back(0);
+        offsetY_.push_back(0);
+        reachSquared_.push_back(0);
+        nearSquared_.push_back(0);
+    }
+
+    // The same test Collider<Circle, Circle> starts with, so only pairs that touch get a contact worked out. Every
+    // lane has its own radii, so big, tiny and normal balls are tested together.
+    unsigned long i = 0;
+    Contact contact;
+#ifdef __SSE__
+    for (; i < offsetX_.size(); i += 4) {
+        __m128 x = _mm_loadu_ps(&offsetX_[i]);
+        __m128 y = _mm_loadu_ps(&offsetY_[i]);
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+        int touching = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(distanceSquared, _mm_loadu_ps(&reachSquared_[i])),
+                                                  _mm_cmpgt_ps(distanceSquared, _mm_loadu_ps(&nearSquared_[i]))));
+        for (int lane = 0; lane < 4; ++lane) {
+            if (touching & 1 << lane)
+                addPair(candidates_[i + lane], contact);
+        }
+    }
+#endif
+
+    // One at a time where SSE isn't available
+    for (; i < candidates_.size(); ++i) {
+        float distanceSquared = offsetX_[i] * offsetX_[i] + offsetY_[i] * offsetY_[i];
+        if (distanceSquared < reachSquared_[i] && distanceSquared > nearSquared_[i])
+            addPair(candidates_[i], contact);
+    }
+
+    sort(pairs_.begin(), pairs_.end(), [](const Pair& a, const Pair& b) { return a.id < b.id; });
+    return numTests;
+}
+
+void BallContacts::addPair(const pair<uint32_t, uint32_t>& candidate, Contact& contact) {
+    const Extent& first = sweep_[candidate.first];
+    const Extent& second = sweep_[candidate.second];
+    if (collide(first.shape, second.shape, contact))
+        pairs_.push_back(Pair{uint64_t(first.id) << 32 | second.id, first.ball, second.ball, contact});
+}
+
+void BallContacts::resolve() {
+    for (const Pair& pair : pairs_) {
+        // How fast the first ball is moving away from the second along the normal. The velocities are read again for
+        // each pair since a ball touching two others is bounced by both in turn.
+        const Vector2f& normal = pair.contact.normal;
+        Vector2f firstVel = pair.first->getVelocity();
+        Vector2f secondVel = pair.second->getVelocity();
+        float separating = (firstVel.x - secondVel.x) * normal.x + (firstVel.y - secondVel.y) * normal.y;
+        if (separating >= 0)
+            continue;
+
+        pair.first->setVelocity(firstVel - normal * separating);
+        pair.second->setVelocity(secondVel + normal * separating);
+    }
+}
+
+const vector<BallContacts::Pair>& BallContacts::getPairs() const {
+    return pairs_;
+}
+
+void BallContacts::clear() {
+    sweep_.clear();
+    candidates_.clear();
+    pairs_.clear();
+}
+
+unsigned long BallContacts::getHeapBytes() const {
+    return sweep_.capacity() * sizeof(Extent) + pairs_.capacity() * sizeof(Pair)
+           + candidates_.capacity() * sizeof(candidates_[0])
+           + (offsetX_.capacity() + offsetY_.capacity() + reachSquared_.capacity() + nearSquared_.capacity())
+             * sizeof(float);
+}
@@ -0,0 +1,116 @@
+/**
+ * \file BallContacts.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the list of pairs of balls touching each other, found and resolved once per tick
+ */
+
+#ifndef BRICKBREAKER_BALLCONTACTS_H
+#define BRICKBREAKER_BALLCONTACTS_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Collision.h"
+#include "Object.h"
+
+class Ball;
+
+/**
+ * \class BallContacts
+ * \brief Finds every pair of balls touching each other, each pair once, then bounces them off each other
+ *
+ * \details Balls are sorted by their left edge and swept from left to right, so only balls whose extents along x
+ *      overlap are tested against each other. Each pair found is named by the ids of its two balls, which stay the
+ *      same for as long as the balls exist and are kept in snapshots, and pairs are resolved in order of that id. That
+ *      way the outcome doesn't depend on where the balls are in the game's list of objects, or on which of them moves
+ *      first.
+ *
+ *      The pairs the sweep finds are laid out as arrays of their offsets and radii and tested four at a time with SSE,
+ *      each with its own radii so balls of every size share a batch. Only those that touch go on to the exact test that
+ *      works out their contact.
+ *
+ *      The lists are kept from tick to tick, so finding the pairs only allocates when there are more balls or contacts
+ *      than ever before.
+ */
+class BallContacts {
+public:
+    /**
+     * \struct Pair
+     * \brief Two balls touching each other
+     */
+    struct Pair {
+        uint64_t id;            ///< The lower ball id in the upper half and the higher in the lower, the same every tick
+        Ball* first;            ///< The ball with the lower id
+        Ball* second;
+        Contact contact;        ///< As seen from first
+    };
+
+    /**
+     * \brief Finds every pair of touching balls, leaving out attached balls and those about to be deleted
+     *
+     * \param objects   The game's objects
+     *        firstBall Index of the first ball in objects, every object after which is a ball
+     *
+     * \return How many pairs of balls were tested, for the profiler
+     */
+    unsigned int find(const std::vector<Object*>& objects, long firstBall);
+
+    /**
+     * \brief Bounces every pair found that is moving towards each other
+     *
+     * \details The balls have equal mass and the collision is perfectly elastic, so they swap their velocities along
+     *      the contact normal and keep the rest. Pairs that are already moving apart, because they bounced on an
+     *      earlier tick and still overlap, are left alone so they don't bounce straight back into each other.
+     */
+    void resolve();
+
+    /**
+     * \brief Returns the pairs found by the last call to find(), in order of their ids
+     */
+    const std::vector<Pair>& getPairs() const;
+
+    /**
+     * \brief Forgets the pairs found, since the balls they point to are about to be deleted
+     */
+    void clear();
+
+    /**
+     * \brief Returns how many bytes the lists have allocated
+     */
+    unsigned long getHeapBytes() const;
+
+private:
+    /**
+     * \struct Extent
+     * \brief Where a ball starts and ends along x
+     */
+    struct Extent {
+        float left;
+        float right;
+        Circle shape;
+        uint32_t id;
+        Ball* ball;
+    };
+
+    /**
+     * \brief Works out the contact between a candidate's balls and adds it to the pairs if they touch
+     *
+     * \param candidate The two balls' positions in sweep_, the one with the lower id first
+     *        contact   Scratch space for the contact
+     */
+    void addPair(const std::pair<uint32_t, uint32_t>& candidate, Contact& contact);
+
+    std::vector<Extent> sweep_;     ///< The balls that can collide, sorted by left edge then id
+    std::vector<Pair> pairs_;
+
+    // The pairs the sweep found, and for each the first ball's offset from the second, the square of the sum of their
+    // radii, and the square of how close Collider<Circle, Circle> leaves out. Padded to a multiple of four.
+    std::vector<std::pair<uint32_t, uint32_t>> candidates_;
+    std::vector<float> offsetX_, offsetY_, reachSquared_, nearSquared_;
+};
+
+#endif //BRICKBREAKER_BALLCONTACTS_H
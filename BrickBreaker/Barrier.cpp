@@ -26,6 +26,13 @@ Barrier::Barrier(float windowWidth, float windowHeight, float width, float buffe
     left_.setFillColor(color);
     top_.setFillColor(color);
     right_.setFillColor(color);
+
+    // Keep the walls' bounds for collisions, which only change if the walls move
+    const RectangleShape* walls[NUM_BARRIER_WALLS] = {&left_, &right_, &top_};
+    for (unsigned int i = 0; i < NUM_BARRIER_WALLS; ++i) {
+        FloatRect bounds = walls[i]->getGlobalBounds();
+        walls_[i] = Box{bounds.left, bounds.top, bounds.left + bounds.width, bounds.top + bounds.height};
+    }
 }
 
 void Barrier::draw(sf::RenderWindow& window) const {
@@ -35,15 +42,18 @@ void Barrier::draw(sf::RenderWindow& window) const {
     window.draw(right_);
 }
 
-const char Barrier::collision(FloatRect& boundingBox) const {
-    // Check if the object is colliding with the barrier's left right or top portion
-    if (left_.getGlobalBounds().intersects(boundingBox) || right_.getGlobalBounds().intersects(boundingBox)) {
-        return 'h';     // The other object has hit the barrier's sides, so it is a horizontal collision
-    }
-    else if (top_.getGlobalBounds().intersects(boundingBox)) {
-        return 'v';     // The other object has hit the top of the barrier, so it is a vertical collision
-    }
-    else {
-        return 'n';     // No collision has occurred
-    }
+unsigned int Barrier::getNumDrawCalls() const {
+    return 3;
+}
+
+const Box* Barrier::getWalls() const {
+    return walls_;
+}
+
+FloatRect Barrier::getInnerBounds() const {
+    FloatRect left = left_.getGlobalBounds();
+    FloatRect top = top_.getGlobalBounds();
+    float x = left.left + left.width;
+    float y = top.top + top.height;
+    return FloatRect(x, y, right_.getGlobalBounds().left - x, left.top + left.height - y);
 }
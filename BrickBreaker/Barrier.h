@@ -15,8 +15,11 @@
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/ConvexShape.hpp>
 #include "Object.h"
+#include "Collision.h"
 #include "Constants.h"
 
+const unsigned int NUM_BARRIER_WALLS = 3;
+
 /**
  * \class Barrier
  * \brief A thin "n" shaped wall used to block the top, left and right sides of a window and define a field of play.
@@ -41,19 +44,27 @@ public:
     void draw(sf::RenderWindow& window) const;
 
     /**
-     * \brief Checks if the passed boundingBox intersects the bounds of the barrier
-     *
-     * \return 'h' if the boundingBox intersects the barrier's top wall
-     *         'v' if it intersects the barrier's left or right walls
-     *         'n' otherwise
+     * \brief Returns 3 since the barrier is drawn as three shapes
+     */
+    unsigned int getNumDrawCalls() const;
+
+    /**
+     * \brief Returns the three walls as objects collide with them, in the order left, right, top
      */
-    const char collision(sf::FloatRect& boundingBox) const;
+    const Box* getWalls() const;
+
+    /**
+     * \brief Returns the open area between the three walls, which reaches down to the bottom of the walls
+     */
+    sf::FloatRect getInnerBounds() const;
 
 private:
     ///< The three walls that make up the barrier
     sf::RectangleShape left_;
     sf::RectangleShape top_;
     sf::RectangleShape right_;
+
+    Box walls_[NUM_BARRIER_WALLS];  ///< The bounds of the three walls, which never move
 };
 
 #endif //BRICKBREAKER_BARRIER_H
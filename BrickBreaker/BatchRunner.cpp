@@ -0,0 +1,124 @@
+/**
+ * \file BatchRunner.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a runner for many headless games at once
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include "BatchRunner.h"
+#include "MemoryReport.h"
+#include "StageBuilder.h"
+
+BatchRunner::Context::Context(unsigned int seed)
+        : game(seed),
+          pilot(game)
+{
+}
+
+BatchRunner::BatchRunner(unsigned int numInstances, unsigned int seed, unsigned int numThreads)
+        : contexts_(numInstances, nullptr),
+          seed_(seed),
+          // No point in having threads without games
+          workers_(std::max(1u, std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads,
+                                         numInstances)), true),
+          ticksRun_(0),
+          secondsRun_(0)
+{
+}
+
+BatchRunner::~BatchRunner() {
+    for (Context* context : contexts_) {
+        if (context != nullptr) {
+            context->~Context();
+            free(context);
+        }
+    }
+}
+
+void BatchRunner::run(unsigned long numTicks) {
+    // Every game would try to create the data folder otherwise, and one could read a level while another writes it
+    StageBuilder::checkDataFile();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    workers_.run([this, numTicks](unsigned int worker) { work(worker, numTicks); });
+
+    secondsRun_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ticksRun_ = numTicks;
+}
+
+void BatchRunner::work(unsigned int worker, unsigned long numTicks) {
+    // Create this worker's games on this thread so their memory starts out local to this core. new doesn't have to
+    // honor alignments bigger than a pointer's before C++17, so allocate the aligned memory directly.
+    unsigned int numThreads = workers_.getNumThreads();
+    for (unsigned long i = worker; i < contexts_.size(); i += numThreads) {
+        if (contexts_[i] == nullptr) {
+            void* memory = nullptr;
+            if (posix_memalign(&memory, alignof(Context), sizeof(Context)) != 0) {
+                throw std::bad_alloc();
+            }
+            contexts_[i] = new (memory) Context(seed_ + (unsigned int)i);
+        }
+    }
+
+    // Step every game a tick at a time so they all progress evenly
+    for (unsigned long tick = 0; tick < numTicks; ++tick) {
+        for (unsigned long i = worker; i < contexts_.size(); i += numThreads) {
+            contexts_[i]->pilot.play();
+            contexts_[i]->game.step();
+        }
+    }
+}
+
+void BatchRunner::writeSummary(std::ostream& out) const {
+    unsigned long numInstances = contexts_.size();
+    unsigned long totalTicks = ticksRun_ * numInstances;
+
+    out << "Instances: " << numInstances << " on " << workers_.getNumThreads() << " threads\n";
+    out << "Ticks per instance: " << ticksRun_ << "\n";
+    out << "Wall time: " << secondsRun_ << " s\n";
+    if (secondsRun_ > 0) {
+        out << "Throughput: " << totalTicks / secondsRun_ << " ticks/s ("
+            << totalTicks / secondsRun_ / FRAME_RATE << "x real time)\n";
+    }
+
+    if (numInstances == 0 || contexts_[0] == nullptr) {
+        return;
+    }
+
+    // Levels reached
+    int minLevel = contexts_[0]->game.getLevel();
+    int maxLevel = minLevel;
+    unsigned long levelSum = 0;
+    for (const Context* context : contexts_) {
+        int level = context->game.getLevel();
+        minLevel = std::min(minLevel, level);
+        maxLevel = std::max(maxLevel, level);
+        levelSum += level;
+    }
+    out << "Level reached: min " << minLevel << ", mean " << double(levelSum) / numInstances << ", max " << maxLevel
+        << "\n";
+
+    // Memory of one game broken down by subsystem, then the average over all of them. A context's padding for
+    // alignment is counted on top of the game itself.
+    unsigned long totalBytes = 0;
+    for (const Context* context : contexts_) {
+        MemoryReport report;
+        context->game.getMemoryUsage(report);
+        totalBytes += report.getTotalBytes() + sizeof(Context) - sizeof(GraphicsRunner);
+    }
+
+    MemoryReport firstReport;
+    contexts_[0]->game.getMemoryUsage(firstReport);
+    firstReport.add("context", 1, sizeof(Context) - sizeof(GraphicsRunner));
+    out << "Memory of instance 0:\n";
+    firstReport.write(out);
+    out << "Mean bytes per instance: " << totalBytes / numInstances << "\n";
+}
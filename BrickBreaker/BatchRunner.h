@@ -0,0 +1,85 @@
+/**
+ * \file BatchRunner.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a runner for many headless games at once
+ */
+
+#ifndef BRICKBREAKER_BATCHRUNNER_H
+#define BRICKBREAKER_BATCHRUNNER_H
+
+#include <ostream>
+#include <vector>
+#include "Autopilot.h"
+#include "GraphicsRunner.h"
+#include "WorkerPool.h"
+
+/**
+ * \class BatchRunner
+ * \brief Plays many headless games at once, spread over one worker thread per core
+ *
+ * \details Every game is played by an Autopilot. Each worker thread is pinned to its own core and creates its share of
+ *      the games itself, so their memory is first touched (and placed) by the core that runs them. Games are handed
+ *      out round robin and never move between threads. The workers are kept between runs, and the thread calling
+ *      run() is one of them.
+ */
+class BatchRunner {
+public:
+    /**
+     * \brief Parametrized constructor for a batch runner
+     *
+     * \param numInstances  How many games to run
+     *        seed          Seed for the first game. Each game after it gets the next seed.
+     *        numThreads    How many worker threads to use, 0 for one per hardware thread
+     */
+    BatchRunner(unsigned int numInstances, unsigned int seed, unsigned int numThreads = 0);
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    /**
+     * \brief Destroys every game
+     */
+    ~BatchRunner();
+
+    /**
+     * \brief Creates the games if they don't exist yet, then steps each of them numTicks times
+     */
+    void run(unsigned long numTicks);
+
+    /**
+     * \brief Writes the throughput of the last run, the levels the games reached and the memory used per game
+     */
+    void writeSummary(std::ostream& out) const;
+
+private:
+    /**
+     * \struct Context
+     * \brief Everything one game needs, aligned to a cache line so neighbouring games never share one
+     */
+    struct alignas(64) Context {
+        Context(unsigned int seed);
+
+        GraphicsRunner game;
+        Autopilot pilot;
+    };
+
+    /**
+     * \brief Each worker's share of a run
+     *
+     * \param worker    Which worker this is. It runs every game whose index is worker plus a multiple of the number of
+     *                  workers.
+     */
+    void work(unsigned int worker, unsigned long numTicks);
+
+    std::vector<Context*> contexts_;    ///< Written only by the worker that owns each game
+    unsigned int seed_;
+    WorkerPool workers_;
+    unsigned long ticksRun_;            ///< The number of ticks each game was stepped by the last run
+    double secondsRun_;                 ///< Wall time of the last run
+};
+
+#endif //BRICKBREAKER_BATCHRUNNER_H
@@ -8,21 +8,47 @@
  * \brief Implements a brick, an object sub type
  */
 #include <SFML/Graphics/CircleShape.hpp>
+#include <algorithm>
 #include <math.h>
 #include "Brick.h"
+#include "BrickBatch.h"
 
 using namespace sf;
 
 Brick::Brick(float xPos, float yPos, float width, float height, char special, Color color)
-        : rectangle_(Vector2f(width, height)), special_(special)
+        : rectangle_(Vector2f(width, height)), special_(special), script_(-1), hits_(0), registers_(), shade_(0)
 {
     rectangle_.setPosition(xPos, yPos);
+    shape_ = Box{xPos, yPos, xPos + width, yPos + height};
 
     // Safety bricks are colored red, otherwise use the passed color
     if (special_ == 's') {
         rectangle_.setFillColor(SAFETY_BRICK_COLOR);
     }
 
+    // Junk bricks look like what they are
+    else if (special_ == 'j') {
+        rectangle_.setFillColor(JUNK_BRICK_COLOR);
+    }
+
+    // Scripted bricks start in their first shade and change it themselves
+    else if (special_ == 'x') {
+        rectangle_.setFillColor(SCRIPTED_BRICK_COLORS[0]);
+    }
+
+    // Bricks that take several hits start in the darkest shade of their ramp
+    else if (special_ == 'h' || special_ == 'r') {
+        rectangle_.setFillColor(BrickBatch::getHitPointColor(BrickBatch::getMaxHitPoints(special_)));
+    }
+
+    else if (special_ == 'a') {
+        rectangle_.setFillColor(ARMORED_BRICK_COLOR);
+    }
+
+    else if (special_ == 'e') {
+        rectangle_.setFillColor(EXPLOSIVE_BRICK_COLOR);
+    }
+
     // Special bricks have a special color
     else if (special_ != '\0') {
         //rectangle_.setFillColor(Color(0xFFFFFF00u ^ color.toInteger())); // This uses an inverted regular brick color
@@ -39,70 +65,43 @@ void Brick::draw(sf::RenderWindow& window) const {
     window.draw(rectangle_);
 }
 
-const char Brick::collision(sf::FloatRect& boundingBox) const {
-    // Save the current object's bounds and the center of the incoming object for repeated access
-    FloatRect bounds = rectangle_.getGlobalBounds();
-    Vector2f center(boundingBox.left + boundingBox.width / 2, boundingBox.top + boundingBox.height / 2);
-
-    // Also since the incoming object must be a ball, we get its radius using the boundingBox
-    float radius = boundingBox.width / 2;
-
-    // Ensure the two collision boxes at least overlap (not necessarily a collision though)
-    if (bounds.intersects(boundingBox)) {
-
-        // If the brick contains the top or bottom middle point of the incoming object
-        if (bounds.contains(center.x, boundingBox.top)
-                || bounds.contains(center.x, boundingBox.top + boundingBox.height)) {
-
-            return 'v';     // it is a vertical collision with the top or bottom of the brick
-        }
-
-        // If the brick contains the left or right middle point of the incoming object
-        else if (bounds.contains(boundingBox.left, center.y)
-            || bounds.contains(boundingBox.left + boundingBox.width, center.y)) {
-
-            return 'h';     // it is a horizontal collision with the left or right side of the brick
-        }
-
-        // If the incoming object hits the top left corner of the brick
-        else if (pow(pow(center.x - bounds.left, 2) + pow(center.y - bounds.top, 2), .5) < radius) {
-
-            // Save the coordinates of the contact point
-            boundingBox.left = bounds.left;
-            boundingBox.top = bounds.top;
-            return 'c';
-        }
-
-        // If the incoming object hits the top right corner of the brick
-        else if (pow(pow(center.x - (bounds.left + bounds.width), 2) + pow(center.y - bounds.top, 2), .5) < radius) {
-
-            // Save the coordinates of the contact point
-            boundingBox.left = bounds.left + bounds.width;
-            boundingBox.top = bounds.top;
-            return 'c';
-        }
+void Brick::saveState(GameState::BrickState& state) const {
+    state.x = rectangle_.getPosition().x;
+    state.y = rectangle_.getPosition().y;
+    state.width = rectangle_.getSize().x;
+    state.height = rectangle_.getSize().y;
+    state.special = special_;
+    state.deleted = delete_;
+
+    state.script = int8_t(script_);
+    state.hits = int16_t(hits_);
+    state.shade = shade_;
+    std::copy(registers_, registers_ + BRICK_SCRIPT_REGISTERS, state.registers);
+}
 
-        // If the incoming object hits the bottom right corner of the brick
-        else if (pow(pow(center.x - (bounds.left + bounds.width), 2)
-                     + pow(center.y - (bounds.top + bounds.height), 2), .5) < radius) {
+void Brick::restoreState(const GameState::BrickState& state) {
+    delete_ = state.deleted;
 
-            // Save the coordinates of the contact point
-            boundingBox.left = bounds.left + bounds.width;
-            boundingBox.top = bounds.top + bounds.height;
-            return 'c';
-        }
+    script_ = state.script;
+    hits_ = state.hits;
+    std::copy(state.registers, state.registers + BRICK_SCRIPT_REGISTERS, registers_);
+    if (special_ == 'x')
+        setShade(state.shade);
+}
 
-        // If the incoming object hits the bottom left corner of the brick
-        else if (pow(pow(center.x - bounds.left, 2) + pow(center.y - (bounds.top + bounds.height), 2), .5) < radius) {
+void Brick::setShade(int shade) {
+    shade_ = shade % int(NUM_SCRIPTED_BRICK_COLORS);
+    rectangle_.setFillColor(SCRIPTED_BRICK_COLORS[shade_]);
+}
 
-            // Save the coordinates of the contact point
-            boundingBox.left = bounds.left;
-            boundingBox.top = bounds.top + bounds.height;
-            return 'c';
-        }
+FloatRect Brick::getBounds() const {
+    return rectangle_.getGlobalBounds();
+}
 
-        // The corner of the collision box intersects the brick, but the ball itself is not touching so no collision
-    }
+Color Brick::getColor() const {
+    return rectangle_.getFillColor();
+}
 
-    return 'n';     // No collision has occurred
+const Box& Brick::getShape() const {
+    return shape_;
 }
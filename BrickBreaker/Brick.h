@@ -13,8 +13,11 @@
 
 
 #include <SFML/Graphics/RectangleShape.hpp>
+#include "BrickScript.h"
+#include "Collision.h"
 #include "Object.h"
 #include "Constants.h"
+#include "GameState.h"
 
 /**
  * \class Brick
@@ -41,30 +44,62 @@ public:
     void draw(sf::RenderWindow& window) const;
 
     /**
-     * \brief Checks if a ball collided with the brick
-     *
-     * \details If the ball hit one of the bricks sides, just returns the proper collision character. If the ball hit a
-     *      corner of the brick, stores the coordinates of the collided corner in the passed by reference
-     *      boundingBox.
-     *
-     * \return 'v' or 'h' if a collision occurred with one of the sides, 'c' if a collision occurred with a corner.
-     *      If it is a corner collision, "boundingBox" is updated with the following data:
-     *      boundingBox.left stores the impact corner's x position
-     *      boundingBox.top stores the impact corner's y position
+     * \brief Returns the brick's rectangle as balls collide with it
+     */
+    const Box& getShape() const;
+
+    /**
+     * \brief Copies the brick's position, size and flags into a snapshot
+     */
+    void saveState(GameState::BrickState& state) const;
+
+    /**
+     * \brief Restores the flags and script state from a snapshot. The position and size are set by the constructor.
+     */
+    void restoreState(const GameState::BrickState& state);
+
+    /**
+     * \brief Sets the color of a scripted brick to one of SCRIPTED_BRICK_COLORS, wrapping around past the last one
+     */
+    void setShade(int shade);
+
+    /**
+     * \brief Returns the brick's rectangle
      */
-    const char collision(sf::FloatRect& boundingBox) const;
+    sf::FloatRect getBounds() const;
+
+    /**
+     * \brief Returns the color the brick was created with, or its script last set
+     */
+    sf::Color getColor() const;
 
     /**
      * \brief A character representing the brick's special properties (or lack there of)
      *
      * \details ''  represents  a regular brick
      *          'b'             an extra ball brick
+     *          'l'             an extra long paddle brick
+     *          'g'             a big ball brick, which makes every ball in play big for a while
+     *          't'             a tiny ball brick, which makes every ball in play tiny for a while
+     *          'z'             a laser brick, which makes the paddle fire lasers for a while (see Lasers)
      *          's'             a safety brick
+     *          'j'             a junk brick sent by the opponent in versus mode (no special behavior)
+     *          'x'             a scripted brick, which runs script_ when hit instead of being destroyed
+     *          'h'             a hard brick, destroyed by the second hit (see BrickBatch)
+     *          'r'             a reinforced brick, destroyed by the third hit
+     *          'a'             an armored brick, never destroyed
+     *          'e'             an explosive brick, which takes out the bricks around it when destroyed (see Explosions)
      */
     char special_;
 
+    int script_;                                    ///< Which of the level's scripts the brick runs, -1 if none
+    int hits_;                                      ///< How many of the hits on a scripted brick its script has run for
+    int16_t registers_[BRICK_SCRIPT_REGISTERS];     ///< Kept by the brick's script between runs, start at 0
+
 private:
     sf::RectangleShape rectangle_;  ///< A brick is just a rectangle
+    Box shape_;                     ///< The rectangle's bounds, which never change since bricks don't move
+    int shade_;                     ///< Index in SCRIPTED_BRICK_COLORS of a scripted brick's color
 
 };
 
@@ -0,0 +1,131 @@
+/**
+ * \file BrickBatch.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the per-brick state the game changes while a level is played, stored by field, and its vertices
+ */
+#include <algorithm>
+#include "BrickBatch.h"
+
+using namespace sf;
+using namespace std;
+
+BrickBatch::BrickBatch()
+        : numArmored_(0)
+{
+}
+
+void BrickBatch::add(const Brick& brick) {
+    char type = brick.special_;
+    int hitPoints = getMaxHitPoints(type);
+
+    hitPoints_.push_back(uint8_t(hitPoints));
+    types_.push_back(type);
+    colors_.push_back(hitPoints > 1 ? getHitPointColor(hitPoints) : brick.getColor());
+    if (hitPoints == 0)
+        ++numArmored_;
+
+    FloatRect bounds = brick.getBounds();
+    vertices_.push_back(Vertex(Vector2f(bounds.left, bounds.top), colors_.back()));
+    vertices_.push_back(Vertex(Vector2f(bounds.left + bounds.width, bounds.top), colors_.back()));
+    vertices_.push_back(Vertex(Vector2f(bounds.left + bounds.width, bounds.top + bounds.height), colors_.back()));
+    vertices_.push_back(Vertex(Vector2f(bounds.left, bounds.top + bounds.height), colors_.back()));
+}
+
+void BrickBatch::erase(const vector<bool>& removed) {
+    unsigned long kept = 0;
+    for (unsigned long i = 0; i < types_.size(); ++i) {
+        if (removed[i]) {
+            if (types_[i] == 'a')
+                --numArmored_;
+            continue;
+        }
+
+        hitPoints_[kept] = hitPoints_[i];
+        types_[kept] = types_[i];
+        colors_[kept] = colors_[i];
+        for (unsigned int j = 0; j < 4; ++j)
+            vertices_[kept * 4 + j] = vertices_[i * 4 + j];
+        ++kept;
+    }
+
+    hitPoints_.resize(kept);
+    types_.resize(kept);
+    colors_.resize(kept);
+    vertices_.resize(kept * 4);
+}
+
+void BrickBatch::clear() {
+    hitPoints_.clear();
+    types_.clear();
+    colors_.clear();
+    vertices_.clear();
+    numArmored_ = 0;
+}
+
+bool BrickBatch::damage(unsigned long index) {
+    // Armored bricks have no hit points to lose
+    if (hitPoints_[index] == 0)
+        return false;
+
+    if (--hitPoints_[index] == 0)
+        return true;
+
+    setColor(index, getHitPointColor(hitPoints_[index]));
+    return false;
+}
+
+int BrickBatch::getHitPoints(unsigned long index) const {
+    return hitPoints_[index];
+}
+
+void BrickBatch::setHitPoints(unsigned long index, int hitPoints) {
+    hitPoints_[index] = uint8_t(hitPoints);
+    if (hitPoints > 0)
+        setColor(index, getHitPointColor(hitPoints));
+}
+
+char BrickBatch::getType(unsigned long index) const {
+    return types_[index];
+}
+
+const Color& BrickBatch::getColor(unsigned long index) const {
+    return colors_[index];
+}
+
+void BrickBatch::setColor(unsigned long index, const Color& color) {
+    colors_[index] = color;
+    for (unsigned long i = index * 4; i < index * 4 + 4; ++i)
+        vertices_[i].color = color;
+}
+
+unsigned int BrickBatch::getNumArmored() const {
+    return numArmored_;
+}
+
+void BrickBatch::draw(RenderWindow& window) const {
+    if (!vertices_.empty())
+        window.draw(&vertices_[0], vertices_.size(), Quads);
+}
+
+unsigned long BrickBatch::getHeapBytes() const {
+    return hitPoints_.capacity() * sizeof(uint8_t) + types_.capacity() * sizeof(char)
+           + colors_.capacity() * sizeof(Color) + vertices_.capacity() * sizeof(Vertex);
+}
+
+int BrickBatch::getMaxHitPoints(char special) {
+    switch (special) {
+        case 'h': return 2;
+        case 'r': return 3;
+        case 'a': return 0;
+        default:  return 1;
+    }
+}
+
+Color BrickBatch::getHitPointColor(int hitPoints) {
+    const int numColors = int(sizeof(HIT_POINT_BRICK_COLORS) / sizeof(Color));
+    return HIT_POINT_BRICK_COLORS[min(max(hitPoints, 1), numColors) - 1];
+}
@@ -0,0 +1,118 @@
+/**
+ * \file BrickBatch.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the per-brick state the game changes while a level is played, stored by field, and its vertices
+ */
+
+#ifndef BRICKBREAKER_BRICKBATCH_H
+#define BRICKBREAKER_BRICKBATCH_H
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "Brick.h"
+
+/**
+ * \class BrickBatch
+ * \brief Hit points, types and colors of a game's bricks, one array per field, plus one quad per brick
+ *
+ * \details Entries are in the same order as the bricks in the game's list of objects (safety bricks first), and the
+ *      game adds and erases them wherever it adds and erases bricks. Damaging a brick only touches its hit points and,
+ *      if its color changes, the four vertices of its quad, so the whole stage is still drawn with one draw call and
+ *      no shapes are rebuilt.
+ *
+ *      Most bricks are destroyed by a single hit. Hard ('h') and reinforced ('r') bricks take two and three, and get
+ *      lighter with each one. Armored bricks ('a') are never destroyed, and don't have to be cleared to finish a level.
+ */
+class BrickBatch {
+public:
+    BrickBatch();
+
+    /**
+     * \brief Adds a brick to the end, with all its hit points
+     */
+    void add(const Brick& brick);
+
+    /**
+     * \brief Removes every brick flagged, moving the rest down over them in one pass
+     *
+     * \param removed   One flag per brick, true for the ones to remove
+     */
+    void erase(const std::vector<bool>& removed);
+
+    /**
+     * \brief Removes every brick
+     */
+    void clear();
+
+    /**
+     * \brief Takes a hit point from a brick, and fades it if it survives
+     *
+     * \return true if the brick should be destroyed, false if it survived or is armored
+     */
+    bool damage(unsigned long index);
+
+    /**
+     * \brief Returns how many hits a brick has left
+     */
+    int getHitPoints(unsigned long index) const;
+
+    /**
+     * \brief Sets how many hits a brick has left, and its color to match. Used when restoring a snapshot.
+     */
+    void setHitPoints(unsigned long index, int hitPoints);
+
+    /**
+     * \brief Returns a brick's special character (see Brick::special_)
+     */
+    char getType(unsigned long index) const;
+
+    /**
+     * \brief Returns the color a brick is drawn in
+     */
+    const sf::Color& getColor(unsigned long index) const;
+
+    /**
+     * \brief Changes the color a brick is drawn in
+     */
+    void setColor(unsigned long index, const sf::Color& color);
+
+    /**
+     * \brief Returns the number of armored bricks, which count towards the game's bricks but can't be destroyed
+     */
+    unsigned int getNumArmored() const;
+
+    /**
+     * \brief Draws every brick in one draw call
+     */
+    void draw(sf::RenderWindow& window) const;
+
+    /**
+     * \brief Returns the number of bytes the arrays hold on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+    /**
+     * \brief Returns how many hits a type of brick takes to destroy, 0 if it can't be destroyed
+     */
+    static int getMaxHitPoints(char special);
+
+    /**
+     * \brief Returns the color of a hard or reinforced brick with the given hits left
+     */
+    static sf::Color getHitPointColor(int hitPoints);
+
+private:
+    std::vector<uint8_t> hitPoints_;
+    std::vector<char> types_;           ///< Each brick's special character (see Brick::special_)
+    std::vector<sf::Color> colors_;
+    std::vector<sf::Vertex> vertices_;  ///< Four per brick, drawn as quads
+    unsigned int numArmored_;
+};
+
+#endif //BRICKBREAKER_BRICKBATCH_H
@@ -0,0 +1,246 @@
+/**
+ * \file BrickGrid.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a uniform grid over the stage that lists the bricks in each of its cells
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "BrickGrid.h"
+#include "Brick.h"
+
+using namespace sf;
+using namespace std;
+
+BrickGrid::BrickGrid()
+        : first_(0),
+          columns_(0),
+          rows_(0),
+          margin_(0),
+          valid_(false),
+          version_(0)
+{
+}
+
+void BrickGrid::build(const vector<Object*>& objects, long first, long end, const Vector2u& stageSize, float margin) {
+    first_ = first;
+    columns_ = int(ceilf(stageSize.x / BRICK_GRID_CELL_SIZE));
+    rows_ = int(ceilf(stageSize.y / BRICK_GRID_CELL_SIZE));
+    margin_ = margin;
+
+    unsigned long numBricks = (unsigned long)(end - first);
+    left_.resize(numBricks);
+    top_.resize(numBricks);
+    right_.resize(numBricks);
+    bottom_.resize(numBricks);
+    for (unsigned long i = 0; i < numBricks; ++i) {
+        FloatRect bounds = dynamic_cast<Brick*>(objects[first + i])->getBounds();
+        left_[i] = bounds.left;
+        top_[i] = bounds.top;
+        right_[i] = bounds.left + bounds.width;
+        bottom_[i] = bounds.top + bounds.height;
+    }
+
+    // The cells each brick covers, grown by the margin and kept on the grid
+    auto cellRange = [&](unsigned long i, int& column0, int& column1, int& row0, int& row1) {
+        column0 = max(0, int(floorf((left_[i] - margin_) / BRICK_GRID_CELL_SIZE)));
+        column1 = min(columns_ - 1, int(floorf((right_[i] + margin_) / BRICK_GRID_CELL_SIZE)));
+        row0 = max(0, int(floorf((top_[i] - margin_) / BRICK_GRID_CELL_SIZE)));
+        row1 = min(rows_ - 1, int(floorf((bottom_[i] + margin_) / BRICK_GRID_CELL_SIZE)));
+    };
+
+    // Count the entries in each cell, then turn the counts into where each cell starts
+    unsigned long numCells = (unsigned long)(columns_ * rows_);
+    cellStart_.assign(numCells + 1, 0);
+    for (unsigned long i = 0; i < numBricks; ++i) {
+        int column0, column1, row0, row1;
+        cellRange(i, column0, column1, row0, row1);
+        for (int row = row0; row <= row1; ++row) {
+            for (int column = column0; column <= column1; ++column)
+                ++cellStart_[row * columns_ + column + 1];
+        }
+    }
+    for (unsigned long cell = 0; cell < numCells; ++cell)
+        cellStart_[cell + 1] += cellStart_[cell];
+
+    // Then fill them in
+    entries_.resize(cellStart_[numCells]);
+    cursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+    for (unsigned long i = 0; i < numBricks; ++i) {
+        int column0, column1, row0, row1;
+        cellRange(i, column0, column1, row0, row1);
+        for (int row = row0; row <= row1; ++row) {
+            for (int column = column0; column <= column1; ++column)
+                entries_[cursor_[row * columns_ + column]++] = uint32_t(i);
+        }
+    }
+
+    valid_ = true;
+    ++version_;
+}
+
+void BrickGrid::invalidate() {
+    valid_ = false;
+}
+
+bool BrickGrid::isValid() const {
+    return valid_;
+}
+
+unsigned long BrickGrid::getVersion() const {
+    return version_;
+}
+
+bool BrickGrid::rayCast(const Vector2f& origin, const Vector2f& direction, float maxDistance, float radius,
+                        Hit& hit) const {
+    hit.index = -1;
+    hit.distance = maxDistance;
+    if (columns_ == 0 || rows_ == 0)
+        return false;
+
+    // Start in the cell holding the origin
+    int column = min(max(int(floorf(origin.x / BRICK_GRID_CELL_SIZE)), 0), columns_ - 1);
+    int row = min(max(int(floorf(origin.y / BRICK_GRID_CELL_SIZE)), 0), rows_ - 1);
+    int columnStep = direction.x > 0 ? 1 : -1;
+    int rowStep = direction.y > 0 ? 1 : -1;
+
+    // How far along the line the next column and row start, and how far apart columns and rows are along it
+    const float infinity = numeric_limits<float>::infinity();
+    float nextColumn = infinity, columnDistance = infinity;
+    if (direction.x != 0) {
+        nextColumn = ((column + (direction.x > 0)) * BRICK_GRID_CELL_SIZE - origin.x) / direction.x;
+        columnDistance = BRICK_GRID_CELL_SIZE / fabsf(direction.x);
+    }
+    float nextRow = infinity, rowDistance = infinity;
+    if (direction.y != 0) {
+        nextRow = ((row + (direction.y > 0)) * BRICK_GRID_CELL_SIZE - origin.y) / direction.y;
+        rowDistance = BRICK_GRID_CELL_SIZE / fabsf(direction.y);
+    }
+
+    // A circle bigger than the margin can touch bricks listed only in the cells around the line's, as far out as the
+    // difference
+    int reach = radius > margin_ ? int(ceilf((radius - margin_) / BRICK_GRID_CELL_SIZE)) : 0;
+
+    while (true) {
+        for (int r = max(row - reach, 0); r <= min(row + reach, rows_ - 1); ++r) {
+            for (int c = max(column - reach, 0); c <= min(column + reach, columns_ - 1); ++c) {
+                unsigned long cell = (unsigned long)(r * columns_ + c);
+                for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i)
+                    testBrick(entries_[i], origin, direction, radius, hit);
+            }
+        }
+
+        // A brick hit before the line leaves the cell can't be beaten by one in a later cell
+        float exit = min(nextColumn, nextRow);
+        if (hit.index >= 0 && hit.distance <= exit)
+            return true;
+        if (exit >= maxDistance)
+            break;
+
+        // Step into whichever cell the line enters next
+        if (nextColumn < nextRow) {
+            column += columnStep;
+            if (column < 0 || column >= columns_)
+                break;
+            nextColumn += columnDistance;
+        }
+        else {
+            row += rowStep;
+            if (row < 0 || row >= rows_)
+                break;
+            nextRow += rowDistance;
+        }
+    }
+
+    return hit.index >= 0;
+}
+
+void BrickGrid::testBrick(uint32_t brick, const Vector2f& origin, const Vector2f& direction, float radius,
+                          Hit& hit) const {
+    // Where the line enters and leaves the brick's grown bounds on each axis. The later entry is where it enters the
+    // brick, through the side facing that axis.
+    float enter = -numeric_limits<float>::infinity();
+    float leave = hit.distance;
+    Vector2f normal;
+
+    if (direction.x != 0) {
+        float in = (left_[brick] - radius - origin.x) / direction.x;
+        float out = (right_[brick] + radius - origin.x) / direction.x;
+        float side = -1;
+        if (in > out) {
+            swap(in, out);
+            side = 1;
+        }
+        if (in > enter) {
+            enter = in;
+            normal = Vector2f(side, 0);
+        }
+        leave = min(leave, out);
+    }
+    else if (origin.x <= left_[brick] - radius || origin.x >= right_[brick] + radius) {
+        return;
+    }
+
+    if (direction.y != 0) {
+        float in = (top_[brick] - radius - origin.y) / direction.y;
+        float out = (bottom_[brick] + radius - origin.y) / direction.y;
+        float side = -1;
+        if (in > out) {
+            swap(in, out);
+            side = 1;
+        }
+        if (in > enter) {
+            enter = in;
+            normal = Vector2f(0, side);
+        }
+        leave = min(leave, out);
+    }
+    else if (origin.y <= top_[brick] - radius || origin.y >= bottom_[brick] + radius) {
+        return;
+    }
+
+    // Only count bricks entered ahead of the origin, nearer than any found so far
+    if (enter >= 0 && enter < leave && enter < hit.distance) {
+        hit.index = first_ + long(brick);
+        hit.distance = enter;
+        hit.normal = normal;
+    }
+}
+
+const vector<long>& BrickGrid::query(const Circle& circle) const {
+    found_.clear();
+    if (columns_ == 0 || rows_ == 0)
+        return found_;
+
+    // The cells within how much further than the margin the circle reaches of its center
+    float extra = max(circle.radius - margin_, 0.f);
+    int column0 = max(0, int(floorf((circle.center.x - extra) / BRICK_GRID_CELL_SIZE)));
+    int column1 = min(columns_ - 1, int(floorf((circle.center.x + extra) / BRICK_GRID_CELL_SIZE)));
+    int row0 = max(0, int(floorf((circle.center.y - extra) / BRICK_GRID_CELL_SIZE)));
+    int row1 = min(rows_ - 1, int(floorf((circle.center.y + extra) / BRICK_GRID_CELL_SIZE)));
+
+    for (int row = row0; row <= row1; ++row) {
+        for (int column = column0; column <= column1; ++column) {
+            unsigned long cell = (unsigned long)(row * columns_ + column);
+            for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i)
+                found_.push_back(first_ + entries_[i]);
+        }
+    }
+
+    // Each cell's entries are already in order, so only a search of more than one needs sorting and deduplicating
+    if (column0 != column1 || row0 != row1) {
+        sort(found_.begin(), found_.end());
+        found_.erase(unique(found_.begin(), found_.end()), found_.end());
+    }
+    return found_;
+}
+
+unsigned long BrickGrid::getHeapBytes() const {
+    return (left_.capacity() + top_.capacity() + right_.capacity() + bottom_.capacity()) * sizeof(float)
+           + (cellStart_.capacity() + entries_.capacity() + cursor_.capacity()) * sizeof(uint32_t)
+           + found_.capacity() * sizeof(long);
+}
@@ -0,0 +1,171 @@
+/**
+ * \file BrickGrid.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a uniform grid over the stage that lists the bricks in each of its cells
+ */
+
+#ifndef BRICKBREAKER_BRICKGRID_H
+#define BRICKBREAKER_BRICKGRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Collision.h"
+#include "Object.h"
+
+/**
+ * \class BrickGrid
+ * \brief Finds the bricks along a line or around a ball without testing every brick on the stage
+ *
+ * \details The stage is split into square cells, and each brick is listed in every cell it overlaps once grown by a
+ *      margin on all sides. Cells are stored as two flat arrays, the index of each cell's first entry and the entries
+ *      of every cell one after another, along with each brick's bounds, so building the grid only allocates when the
+ *      stage has more bricks than it ever has.
+ *
+ *      The grid doesn't follow the bricks itself. The game invalidates it whenever bricks are added or removed, and
+ *      it is rebuilt the next time it is needed. Each build gets a new version, so anything worked out from the grid
+ *      can tell whether the bricks have changed since.
+ */
+class BrickGrid {
+public:
+    /**
+     * \struct Hit
+     * \brief The first brick found along a line
+     */
+    struct Hit {
+        long index;             ///< The brick's index in the game's list of objects
+        float distance;         ///< How far along the line it was hit
+        sf::Vector2f normal;    ///< The side hit, pointing out of the brick
+    };
+
+    BrickGrid();
+
+    /**
+     * \brief Lists every brick in its cells
+     *
+     * \param objects   The game's objects
+     *        first     Index of the first brick in objects
+     *        end       Index one past the last brick in objects
+     *        stageSize The size of the area the stage is laid out in
+     *        margin    How far around each brick it is listed. Circles up to this radius only need the cell their
+     *                  center is in, larger ones look in the cells around it as well.
+     */
+    void build(const std::vector<Object*>& objects, long first, long end, const sf::Vector2u& stageSize, float margin);
+
+    /**
+     * \brief Marks the grid as out of date, so it is rebuilt before it is next used
+     */
+    void invalidate();
+
+    /**
+     * \brief Returns false if bricks have been added or removed since the grid was built
+     */
+    bool isValid() const;
+
+    /**
+     * \brief Returns a number that changes every time the grid is built
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * \brief Finds the first brick a circle hits when moved along a line
+     *
+     * \details Walks the cells the line passes through in order, and tests the bricks in each against the line as
+     *      boxes grown by the circle's radius. Stops at the first cell a hit is found in, so the cost grows with the
+     *      length of the line rather than the number of bricks. Bricks the circle already overlaps are passed through.
+     *
+     * \param origin        Where the circle's center starts
+     *        direction     Which way it moves, of length 1
+     *        maxDistance   How far it moves
+     *        radius        The circle's radius. 0 for a plain ray.
+     *        hit           Set to the brick hit, if there is one
+     *
+     * \return true if a brick was hit
+     */
+    bool rayCast(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance, float radius,
+                 Hit& hit) const;
+
+    /**
+     * \brief Lists every brick that might touch a circle
+     *
+     * \details A circle no bigger than the margin only needs the cell its center is in. A bigger one needs every cell
+     *      within the difference of its center, so the bricks listed in more than one of them are only returned once.
+     *
+     * \return The bricks' indices in the game's list of objects, in increasing order. Only valid until the next call.
+     */
+    const std::vector<long>& query(const Circle& circle) const;
+
+    /**
+     * \brief Calls visit with every brick a circle touches, by its position after the first brick
+     *
+     * \details Unlike query() nothing is sorted or deduplicated, so a brick listed in more than one of the cells the
+     *      circle reaches is visited once for each. Meant for callers that keep their own set of bricks, which adding
+     *      a brick to twice doesn't change.
+     */
+    template <typename Visit>
+    void forEachTouching(const Circle& circle, Visit visit) const;
+
+    /**
+     * \brief Returns the number of bytes the arrays hold on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+private:
+    /**
+     * \brief Tests the line against one brick's bounds grown by the radius, and replaces hit if it is nearer
+     */
+    void testBrick(uint32_t brick, const sf::Vector2f& origin, const sf::Vector2f& direction, float radius,
+                   Hit& hit) const;
+
+    // Each brick's bounds, by its position after the first brick
+    std::vector<float> left_, top_, right_, bottom_;
+
+    std::vector<uint32_t> cellStart_;   ///< Index in entries_ of each cell's first entry, plus one past the last
+    std::vector<uint32_t> entries_;     ///< The bricks in each cell, by their position after the first brick
+    std::vector<uint32_t> cursor_;      ///< Where each cell's next entry goes while building
+    mutable std::vector<long> found_;   ///< The bricks found by the last query()
+
+    long first_;                        ///< Index in the game's objects of the first brick
+    int columns_, rows_;
+    float margin_;
+    bool valid_;
+    unsigned long version_;
+};
+
+const float BRICK_GRID_CELL_SIZE = 40;  ///< Width and height of each of the grid's cells
+
+template <typename Visit>
+void BrickGrid::forEachTouching(const Circle& circle, Visit visit) const {
+    if (columns_ == 0 || rows_ == 0)
+        return;
+
+    // The same cells query() looks in
+    float extra = std::max(circle.radius - margin_, 0.f);
+    int column0 = std::max(0, int(floorf((circle.center.x - extra) / BRICK_GRID_CELL_SIZE)));
+    int column1 = std::min(columns_ - 1, int(floorf((circle.center.x + extra) / BRICK_GRID_CELL_SIZE)));
+    int row0 = std::max(0, int(floorf((circle.center.y - extra) / BRICK_GRID_CELL_SIZE)));
+    int row1 = std::min(rows_ - 1, int(floorf((circle.center.y + extra) / BRICK_GRID_CELL_SIZE)));
+
+    for (int row = row0; row <= row1; ++row) {
+        for (int column = column0; column <= column1; ++column) {
+            unsigned long cell = (unsigned long)(row * columns_ + column);
+            for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+                // The nearest point of the brick to the circle's center
+                uint32_t brick = entries_[i];
+                float x = std::min(std::max(circle.center.x, left_[brick]), right_[brick]) - circle.center.x;
+                float y = std::min(std::max(circle.center.y, top_[brick]), bottom_[brick]) - circle.center.y;
+                if (x * x + y * y <= circle.radius * circle.radius)
+                    visit(brick);
+            }
+        }
+    }
+}
+
+#endif //BRICKBREAKER_BRICKGRID_H
@@ -0,0 +1,337 @@
+/**
+ * \file BrickScript.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the compiler and interpreter for scripted bricks
+ */
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include "BrickScript.h"
+
+using namespace std;
+
+namespace {
+    /**
+     * \brief An instruction's name, how many arguments it takes, and how many values it pops and pushes
+     */
+    struct OpInfo {
+        const char* name;
+        int numArgs;
+        int pops;
+        int pushes;
+    };
+
+    // In the same order as BrickScript::Op
+    const OpInfo OPS[] = {
+        {"push", 1, 0, 1}, {"pop", 0, 1, 0}, {"dup", 0, 1, 2}, {"add", 0, 2, 1}, {"sub", 0, 2, 1},
+        {"mul", 0, 2, 1}, {"mod", 0, 2, 1}, {"lt", 0, 2, 1}, {"eq", 0, 2, 1}, {"not", 0, 1, 1},
+        {"load", 1, 0, 1}, {"store", 1, 1, 0}, {"hits", 0, 0, 1}, {"signaled", 0, 0, 1}, {"jump", 1, 0, 0},
+        {"jumpif", 1, 1, 0}, {"destroy", 0, 0, 0}, {"spawnball", 0, 0, 0}, {"longpaddle", 0, 0, 0},
+        {"color", 0, 1, 0}, {"signal", 2, 0, 0}, {"end", 0, 0, 0}
+    };
+
+    /**
+     * \brief Reads a whole number in the given range from a token
+     */
+    bool parseNumber(const string& token, int low, int high, int& value) {
+        istringstream in(token);
+        long number;
+        if (!(in >> number) || !in.eof() || number < low || number > high)
+            return false;
+        value = int(number);
+        return true;
+    }
+}
+
+BrickScript::BrickScript() {
+    fill(entries_, entries_ + BRICK_SCRIPT_COUNT, -1);
+}
+
+bool BrickScript::compile(istream& source, string& error) {
+    // Nothing is kept if anything fails to compile
+    auto reset = [this]() {
+        code_.clear();
+        fill(entries_, entries_ + BRICK_SCRIPT_COUNT, -1);
+        return false;
+    };
+    reset();
+
+    vector<int> lines;                  // Source line of each instruction
+    map<string, int> labels;            // Labels of the script being compiled and the instructions they point at
+    vector<pair<unsigned int, string>> jumps;   // Jumps in the script being compiled, resolved once it ends
+    int script = -1;
+    int lineNumber = 0;
+    string line;
+
+    // Resolves the jumps of the script being compiled, ends it and checks its stack. Run at each "script" line and at
+    // the end of the source.
+    auto finishScript = [&]() {
+        if (script < 0)
+            return true;
+
+        for (const pair<unsigned int, string>& jump : jumps) {
+            auto label = labels.find(jump.second);
+            if (label == labels.end()) {
+                error = "line " + to_string(lines[jump.first]) + ": unknown label \"" + jump.second + "\"";
+                return false;
+            }
+            code_[jump.first].arg = int16_t(label->second);
+        }
+
+        code_.push_back({OP_END, 0, 0});
+        lines.push_back(lineNumber);
+        return verify((unsigned int)entries_[script], (unsigned int)code_.size(), lines, error);
+    };
+
+    while (getline(source, line)) {
+        ++lineNumber;
+
+        // Everything after a # is a comment
+        line = line.substr(0, line.find('#'));
+
+        istringstream tokens(line);
+        vector<string> words;
+        string word;
+        while (tokens >> word)
+            words.push_back(word);
+
+        // A label can be on its own line or in front of an instruction
+        if (!words.empty() && words[0].size() > 1 && words[0].back() == ':') {
+            string name = words[0].substr(0, words[0].size() - 1);
+            if (script < 0 || labels.count(name)) {
+                error = "line " + to_string(lineNumber) + ": " + (script < 0 ? "label outside a script"
+                                                                             : "label \"" + name + "\" used twice");
+                return reset();
+            }
+            labels[name] = int(code_.size());
+            words.erase(words.begin());
+        }
+
+        if (words.empty())
+            continue;
+
+        // Start of a new script
+        if (words[0] == "script") {
+            int number;
+            if (!finishScript()) {
+                return reset();
+            }
+            if (words.size() != 2 || !parseNumber(words[1], 0, BRICK_SCRIPT_COUNT - 1, number)
+                || entries_[number] >= 0) {
+                error = "line " + to_string(lineNumber) + ": expected \"script <0-9>\" with a number not used yet";
+                return reset();
+            }
+            script = number;
+            entries_[script] = int(code_.size());
+            labels.clear();
+            jumps.clear();
+            continue;
+        }
+
+        // Otherwise it's an instruction
+        int op = 0;
+        while (op < NUM_OPS && words[0] != OPS[op].name)
+            ++op;
+
+        if (script < 0 || op == NUM_OPS || int(words.size()) != 1 + OPS[op].numArgs) {
+            error = "line " + to_string(lineNumber) + ": " + (script < 0 ? "instruction outside a script"
+                                                          : op == NUM_OPS ? "unknown instruction \"" + words[0] + "\""
+                                                          : "wrong number of arguments to " + words[0]);
+            return reset();
+        }
+
+        Instruction instruction = {Op(op), 0, 0};
+        int arg = 0;
+        int arg2 = 0;
+        bool valid = true;
+        switch (op) {
+            case OP_PUSH:
+                valid = parseNumber(words[1], INT16_MIN, INT16_MAX, arg);
+                break;
+            case OP_LOAD:
+            case OP_STORE:
+                valid = parseNumber(words[1], 0, BRICK_SCRIPT_REGISTERS - 1, arg);
+                break;
+            case OP_JUMP:
+            case OP_JUMPIF:
+                jumps.push_back(make_pair((unsigned int)code_.size(), words[1]));
+                break;
+            case OP_SIGNAL:
+                valid = parseNumber(words[1], INT8_MIN, INT8_MAX, arg)
+                        && parseNumber(words[2], INT8_MIN, INT8_MAX, arg2);
+                break;
+            default: break;
+        }
+        if (!valid) {
+            error = "line " + to_string(lineNumber) + ": argument out of range for " + words[0];
+            return reset();
+        }
+
+        instruction.arg = int16_t(arg);
+        instruction.arg2 = int8_t(arg2);
+        code_.push_back(instruction);
+        lines.push_back(lineNumber);
+
+        // Jump targets are 16 bit
+        if (code_.size() > INT16_MAX) {
+            error = "line " + to_string(lineNumber) + ": too many instructions";
+            return reset();
+        }
+    }
+
+    return finishScript() || reset();
+}
+
+bool BrickScript::verify(unsigned int start, unsigned int end, const vector<int>& lines, string& error) const {
+    // The stack depth on reaching each instruction, -1 until it is reached. Every path to an instruction has to reach
+    // it with the same depth, so one pass over the paths finds the deepest the stack can get.
+    vector<int> depths(end - start, -1);
+    vector<unsigned int> pending(1, start);
+    depths[0] = 0;
+
+    while (!pending.empty()) {
+        unsigned int i = pending.back();
+        pending.pop_back();
+
+        const Instruction& instruction = code_[i];
+        const OpInfo& info = OPS[instruction.op];
+        int depth = depths[i - start];
+
+        if (depth < info.pops) {
+            error = "line " + to_string(lines[i]) + ": " + info.name + " needs more values than are on the stack";
+            return false;
+        }
+        depth += info.pushes - info.pops;
+        if (depth > int(BRICK_SCRIPT_STACK)) {
+            error = "line " + to_string(lines[i]) + ": stack deeper than " + to_string(BRICK_SCRIPT_STACK);
+            return false;
+        }
+
+        // Where this instruction can go next. The last instruction is always an end, so nothing falls off the end.
+        unsigned int next[2];
+        int numNext = 0;
+        if (instruction.op == OP_JUMP || instruction.op == OP_JUMPIF)
+            next[numNext++] = (unsigned int)instruction.arg;
+        if (instruction.op != OP_JUMP && instruction.op != OP_END)
+            next[numNext++] = i + 1;
+
+        for (int k = 0; k < numNext; ++k) {
+            int& known = depths[next[k] - start];
+            if (known < 0) {
+                known = depth;
+                pending.push_back(next[k]);
+            }
+            else if (known != depth) {
+                error = "line " + to_string(lines[next[k]]) + ": reached with different stack depths";
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool BrickScript::hasScript(int script) const {
+    return script >= 0 && script < int(BRICK_SCRIPT_COUNT) && entries_[script] >= 0;
+}
+
+unsigned int BrickScript::run(int script, BrickScriptRun& context, unsigned int& budget) const {
+    context.destroy = false;
+    context.shade = -1;
+    context.longPaddle = false;
+    context.numBalls = 0;
+    context.numSignals = 0;
+
+    // The compiler made sure the stack can't overflow or underflow, so nothing here checks it
+    int32_t stack[BRICK_SCRIPT_STACK];
+    int32_t* top = stack;
+    const Instruction* ip = &code_[entries_[script]];
+    unsigned int limit = min(budget, BRICK_SCRIPT_STEPS_PER_RUN);
+    unsigned int steps = 0;
+
+    // Each instruction jumps straight to the next one's handler, rather than back to a shared switch, where the
+    // compiler supports taking the address of a label. Either way every dispatch counts a step against the limit.
+#ifdef __GNUC__
+    static const void* const handlers[NUM_OPS] = {
+        &&do_OP_PUSH, &&do_OP_POP, &&do_OP_DUP, &&do_OP_ADD, &&do_OP_SUB, &&do_OP_MUL, &&do_OP_MOD, &&do_OP_LT,
+        &&do_OP_EQ, &&do_OP_NOT, &&do_OP_LOAD, &&do_OP_STORE, &&do_OP_HITS, &&do_OP_SIGNALED, &&do_OP_JUMP,
+        &&do_OP_JUMPIF, &&do_OP_DESTROY, &&do_OP_SPAWNBALL, &&do_OP_LONGPADDLE, &&do_OP_COLOR, &&do_OP_SIGNAL,
+        &&do_OP_END
+    };
+    #define DISPATCH() do { if (steps == limit) goto done; ++steps; goto *handlers[ip->op]; } while (false)
+    #define OP(name) do_##name:
+#else
+    #define DISPATCH() goto dispatch
+    #define OP(name) case name:
+#endif
+    #define NEXT() do { ++ip; DISPATCH(); } while (false)
+
+    DISPATCH();
+
+#ifndef __GNUC__
+dispatch:
+    if (steps == limit)
+        goto done;
+    ++steps;
+    switch (ip->op) {
+#endif
+
+    OP(OP_PUSH)     *top++ = ip->arg; NEXT();
+    OP(OP_POP)      --top; NEXT();
+    OP(OP_DUP)      *top = top[-1]; ++top; NEXT();
+
+    // Arithmetic wraps around rather than overflowing
+    OP(OP_ADD)      --top; top[-1] = int32_t(uint32_t(top[-1]) + uint32_t(*top)); NEXT();
+    OP(OP_SUB)      --top; top[-1] = int32_t(uint32_t(top[-1]) - uint32_t(*top)); NEXT();
+    OP(OP_MUL)      --top; top[-1] = int32_t(uint32_t(top[-1]) * uint32_t(*top)); NEXT();
+    OP(OP_MOD)      --top; top[-1] = (*top == 0 || *top == -1) ? 0 : top[-1] % *top; NEXT();
+    OP(OP_LT)       --top; top[-1] = top[-1] < *top; NEXT();
+    OP(OP_EQ)       --top; top[-1] = top[-1] == *top; NEXT();
+    OP(OP_NOT)      top[-1] = !top[-1]; NEXT();
+
+    OP(OP_LOAD)     *top++ = context.registers[ip->arg]; NEXT();
+    OP(OP_STORE)    context.registers[ip->arg] = int16_t(*--top); NEXT();
+    OP(OP_HITS)     *top++ = context.hits; NEXT();
+    OP(OP_SIGNALED) *top++ = context.signaled; NEXT();
+
+    OP(OP_JUMP)     ip = &code_[ip->arg]; DISPATCH();
+    OP(OP_JUMPIF)
+        if (*--top != 0) {
+            ip = &code_[ip->arg];
+            DISPATCH();
+        }
+        NEXT();
+
+    OP(OP_DESTROY)  context.destroy = true; NEXT();
+    OP(OP_SPAWNBALL)
+        if (context.numBalls < BRICK_SCRIPT_MAX_BALLS)
+            ++context.numBalls;
+        NEXT();
+    OP(OP_LONGPADDLE) context.longPaddle = true; NEXT();
+    OP(OP_COLOR)    context.shade = max(0, int(*--top)); NEXT();
+    OP(OP_SIGNAL)
+        if (context.numSignals < BRICK_SCRIPT_MAX_SIGNALS) {
+            context.signals[context.numSignals][0] = int8_t(ip->arg);
+            context.signals[context.numSignals][1] = ip->arg2;
+            ++context.numSignals;
+        }
+        NEXT();
+    OP(OP_END)      goto done;
+
+#ifndef __GNUC__
+        default: goto done;
+    }
+#endif
+
+    #undef DISPATCH
+    #undef OP
+    #undef NEXT
+
+done:
+    budget -= steps;
+    return steps;
+}
@@ -0,0 +1,150 @@
+/**
+ * \file BrickScript.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the compiler and interpreter for scripted bricks
+ */
+
+#ifndef BRICKBREAKER_BRICKSCRIPT_H
+#define BRICKBREAKER_BRICKSCRIPT_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+const unsigned int BRICK_SCRIPT_COUNT = 10;         ///< Scripts are numbered 0 to 9, the digits used in level files
+
+const unsigned int BRICK_SCRIPT_REGISTERS = 4;      ///< Values each scripted brick keeps between runs
+
+const unsigned int BRICK_SCRIPT_STACK = 8;          ///< Deepest the stack may get, checked when compiling
+
+const unsigned int BRICK_SCRIPT_MAX_SIGNALS = 4;    ///< Signals one run can send, any more are ignored
+
+const unsigned int BRICK_SCRIPT_MAX_BALLS = 2;      ///< Balls one run can spawn, any more are ignored
+
+const unsigned int BRICK_SCRIPT_STEPS_PER_RUN = 256;    ///< A run that takes longer than this is cut off
+
+const unsigned int BRICK_SCRIPT_STEPS_PER_TICK = 4096;  ///< All the runs in one tick together, see GraphicsRunner
+
+const unsigned int BRICK_SCRIPT_MAX_EVENTS = 64;    ///< Hits and signals queued in one tick, any more are dropped
+
+/**
+ * \struct BrickScriptRun
+ * \brief Everything a script can see and do. Filled in by the game before a run and acted on by it afterwards.
+ *
+ * \details Scripts never touch the game directly, so a script can't do anything the game doesn't apply itself
+ */
+struct BrickScriptRun {
+    // In
+    int hits;               ///< How many times the brick has been hit, including this one
+    bool signaled;          ///< True if a neighbor's signal caused the run rather than a ball
+    int16_t* registers;     ///< The brick's BRICK_SCRIPT_REGISTERS registers, read and written by the script
+
+    // Out, cleared before each run
+    bool destroy;           ///< The brick should be destroyed
+    int shade;              ///< The shade the brick should be drawn in, or -1 to leave it
+    bool longPaddle;        ///< The paddle should be lengthened
+    unsigned int numBalls;  ///< Balls to attach to the paddle
+    unsigned int numSignals;
+    int8_t signals[BRICK_SCRIPT_MAX_SIGNALS][2];    ///< Column and row offsets of the bricks to signal
+};
+
+/**
+ * \class BrickScript
+ * \brief A level pack's brick scripts, compiled to bytecode
+ *
+ * \details Scripts are written in a small stack language, one instruction per line, and compiled when their level
+ *      file is first read. A scripted brick (a digit in the level file) runs its script every time a ball hits it and
+ *      every time a neighbor signals it. Unlike other bricks it is only destroyed if its script says so.
+ *
+ *      Instructions:
+ *          push n          Pushes the number n
+ *          pop, dup        Drops or duplicates the top of the stack
+ *          add, sub, mul, mod, lt, eq
+ *                          Pops b then a and pushes a + b, a - b, a * b, a mod b (0 if b is 0), a < b, a == b
+ *          not             Pushes 1 if the popped value is 0, otherwise 0
+ *          load r, store r Pushes register r, or pops into it (0 to BRICK_SCRIPT_REGISTERS - 1)
+ *          hits            Pushes how many times the brick has been hit
+ *          signaled        Pushes 1 if a signal started the run, 0 if a ball did
+ *          jump label, jumpif label
+ *                          Jumps to a label (a line "name:"), always or only if the popped value isn't 0
+ *          destroy         Destroys the brick once the run is over
+ *          spawnball       Attaches a new ball to the paddle, like an extra ball brick
+ *          longpaddle      Lengthens the paddle, like a long paddle brick
+ *          color           Pops the shade to draw the brick in (see SCRIPTED_BRICK_COLORS)
+ *          signal dx dy    Runs the script of the brick dx columns and dy rows away, or destroys it if it isn't
+ *                          scripted
+ *          end             Ends the run (also implied after the last instruction)
+ *
+ *      "script n" starts script n and "#" starts a comment. Labels only need to be unique within a script.
+ *
+ *      Scripts are sandboxed. The compiler rejects any script whose stack could overflow or underflow on some path,
+ *      so the interpreter doesn't check, and every run is cut off after BRICK_SCRIPT_STEPS_PER_RUN instructions. The
+ *      interpreter dispatches with computed gotos where the compiler supports them.
+ */
+class BrickScript {
+public:
+    BrickScript();
+
+    /**
+     * \brief Compiles a level pack's scripts, replacing any already compiled
+     *
+     * \param source    The scripts' source text
+     *        error     Set to a message with the line number if compiling fails
+     *
+     * \return true if every script compiled, false otherwise (and no scripts are kept)
+     */
+    bool compile(std::istream& source, std::string& error);
+
+    /**
+     * \brief Returns true if script n was defined
+     */
+    bool hasScript(int script) const;
+
+    /**
+     * \brief Runs a script
+     *
+     * \param script    Which script to run, must have been defined
+     *        context   What the script sees, and where its actions are written
+     *        budget    Instructions left for this tick. Decreased by the number run, and the run is cut off (with
+     *                  whatever actions it took so far) if it runs out.
+     *
+     * \return The number of instructions run
+     */
+    unsigned int run(int script, BrickScriptRun& context, unsigned int& budget) const;
+
+private:
+    enum Op : uint8_t {
+        OP_PUSH, OP_POP, OP_DUP, OP_ADD, OP_SUB, OP_MUL, OP_MOD, OP_LT, OP_EQ, OP_NOT, OP_LOAD, OP_STORE, OP_HITS,
+        OP_SIGNALED, OP_JUMP, OP_JUMPIF, OP_DESTROY, OP_SPAWNBALL, OP_LONGPADDLE, OP_COLOR, OP_SIGNAL, OP_END,
+        NUM_OPS
+    };
+
+    /**
+     * \struct Instruction
+     * \brief One instruction. For jumps arg is the target's index, for signal arg and arg2 are the offsets.
+     */
+    struct Instruction {
+        Op op;
+        int8_t arg2;
+        int16_t arg;
+    };
+
+    /**
+     * \brief Checks that a script's stack stays within 0 and BRICK_SCRIPT_STACK on every path through it
+     *
+     * \param start     Index of the script's first instruction
+     *        end       Index after its last instruction, which is always an end
+     *        lines     The source line of each instruction, for error messages
+     */
+    bool verify(unsigned int start, unsigned int end, const std::vector<int>& lines, std::string& error) const;
+
+    std::vector<Instruction> code_;         ///< Every script's instructions, one after the other
+    int entries_[BRICK_SCRIPT_COUNT];       ///< Index in code_ of each script's first instruction, -1 if undefined
+};
+
+#endif //BRICKBREAKER_BRICKSCRIPT_H
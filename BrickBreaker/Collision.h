@@ -0,0 +1,261 @@
+/**
+ * \file Collision.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Defines the shapes objects collide as, the contact found between two of them, and the tests that find it
+ */
+
+#ifndef BRICKBREAKER_COLLISION_H
+#define BRICKBREAKER_COLLISION_H
+
+#include <math.h>
+#include <SFML/System/Vector2.hpp>
+
+/**
+ * \struct Circle
+ * \brief A ball as it collides
+ */
+struct Circle {
+    sf::Vector2f center;
+    float radius;
+    sf::Vector2f vel;
+};
+
+/**
+ * \struct Box
+ * \brief A rectangle that lines up with the axes, such as a brick or a wall of the barrier
+ */
+struct Box {
+    float left, top, right, bottom;
+};
+
+/**
+ * \struct Capsule
+ * \brief Every point within a radius of a segment, which is the shape of the paddle
+ */
+struct Capsule {
+    sf::Vector2f start;
+    sf::Vector2f end;
+    float radius;
+    sf::Vector2f normal;        ///< Out of one of the flat sides, of length 1 (see PaddleOrientation)
+    sf::Vector2f vel;
+};
+
+/**
+ * \struct Contact
+ * \brief Where and how two shapes are touching, as seen from the first
+ */
+struct Contact {
+    sf::Vector2f normal;        ///< Out of the second shape towards the first, of length 1
+    sf::Vector2f point;         ///< Where they touch, on the second shape's surface
+    float depth;                ///< How far the shapes overlap along the normal
+    sf::Vector2f otherVel;      ///< The second shape's velocity
+};
+
+/**
+ * \struct Collider
+ * \brief Tests one type of shape against another
+ *
+ * \details Only the pairs the game needs are specialized, each with a static test() that returns true and fills in
+ *      the contact if the shapes are touching. Which test runs is decided at compile time by the shapes' types, so
+ *      testing needs no virtual calls and leaves the shapes untouched. Pairs that aren't specialized don't compile.
+ */
+template <typename First, typename Second>
+struct Collider;
+
+/**
+ * \brief Tests a circle against a box
+ *
+ * \details The circle hit the box's top or bottom if the box holds the circle's highest or lowest point, and its left
+ *      or right side if it holds the circle's leftmost or rightmost point. A circle level with a box too thin to hold
+ *      either point hit the side facing its center, and one whose center is inside the box hit the side it is least
+ *      far past. Otherwise it only hit the box if it is over one of the box's corners.
+ */
+template <>
+struct Collider<Circle, Box> {
+    static bool test(const Circle& circle, const Box& box, Contact& contact) {
+        const sf::Vector2f& center = circle.center;
+        float radius = circle.radius;
+
+        // Nothing more to check unless the square around the circle overlaps the box
+        if (center.x + radius <= box.left || center.x - radius >= box.right
+            || center.y + radius <= box.top || center.y - radius >= box.bottom) {
+            return false;
+        }
+        contact.otherVel = sf::Vector2f(0, 0);
+
+        // How far the circle reaches past each side, which is how far it would have to move to leave the box that way
+        float intoTop = center.y + radius - box.top;
+        float intoBottom = box.bottom - (center.y - radius);
+        float intoLeft = center.x + radius - box.left;
+        float intoRight = box.right - (center.x - radius);
+
+        // The top or bottom of the box if it holds the circle's highest or lowest point, and its left or right side if
+        // it holds the leftmost or rightmost point. A box thinner than the circle can hold none of them while the circle
+        // crosses it, in which case the circle hit whichever side faces its center. If the center is inside the box
+        // the circle has gone deep into it, and hit whichever side it is least far past.
+        bool inColumn = center.x >= box.left && center.x < box.right;
+        bool inRow = center.y >= box.top && center.y < box.bottom;
+        bool vertical, horizontal;
+        if (inColumn && inRow) {
+            vertical = fminf(intoTop, intoBottom) < fminf(intoLeft, intoRight);
+            horizontal = !vertical;
+        }
+        else {
+            vertical = inColumn && ((center.y - radius >= box.top && center.y - radius < box.bottom)
+                                    || (center.y + radius >= box.top && center.y + radius < box.bottom));
+            horizontal = !vertical && inRow && ((center.x - radius >= box.left && center.x - radius < box.right)
+                                                || (center.x + radius >= box.left && center.x + radius < box.right));
+            if (!vertical && !horizontal) {
+                horizontal = inRow;
+                vertical = inColumn;
+            }
+        }
+
+        if (vertical) {
+            contact.normal = sf::Vector2f(0, intoBottom < intoTop ? 1.f : -1.f);
+            contact.point = sf::Vector2f(center.x, intoBottom < intoTop ? box.bottom : box.top);
+            contact.depth = fminf(intoTop, intoBottom);
+            return true;
+        }
+
+        if (horizontal) {
+            contact.normal = sf::Vector2f(intoRight < intoLeft ? 1.f : -1.f, 0);
+            contact.point = sf::Vector2f(intoRight < intoLeft ? box.right : box.left, center.y);
+            contact.depth = fminf(intoLeft, intoRight);
+            return true;
+        }
+
+        // Otherwise the circle is beyond the box diagonally, and only hit it if it is over one of its corners: top left,
+        // top right, bottom right then bottom left
+        const sf::Vector2f corners[] = {sf::Vector2f(box.left, box.top), sf::Vector2f(box.right, box.top),
+                                        sf::Vector2f(box.right, box.bottom), sf::Vector2f(box.left, box.bottom)};
+        for (const sf::Vector2f& corner : corners) {
+            sf::Vector2f offset = center - corner;
+            float distanceSquared = offset.x * offset.x + offset.y * offset.y;
+            if (distanceSquared < radius * radius && distanceSquared > 0) {
+                float distance = sqrtf(distanceSquared);
+                contact.normal = offset / distance;
+                contact.point = corner;
+                contact.depth = radius - distance;
+                return true;
+            }
+        }
+
+        // The square around the circle overlaps the box, but the circle itself doesn't
+        return false;
+    }
+};
+
+/**
+ * \brief Tests a circle against a capsule
+ *
+ * \details Finds the closest point to the circle's center on the capsule's segment. Between the segment's ends the
+ *      circle is against one of the flat sides, and the normal is the capsule's own. At either end it is against the
+ *      rounded cap, and the normal points from the end to the circle.
+ */
+template <>
+struct Collider<Circle, Capsule> {
+    static bool test(const Circle& circle, const Capsule& capsule, Contact& contact) {
+        sf::Vector2f segment = capsule.end - capsule.start;
+        sf::Vector2f offset = circle.center - capsule.start;
+        float along = (offset.x * segment.x + offset.y * segment.y) / (segment.x * segment.x + segment.y * segment.y);
+        along = along < 0 ? 0 : (along > 1 ? 1 : along);
+        sf::Vector2f closest = capsule.start + segment * along;
+
+        // Touching if the circle's center is within both radii of that point
+        sf::Vector2f separation = circle.center - closest;
+        float distanceSquared = separation.x * separation.x + separation.y * separation.y;
+        float reach = circle.radius + capsule.radius;
+        if (distanceSquared >= reach * reach) {
+            return false;
+        }
+
+        float distance = sqrtf(distanceSquared);
+        if (along > 0 && along < 1) {
+            bool below = separation.x * capsule.normal.x + separation.y * capsule.normal.y >= 0;
+            contact.normal = below ? capsule.normal : -capsule.normal;
+        }
+        else if (distance > 0) {
+            contact.normal = separation / distance;
+        }
+        else {
+            contact.normal = -capsule.normal;
+        }
+        contact.point = closest + contact.normal * capsule.radius;
+        contact.depth = reach - distance;
+        contact.otherVel = capsule.vel;
+        return true;
+    }
+};
+
+/**
+ * \brief Tests a circle against another circle
+ *
+ * \note Circles at almost the same spot (within a quarter of the first's radius) aren't counted as touching, since
+ *      there is no sensible normal between them
+ */
+template <>
+struct Collider<Circle, Circle> {
+    static bool test(const Circle& circle, const Circle& other, Contact& contact) {
+        sf::Vector2f separation = circle.center - other.center;
+        float distanceSquared = separation.x * separation.x + separation.y * separation.y;
+        float reach = circle.radius + other.radius;
+        if (distanceSquared >= reach * reach || distanceSquared <= circle.radius * circle.radius / 16) {
+            return false;
+        }
+
+        float distance = sqrtf(distanceSquared);
+        contact.normal = separation / distance;
+        contact.point = other.center + contact.normal * other.radius;
+        contact.depth = reach - distance;
+        contact.otherVel = other.vel;
+        return true;
+    }
+};
+
+/**
+ * \brief Tests a box against another box
+ *
+ * \details The normal is along whichever axis they overlap least on
+ */
+template <>
+struct Collider<Box, Box> {
+    static bool test(const Box& box, const Box& other, Contact& contact) {
+        if (box.right <= other.left || box.left >= other.right || box.bottom <= other.top || box.top >= other.bottom) {
+            return false;
+        }
+
+        float overlapX = fminf(box.right - other.left, other.right - box.left);
+        float overlapY = fminf(box.bottom - other.top, other.bottom - box.top);
+        if (overlapX < overlapY) {
+            bool right = box.left + box.right > other.left + other.right;
+            contact.normal = sf::Vector2f(right ? 1.f : -1.f, 0);
+            contact.point = sf::Vector2f(right ? other.right : other.left, (box.top + box.bottom) / 2);
+            contact.depth = overlapX;
+        }
+        else {
+            bool below = box.top + box.bottom > other.top + other.bottom;
+            contact.normal = sf::Vector2f(0, below ? 1.f : -1.f);
+            contact.point = sf::Vector2f((box.left + box.right) / 2, below ? other.bottom : other.top);
+            contact.depth = overlapY;
+        }
+        contact.otherVel = sf::Vector2f(0, 0);
+        return true;
+    }
+};
+
+/**
+ * \brief Tests whether two shapes are touching, using the test for their pair of types
+ *
+ * \return true if they are, and contact is then filled in as seen from the first shape
+ */
+template <typename First, typename Second>
+inline bool collide(const First& first, const Second& second, Contact& contact) {
+    return Collider<First, Second>::test(first, second, contact);
+}
+
+#endif //BRICKBREAKER_COLLISION_H
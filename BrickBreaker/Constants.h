@@ -18,6 +18,22 @@ const unsigned int WINDOW_WIDTH = 1300;
 
 const unsigned int WINDOW_HEIGHT = 800;
 
+const unsigned int FRAME_RATE = 60;             ///< The game is updated this many times per second
+
+const float TIME_SCALES[] = {.1f, .25f, .5f, 1, 2, 4, 8, 16};  ///< Speeds the game can run at, in ticks per frame
+
+const unsigned int NUM_TIME_SCALES = sizeof(TIME_SCALES) / sizeof(float);
+
+const unsigned int HUD_REFRESH_FRAMES = 15;     ///< How many frames the performance overlay text stays up before changing
+
+const float SLOW_FRAME_TIME = 1000.0f / FRAME_RATE;    ///< In milliseconds, frames taking longer than this are captured
+
+const float SLOW_FRAME_COOLDOWN = 5;            ///< In seconds, minimum time between two slow frame captures
+
+const float KEYFRAME_INTERVAL = 2;              ///< In seconds, how often a snapshot is kept for slow frame captures
+
+const unsigned int HUD_TEXT_SIZE = 9;           ///< Small enough to fit three lines in the banner
+
 const float LEVEL_BREAK_TIME = 5;               ///< How many seconds to wait between levels
 
 const float PADDLE_WIDTH = 100;
@@ -28,7 +44,7 @@ const float PADDLE_ELONGATION_TIME = 15;        ///< In seconds
 
 const float PADDLE_ELONGATION_FACTOR = 1.5f;    ///< In seconds
 
-const float PADDLE_MAX_ROTATION = 15;           ///< This is in degrees
+constexpr float PADDLE_MAX_ROTATION = 15;       ///< This is in degrees
 
 const float PADDLE_ACCELERATION = 1;
 
@@ -44,11 +60,26 @@ const unsigned int NUM_SAFETY_BRICKS = 10;               ///< Decremented by one
 
 const float BRICK_SEPARATION = 1;               ///< How much space to put between each brick when creating a stage
 
+const float BRICK_EXPLOSION_RADIUS = 40;        ///< How far from its center an explosive brick takes out other bricks
+
+const float JUNK_ROW_CLEARANCE = 200;           ///< Junk rows stop being added this far above the paddle
+
 const float BALL_RADIUS = 10;
 
+const float BALL_BIG_RADIUS = 20;               ///< Radius of balls made big by a big ball brick
+
+const float BALL_TINY_RADIUS = 5;               ///< Radius of balls made tiny by a tiny ball brick
+
+const float BALL_RESIZE_TIME = 10;              ///< In seconds, how long balls stay big or tiny
+
 const float BALL_MAX_SPEED = 8.0;               ///< A soft cap on ball velocity
 
-const char SPECIALS[] = {'b', 'l'};                     ///< A list of all special brick characters.
+const unsigned int BALL_TRAIL_LENGTH = 12;      ///< How many past positions, one per tick, each ball's trail follows
+
+/// The most vertices one ball's trail takes in a triangle strip, including the two that join it to the ball before it
+const unsigned int BALL_TRAIL_VERTICES = 2 * (BALL_TRAIL_LENGTH + 1) + 2;
+
+const char SPECIALS[] = {'b', 'l', 'g', 't', 'z'};      ///< A list of all special brick characters.
 
 // Colors //
 const sf::Color DEFAULT_COLOR = sf::Color(51,51,51);            ///< Used for the paddle, barrier, and normal text
@@ -63,10 +94,30 @@ const sf::Color SPECIAL_BRICK_COLOR = sf::Color(255,202,58);
 
 const sf::Color SAFETY_BRICK_COLOR = sf::Color(255,102,0);
 
+const sf::Color JUNK_BRICK_COLOR = sf::Color(150,150,150);
+
+/// Shades a scripted brick can set with its color instruction, starting with the one it has until it does
+const sf::Color SCRIPTED_BRICK_COLORS[] = {sf::Color(106,76,147), sf::Color(25,130,196), sf::Color(138,201,38),
+                                           sf::Color(255,202,58), sf::Color(255,102,0), sf::Color(255,89,94),
+                                           sf::Color(51,51,51), sf::Color(200,200,200)};
+
+const unsigned int NUM_SCRIPTED_BRICK_COLORS = sizeof(SCRIPTED_BRICK_COLORS) / sizeof(sf::Color);
+
+/// Bricks that take several hits, by hits left (one, two, three). Each hit fades them towards the background.
+const sf::Color HIT_POINT_BRICK_COLORS[] = {sf::Color(140,195,230), sf::Color(25,130,196), sf::Color(10,70,110)};
+
+const sf::Color ARMORED_BRICK_COLOR = sf::Color(95,100,110);
+
+const sf::Color EXPLOSIVE_BRICK_COLOR = sf::Color(200,30,45);
+
+const sf::Color LASER_COLOR = sf::Color(230,40,110);
+
 const sf::Color LOSE_COLOR = sf::Color(255,0,0);                ///< Text color for failure messages
 
 const sf::Color WIN_COLOR = sf::Color(138,201,38);              ///< Text color for failure messages
 
+const sf::Color HUD_ALLOCATION_COLOR = sf::Color(255,102,0);    ///< Sparkline color for heap allocations per frame
+
 // Used for creating the first level
 
 const unsigned int NUM_BRICKS_PER_LINE = 20;
@@ -0,0 +1,98 @@
+/**
+ * \file Explosions.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the chain reactions of explosive bricks, spread through the bricks as sets of bits
+ */
+#include <algorithm>
+#include "Explosions.h"
+#include "Brick.h"
+#include "Constants.h"
+
+using namespace sf;
+using namespace std;
+
+Explosions::Explosions()
+        : pending_(false)
+{
+}
+
+void Explosions::trigger(unsigned long brick) {
+    unsigned long word = brick / 64;
+    if (word >= exploding_.size())
+        exploding_.resize(word + 1, 0);
+
+    exploding_[word] |= uint64_t(1) << (brick % 64);
+    pending_ = true;
+}
+
+bool Explosions::isPending() const {
+    return pending_;
+}
+
+unsigned int Explosions::spread(const vector<Object*>& objects, long first, long end, const BrickBatch& bricks,
+                                const BrickGrid& grid) {
+    unsigned long numWords = (unsigned long)(end - first + 63) / 64;
+    exploding_.resize(numWords, 0);
+    reached_.resize(numWords);
+    explosive_.resize(numWords);
+    destroyed_.assign(exploding_.begin(), exploding_.end());
+
+    unsigned int numReached = 0;
+    auto reach = [&](uint32_t brick) {
+        ++numReached;
+        unsigned long word = brick / 64;
+        uint64_t bit = uint64_t(1) << (brick % 64);
+        if ((destroyed_[word] | reached_[word]) & bit)
+            return;
+
+        char type = bricks.getType(brick);
+        if (type == 'a' || type == 'x')
+            return;
+
+        reached_[word] |= bit;
+        if (type == 'e')
+            explosive_[word] |= bit;
+    };
+
+    while (pending_) {
+        fill(reached_.begin(), reached_.end(), 0);
+        fill(explosive_.begin(), explosive_.end(), 0);
+
+        // Every brick within the blast of each explosive going off, other than those already destroyed
+        for (unsigned long word = 0; word < numWords; ++word) {
+            uint64_t bits = exploding_[word];
+            for (unsigned long bit = 0; bits != 0; ++bit, bits >>= 1) {
+                if ((bits & 1) == 0)
+                    continue;
+
+                const Box& box = static_cast<Brick*>(objects[first + word * 64 + bit])->getShape();
+                Circle blast{Vector2f((box.left + box.right) / 2, (box.top + box.bottom) / 2), BRICK_EXPLOSION_RADIUS,
+                             Vector2f(0, 0)};
+                grid.forEachTouching(blast, reach);
+            }
+        }
+
+        // The explosives among them go off next
+        pending_ = false;
+        for (unsigned long word = 0; word < numWords; ++word) {
+            destroyed_[word] |= reached_[word];
+            exploding_[word] = explosive_[word];
+            pending_ = pending_ || exploding_[word] != 0;
+        }
+    }
+
+    return numReached;
+}
+
+const vector<uint64_t>& Explosions::getDestroyed() const {
+    return destroyed_;
+}
+
+unsigned long Explosions::getHeapBytes() const {
+    return (exploding_.capacity() + reached_.capacity() + explosive_.capacity() + destroyed_.capacity())
+           * sizeof(uint64_t);
+}
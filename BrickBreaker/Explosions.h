@@ -0,0 +1,83 @@
+/**
+ * \file Explosions.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the chain reactions of explosive bricks, spread through the bricks as sets of bits
+ */
+
+#ifndef BRICKBREAKER_EXPLOSIONS_H
+#define BRICKBREAKER_EXPLOSIONS_H
+
+#include <cstdint>
+#include <vector>
+#include "BrickBatch.h"
+#include "BrickGrid.h"
+#include "Object.h"
+
+/**
+ * \class Explosions
+ * \brief Finds every brick taken out by the explosive bricks destroyed this tick, and by those they set off in turn
+ *
+ * \details Explosive bricks ('e') destroyed during a tick are triggered by their position after the first brick. The
+ *      reaction then spreads breadth first, one ring of explosions at a time, with sets of bits over the bricks: the
+ *      explosives going off, the bricks they reach and the explosives among those, and every brick destroyed so far.
+ *      Each ring walks the grid cells around every exploding brick, where a brick already in a set costs one bit
+ *      test, and the explosives among the bricks it newly reaches are the next ring. The whole reaction is over within
+ *      the tick, before any brick is removed, so no brick moves while it spreads.
+ *
+ *      Armored and scripted bricks are left standing. The sets are kept from tick to tick, so a reaction only
+ *      allocates when the stage has more bricks than it ever has.
+ */
+class Explosions {
+public:
+    Explosions();
+
+    /**
+     * \brief Sets off an explosive brick that has just been destroyed
+     *
+     * \param brick The brick's position after the first brick in the game's list of objects
+     */
+    void trigger(unsigned long brick);
+
+    /**
+     * \brief Returns whether any brick has been triggered since the last call to spread()
+     */
+    bool isPending() const;
+
+    /**
+     * \brief Spreads the explosions triggered this tick until no more explosives are reached
+     *
+     * \param objects   The game's objects
+     *        first     Index of the first brick in objects
+     *        end       Index one past the last brick in objects
+     *        bricks    The bricks' types
+     *        grid      The bricks by where they are, built from the same objects
+     *
+     * \return How many times a blast reached a brick, for the profiler
+     */
+    unsigned int spread(const std::vector<Object*>& objects, long first, long end, const BrickBatch& bricks,
+                        const BrickGrid& grid);
+
+    /**
+     * \brief Returns the bricks destroyed by the last call to spread(), one bit each by position after the first brick
+     *      and 64 to a word, including the ones triggered
+     */
+    const std::vector<uint64_t>& getDestroyed() const;
+
+    /**
+     * \brief Returns the number of bytes the sets hold on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+private:
+    std::vector<uint64_t> exploding_;   ///< The explosives going off in this ring
+    std::vector<uint64_t> reached_;     ///< The bricks this ring's blasts reach
+    std::vector<uint64_t> explosive_;   ///< The explosives among them
+    std::vector<uint64_t> destroyed_;   ///< Every brick destroyed since the reaction started
+    bool pending_;
+};
+
+#endif //BRICKBREAKER_EXPLOSIONS_H
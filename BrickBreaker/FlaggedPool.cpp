@@ -0,0 +1,39 @@
+/**
+ * \file FlaggedPool.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the bookkeeping shared by the fixed size pools that flag entries four at a time, then remove them
+ */
+#include "FlaggedPool.h"
+
+FlaggedPool::FlaggedPool(unsigned int capacity)
+        : flags_(capacity / 4),
+          capacity_(capacity),
+          count_(0),
+          flagged_(0)
+{
+}
+
+unsigned int FlaggedPool::getCount() const {
+    return count_;
+}
+
+bool FlaggedPool::add(unsigned int& index) {
+    if (count_ == capacity_)
+        return false;
+
+    index = count_++;
+    return true;
+}
+
+void FlaggedPool::clear() {
+    count_ = 0;
+    flagged_ = 0;
+}
+
+unsigned long FlaggedPool::getHeapBytes() const {
+    return flags_.capacity();
+}
@@ -0,0 +1,138 @@
+/**
+ * \file FlaggedPool.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the bookkeeping shared by the fixed size pools that flag entries four at a time, then remove them
+ */
+
+#ifndef BRICKBREAKER_FLAGGEDPOOL_H
+#define BRICKBREAKER_FLAGGEDPOOL_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \class FlaggedPool
+ * \brief The count and flags of a fixed size pool stored one array per field, such as Lasers and PowerUps
+ *
+ * \details The pool's owner keeps the arrays, all allocated once at full capacity, and this keeps how many entries
+ *      are live. An update is two passes. The first moves every entry and flags the ones that need a closer look,
+ *      four at a time with SSE where it is available (flagGroups()) and one at a time for the rest (flagEach()).
+ *      The second visits only the flagged ones (forEachFlagged()), from the back, so an entry removed there is
+ *      replaced by the last live one, which has already been looked at.
+ *
+ *      The capacity has to be a multiple of four, so the last group of four can safely run on into unused slots,
+ *      which are never looked at.
+ */
+class FlaggedPool {
+public:
+    /**
+     * \brief Parametrized constructor for a pool's bookkeeping
+     *
+     * \param capacity  Most entries live at once, a multiple of four
+     */
+    explicit FlaggedPool(unsigned int capacity);
+
+    /**
+     * \brief Returns the number of live entries, which are the first ones in each of the owner's arrays
+     */
+    unsigned int getCount() const;
+
+    /**
+     * \brief Makes room for one more entry
+     *
+     * \param index Where the owner writes the new entry's fields
+     *
+     * \return false if the pool is full, in which case index isn't set
+     */
+    bool add(unsigned int& index);
+
+    /**
+     * \brief Replaces an entry with the last live one in each of the owner's arrays
+     */
+    template <typename... Fields>
+    void remove(unsigned int index, std::vector<Fields>&... fields);
+
+    /**
+     * \brief Removes every entry
+     */
+    void clear();
+
+    /**
+     * \brief Calls flag(i) with the first of every group of four live entries, setting their flags to its result
+     *
+     * \param flag  Returns which of the four need a closer look as a mask, the way _mm_movemask_ps() gives it
+     *
+     * \return The index of the first entry not flagged, for flagEach() to start from
+     */
+    template <typename FlagGroup>
+    unsigned int flagGroups(FlagGroup flag);
+
+    /**
+     * \brief Calls flag(i) with every live entry from first on, setting its flag if it returns true
+     */
+    template <typename FlagOne>
+    void flagEach(unsigned int first, FlagOne flag);
+
+    /**
+     * \brief Calls visit(i) with every entry flagged, from the back, so visit can remove the entry it is given
+     */
+    template <typename Visit>
+    void forEachFlagged(Visit visit) const;
+
+    /**
+     * \brief Returns the number of bytes the flags hold on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+private:
+    std::vector<uint8_t> flags_;        ///< One per group of four, which of them need a closer look
+    unsigned int capacity_;
+    unsigned int count_;
+    unsigned int flagged_;              ///< How many entries were live when they were flagged
+};
+
+template <typename... Fields>
+void FlaggedPool::remove(unsigned int index, std::vector<Fields>&... fields) {
+    --count_;
+
+    // Copies the last entry of each array in turn, the list only being there to expand the pack in
+    int copies[] = {0, (fields[index] = fields[count_], 0)...};
+    (void)copies;
+}
+
+template <typename FlagGroup>
+unsigned int FlaggedPool::flagGroups(FlagGroup flag) {
+    flagged_ = count_;
+
+    unsigned int i = 0;
+    for (; i < count_; i += 4)
+        flags_[i / 4] = uint8_t(flag(i));
+    return i;
+}
+
+template <typename FlagOne>
+void FlaggedPool::flagEach(unsigned int first, FlagOne flag) {
+    flagged_ = count_;
+
+    for (unsigned int i = first; i < count_; ++i) {
+        if (i % 4 == 0)
+            flags_[i / 4] = 0;
+
+        if (flag(i))
+            flags_[i / 4] |= uint8_t(1 << (i % 4));
+    }
+}
+
+template <typename Visit>
+void FlaggedPool::forEachFlagged(Visit visit) const {
+    for (unsigned int i = flagged_; i-- > 0;) {
+        if ((flags_[i / 4] >> (i % 4) & 1) != 0)
+            visit(i);
+    }
+}
+
+#endif //BRICKBREAKER_FLAGGEDPOOL_H
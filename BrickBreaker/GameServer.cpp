@@ -0,0 +1,547 @@
+/**
+ * \file GameServer.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a server hosting many remote play sessions on one event loop
+ */
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include "GameServer.h"
+#include "Socket.h"
+#include "StageBuilder.h"
+
+using namespace std;
+
+GameServer::Connection::Connection(int fd)
+        : fd(fd),
+          index(0),
+          session(nullptr),
+          spectator(false),
+          spectatorIndex(0),
+          waitingForKeyframe(false),
+          outputSent(0),
+          waitingToWrite(false)
+{
+}
+
+GameServer::SpectatorStream::SpectatorStream()
+        : ticksSinceKeyframe(0),
+          keyframeRequested(true),
+          forceKeyframe(false)
+{
+}
+
+GameServer::Session::Session(unsigned long id, unsigned int seed)
+        : id(id),
+          index(0),
+          player(nullptr),
+          game(seed),
+          stream(nullptr)
+{
+}
+
+GameServer::GameServer(unsigned int seed, unsigned int numThreads)
+        : epoll_(-1),
+          timer_(-1),
+          signals_(-1),
+          nextSessionId_(1),
+          nextSeed_(seed),
+          workers_(numThreads),
+          snapshotIndex_(0),
+          stopping_(false),
+          encodeSnapshotIndex_(0),
+          encoding_(false),
+          numTicks_(0),
+          numLateTicks_(0),
+          numSessionsServed_(0),
+          peakSessions_(0),
+          numSpectatorsServed_(0),
+          peakSpectators_(0),
+          numSpectators_(0),
+          bytesReceived_(0),
+          bytesSent_(0),
+          bytesSentToSpectators_(0),
+          numDroppedMessages_(0),
+          tickSeconds_(0),
+          maxTickSeconds_(0)
+{
+    Socket::raiseFileLimit();
+
+    // Create the data folder now rather than racing the first few sessions to it
+    StageBuilder::checkDataFile();
+}
+
+GameServer::~GameServer() {
+    // Closing a player closes everyone watching it too, so just keep closing whatever is last
+    while (!connections_.empty()) {
+        close(*connections_.back());
+    }
+
+    for (int fd : listeners_) {
+        ::close(fd);
+    }
+    if (epoll_ >= 0)
+        ::close(epoll_);
+    if (timer_ >= 0)
+        ::close(timer_);
+    if (signals_ >= 0)
+        ::close(signals_);
+}
+
+bool GameServer::listen(const string& address) {
+    int fd = Socket::listen(address);
+    if (fd < 0)
+        return false;
+
+    listeners_.push_back(fd);
+    return true;
+}
+
+bool GameServer::run() {
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+
+    // One timer steps every session, firing once per frame of the regular game
+    timer_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    itimerspec interval;
+    interval.it_interval.tv_sec = 0;
+    interval.it_interval.tv_nsec = 1000000000L / FRAME_RATE;
+    interval.it_value = interval.it_interval;
+
+    // Take SIGINT and SIGTERM as events instead of having them kill the process, so the summary can be written
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &stopSignals, nullptr);
+    signals_ = signalfd(-1, &stopSignals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    if (epoll_ < 0 || timer_ < 0 || signals_ < 0 || timerfd_settime(timer_, 0, &interval, nullptr) != 0) {
+        cerr << "Could not set up the server's event loop" << endl;
+        return false;
+    }
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    for (int fd : listeners_) {
+        event.data.fd = fd;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+    }
+    event.data.fd = timer_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, timer_, &event);
+    event.data.fd = signals_;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, signals_, &event);
+
+    encoder_ = thread(&GameServer::encodeSpectatorStreams, this);
+
+    epoll_event events[256];
+    bool running = true;
+    bool failed = false;
+    while (running) {
+        int numEvents = epoll_wait(epoll_, events, 256, -1);
+        if (numEvents < 0 && errno != EINTR) {
+            cerr << "epoll_wait failed" << endl;
+            running = false;
+            failed = true;
+        }
+
+        for (int i = 0; i < numEvents; ++i) {
+            int fd = events[i].data.fd;
+
+            if (fd == timer_) {
+                uint64_t expirations = 0;
+                if (::read(timer_, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+                    // If the loop fell behind, catch up a few ticks but don't try to make up for a long stall
+                    if (expirations > 1)
+                        numLateTicks_ += expirations - 1;
+                    tick(min<unsigned long>(expirations, MAX_CATCH_UP_TICKS));
+                }
+            }
+            else if (fd == signals_) {
+                // Take the signal so it isn't delivered again once it is unblocked
+                signalfd_siginfo signal;
+                if (::read(signals_, &signal, sizeof(signal)) == sizeof(signal))
+                    running = false;
+            }
+            else if (find(listeners_.begin(), listeners_.end(), fd) != listeners_.end()) {
+                accept(fd);
+            }
+            else if (size_t(fd) < connectionsByFd_.size() && connectionsByFd_[fd] != nullptr) {
+                Connection& connection = *connectionsByFd_[fd];
+
+                // Errors and hang ups show up as a failed read
+                if (((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) && !read(connection))
+                    || ((events[i].events & EPOLLOUT) && !write(connection))) {
+                    close(connection);
+                }
+            }
+        }
+    }
+
+    // Let the encoder finish. The workers are idle between ticks, and are stopped with the server.
+    waitForEncoder();
+    {
+        lock_guard<mutex> encodeLock(encodeMutex_);
+        stopping_ = true;
+    }
+    encodeStarted_.notify_all();
+    encoder_.join();
+
+    sigprocmask(SIG_UNBLOCK, &stopSignals, nullptr);
+    return !failed;
+}
+
+void GameServer::accept(int listener) {
+    int fd;
+    while ((fd = Socket::accept(listener)) >= 0) {
+        Connection* connection = new Connection(fd);
+        connection->index = connections_.size();
+        connections_.push_back(connection);
+
+        if (size_t(fd) >= connectionsByFd_.size())
+            connectionsByFd_.resize(fd + 1, nullptr);
+        connectionsByFd_[fd] = connection;
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+bool GameServer::read(Connection& connection) {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t numRead = ::read(connection.fd, buffer, sizeof(buffer));
+        if (numRead > 0) {
+            bytesReceived_ += numRead;
+            connection.input.insert(connection.input.end(), buffer, buffer + numRead);
+        }
+        else if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (numRead < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            // The client hung up or the connection broke
+            return false;
+        }
+    }
+
+    // Handle every complete message
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    while (MessageReader::next(connection.input.data(), connection.input.size(), offset, type, payload)) {
+        if (connection.session == nullptr) {
+            if (!join(connection, type, payload))
+                return false;
+            continue;
+        }
+
+        // Spectators have nothing more to say, and players may only play the game, not use the debugging keys
+        uint8_t eventType = payload.readU8();
+        uint8_t key = payload.readU8();
+        bool allowed = key == sf::Keyboard::J || key == sf::Keyboard::L || key == sf::Keyboard::A
+                       || key == sf::Keyboard::D || key == sf::Keyboard::Space || key == sf::Keyboard::Escape
+                       || key == sf::Keyboard::Return;
+
+        if (connection.spectator || type != MESSAGE_INPUT || !payload.isValid() || !payload.atEnd() || !allowed
+            || (eventType != sf::Event::KeyPressed && eventType != sf::Event::KeyReleased)) {
+            return false;
+        }
+
+        sf::Event event;
+        event.type = sf::Event::EventType(eventType);
+        event.key.code = sf::Keyboard::Key(key);
+        event.key.alt = false;
+        event.key.control = false;
+        event.key.shift = false;
+        event.key.system = false;
+        connection.session->game.handleEvent(event);
+    }
+    connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+
+    // A client that keeps sending without finishing a message is broken or hostile
+    return connection.input.size() <= MAX_PENDING_INPUT;
+}
+
+bool GameServer::join(Connection& connection, MessageType type, MessageReader& payload) {
+    Session* session = nullptr;
+
+    if (type == MESSAGE_PLAY && payload.atEnd()) {
+        session = new Session(nextSessionId_++, nextSeed_++);
+        session->index = sessions_.size();
+        session->player = &connection;
+        sessions_.push_back(session);
+        sessionsById_[session->id] = session;
+
+        ++numSessionsServed_;
+        peakSessions_ = max<unsigned long>(peakSessions_, sessions_.size());
+    }
+    else if (type == MESSAGE_WATCH) {
+        unsigned long id = payload.readVarint();
+        unordered_map<unsigned long, Session*>::iterator found = sessionsById_.find(id);
+        if (!payload.isValid() || !payload.atEnd() || found == sessionsById_.end())
+            return false;
+
+        session = found->second;
+        connection.spectator = true;
+        connection.spectatorIndex = session->spectators.size();
+        connection.waitingForKeyframe = true;
+        session->spectators.push_back(&connection);
+
+        // The first spectator starts the stream, and every new one needs a keyframe to start from
+        if (session->stream == nullptr)
+            session->stream = new SpectatorStream();
+        session->stream->keyframeRequested = true;
+
+        ++numSpectators_;
+        ++numSpectatorsServed_;
+        peakSpectators_ = max(peakSpectators_, numSpectators_);
+    }
+    else {
+        return false;
+    }
+
+    connection.session = session;
+
+    MessageWriter welcome(connection.output, MESSAGE_WELCOME);
+    welcome.writeVarint(uint32_t(session->id));
+    welcome.finish();
+    return true;
+}
+
+bool GameServer::write(Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t numSent = send(connection.fd, connection.output.data() + connection.outputSent,
+                               connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (numSent > 0) {
+            bytesSent_ += numSent;
+            connection.outputSent += numSent;
+        }
+        else if (numSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // The socket is full, so have epoll say when there is room again
+            if (!connection.waitingToWrite)
+                watch(connection, true);
+            return true;
+        }
+        else if (numSent < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+
+    // Everything was sent. Keep the buffer's memory for the next tick.
+    connection.output.clear();
+    connection.outputSent = 0;
+    if (connection.waitingToWrite)
+        watch(connection, false);
+    return true;
+}
+
+void GameServer::tick(unsigned long numTicks) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    workers_.run([this, numTicks](unsigned int worker) { stepSessions(worker, numTicks); });
+    numTicks_ += numTicks;
+
+    // The encoder has had the whole tick to encode the last snapshots. Send what it made, then hand it this tick's.
+    waitForEncoder();
+    sendSpectatorStreams();
+    {
+        lock_guard<mutex> lock(encodeMutex_);
+        streamsToEncode_.clear();
+        for (Session* session : sessions_) {
+            if (session->stream != nullptr) {
+                session->stream->forceKeyframe = session->stream->keyframeRequested;
+                session->stream->keyframeRequested = false;
+                streamsToEncode_.push_back(session->stream);
+            }
+        }
+        encodeSnapshotIndex_ = snapshotIndex_;
+        encoding_ = !streamsToEncode_.empty();
+    }
+    encodeStarted_.notify_one();
+    snapshotIndex_ = 1 - snapshotIndex_;
+
+    // Send every client its new messages. Closing a player closes its spectators as well, so closing waits until
+    // every connection has been written to.
+    for (Connection* connection : connections_) {
+        if (!connection->waitingToWrite && !write(*connection))
+            failed_.push_back(connection->fd);
+    }
+    for (int fd : failed_) {
+        if (connectionsByFd_[fd] != nullptr)
+            close(*connectionsByFd_[fd]);
+    }
+    failed_.clear();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    tickSeconds_ += seconds;
+    maxTickSeconds_ = max(maxTickSeconds_, seconds);
+}
+
+void GameServer::stepSessions(unsigned int worker, unsigned long numTicks) {
+    for (unsigned long i = worker; i < sessions_.size(); i += workers_.getNumThreads()) {
+        Session& session = *sessions_[i];
+        Connection& player = *session.player;
+
+        for (unsigned long j = 0; j < numTicks; ++j) {
+            session.game.step();
+        }
+
+        // Spectators' messages are encoded on the encoder thread, so just copy the state for it
+        session.game.saveState(session.snapshot);
+        if (session.stream != nullptr)
+            session.stream->snapshots[snapshotIndex_] = session.snapshot;
+
+        // Drop the message if the player isn't keeping up, and start it over with a keyframe once it does. Only the
+        // latest state is sent, even if several ticks were stepped.
+        if (player.output.size() - player.outputSent > MAX_PENDING_OUTPUT) {
+            session.encoder.reset();
+            ++numDroppedMessages_;
+        }
+        else {
+            session.encoder.encode(session.snapshot, player.output);
+        }
+    }
+}
+
+void GameServer::encodeSpectatorStreams() {
+    while (true) {
+        unique_lock<mutex> lock(encodeMutex_);
+        encodeStarted_.wait(lock, [this] { return stopping_ || encoding_; });
+        if (stopping_)
+            return;
+
+        // The event loop doesn't touch the streams until encoding_ is cleared, so they can be encoded unlocked
+        lock.unlock();
+        for (SpectatorStream* stream : streamsToEncode_) {
+            if (stream->forceKeyframe || stream->ticksSinceKeyframe >= SPECTATOR_KEYFRAME_INTERVAL)
+                stream->encoder.reset();
+
+            stream->message.clear();
+            stream->encoder.encode(stream->snapshots[encodeSnapshotIndex_], stream->message);
+            stream->ticksSinceKeyframe = stream->encoder.wroteKeyframe() ? 0 : stream->ticksSinceKeyframe + 1;
+        }
+        lock.lock();
+
+        encoding_ = false;
+        encodeFinished_.notify_one();
+    }
+}
+
+void GameServer::waitForEncoder() {
+    unique_lock<mutex> lock(encodeMutex_);
+    encodeFinished_.wait(lock, [this] { return !encoding_; });
+}
+
+void GameServer::sendSpectatorStreams() {
+    for (Session* session : sessions_) {
+        SpectatorStream* stream = session->stream;
+        if (stream == nullptr || stream->message.empty())
+            continue;
+
+        bool keyframe = stream->message[2] == MESSAGE_KEYFRAME;
+        for (Connection* spectator : session->spectators) {
+            if (spectator->waitingForKeyframe && !keyframe)
+                continue;
+
+            // A spectator that falls behind skips ahead to the next keyframe, and asks for one to come soon
+            if (spectator->output.size() - spectator->outputSent > MAX_PENDING_OUTPUT) {
+                spectator->waitingForKeyframe = true;
+                stream->keyframeRequested = true;
+                ++numDroppedMessages_;
+                continue;
+            }
+
+            spectator->waitingForKeyframe = false;
+            spectator->output.insert(spectator->output.end(), stream->message.begin(), stream->message.end());
+            bytesSentToSpectators_ += stream->message.size();
+        }
+
+        stream->message.clear();
+    }
+}
+
+void GameServer::close(Connection& connection) {
+    Session* session = connection.session;
+
+    if (session != nullptr && connection.spectator) {
+        stopWatching(connection);
+    }
+    else if (session != nullptr) {
+        // The game ends with its player, and everyone watching goes with it
+        while (!session->spectators.empty()) {
+            close(*session->spectators.back());
+        }
+
+        sessions_[session->index] = sessions_.back();
+        sessions_[session->index]->index = session->index;
+        sessions_.pop_back();
+        sessionsById_.erase(session->id);
+        delete session;
+    }
+
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, connection.fd, nullptr);
+    ::close(connection.fd);
+    connectionsByFd_[connection.fd] = nullptr;
+
+    // Move the last connection into this one's place
+    connections_[connection.index] = connections_.back();
+    connections_[connection.index]->index = connection.index;
+    connections_.pop_back();
+
+    delete &connection;
+}
+
+void GameServer::stopWatching(Connection& spectator) {
+    Session& session = *spectator.session;
+
+    session.spectators[spectator.spectatorIndex] = session.spectators.back();
+    session.spectators[spectator.spectatorIndex]->spectatorIndex = spectator.spectatorIndex;
+    session.spectators.pop_back();
+    --numSpectators_;
+
+    // The encoder may still be working on the stream
+    if (session.spectators.empty()) {
+        waitForEncoder();
+        delete session.stream;
+        session.stream = nullptr;
+    }
+}
+
+void GameServer::watch(Connection& connection, bool forWriting) {
+    epoll_event event;
+    event.events = forWriting ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    event.data.fd = connection.fd;
+    epoll_ctl(epoll_, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.waitingToWrite = forWriting;
+}
+
+void GameServer::writeSummary(ostream& out) const {
+    out << "Threads: " << workers_.getNumThreads() << " stepping, 1 encoding for spectators\n";
+    out << "Sessions served: " << numSessionsServed_ << " (at most " << peakSessions_ << " at once)\n";
+    out << "Spectators served: " << numSpectatorsServed_ << " (at most " << peakSpectators_ << " at once)\n";
+    out << "Ticks: " << numTicks_ << " (" << numLateTicks_ << " late)\n";
+    if (numTicks_ > 0) {
+        out << "Mean tick time: " << tickSeconds_ / numTicks_ * 1000 << " ms, longest " << maxTickSeconds_ * 1000
+            << " ms, budget " << 1000.0 / FRAME_RATE << " ms\n";
+    }
+    out << "Bytes received: " << bytesReceived_ << "\n";
+    out << "Bytes sent: " << bytesSent_ << ", " << bytesSentToSpectators_ << " of them to spectators ("
+        << numDroppedMessages_ << " messages dropped for slow clients)\n";
+}
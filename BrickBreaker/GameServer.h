@@ -0,0 +1,254 @@
+/**
+ * \file GameServer.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a server hosting many remote play sessions on one event loop
+ */
+
+#ifndef BRICKBREAKER_GAMESERVER_H
+#define BRICKBREAKER_GAMESERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "GameState.h"
+#include "GraphicsRunner.h"
+#include "StateEncoder.h"
+#include "WorkerPool.h"
+
+/**
+ * \class GameServer
+ * \brief Runs one headless game for every connected player, all stepped together on a fixed tick
+ *
+ * \details All networking happens on one thread around one epoll instance: accepting connections, reading input
+ *      messages, a timerfd that fires once per tick, and writing state messages back. When the timer fires, every
+ *      game is stepped and encoded by a pool of worker threads (the event loop's thread is one of them) while the
+ *      event loop waits, so no game is ever touched by two threads at once. Sockets are non-blocking and per session
+ *      buffers are reused, so sessions cost no allocations or system calls beyond their reads and writes.
+ *
+ *      A client's first message is MESSAGE_PLAY to start a game or MESSAGE_WATCH to spectate one, and the server
+ *      answers with MESSAGE_WELCOME holding the game's id. Players then send MESSAGE_INPUT messages, which are handed
+ *      to their game as key events and take effect on the next tick. After every tick each player is sent one
+ *      keyframe or delta (see StateEncoder). A player that can't keep up has its deltas dropped rather than buffered
+ *      without limit, and gets a keyframe once it catches up.
+ *
+ *      Spectators of a game all get the same stream, encoded once per tick on a separate encoder thread. Workers only
+ *      copy a watched game's state into a snapshot, and the encoder turns it into a message while the next tick is
+ *      stepped, so spectators see the game one tick behind its player. The stream has a keyframe every
+ *      SPECTATOR_KEYFRAME_INTERVAL ticks, and right after someone starts watching. A spectator that falls behind
+ *      skips ahead to the next keyframe.
+ *
+ *      Linux only, so it is built into its own executable along with LoadTester (see server.cpp).
+ */
+class GameServer {
+public:
+    /**
+     * \brief Parametrized constructor for a server
+     *
+     * \param seed          Seed for the first session's game. Each session after it gets the next seed.
+     *        numThreads    How many threads step the games, 0 for one per hardware thread
+     */
+    GameServer(unsigned int seed, unsigned int numThreads = 0);
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * \brief Closes every connection and listening socket
+     */
+    ~GameServer();
+
+    /**
+     * \brief Starts accepting clients on an address (see Socket for the format). Can be called more than once.
+     *
+     * \return false if the address couldn't be listened on
+     */
+    bool listen(const std::string& address);
+
+    /**
+     * \brief Serves clients until the process gets SIGINT or SIGTERM
+     *
+     * \return false if the event loop couldn't be set up
+     */
+    bool run();
+
+    /**
+     * \brief Writes how many sessions were served, how long ticks took and how much was sent
+     */
+    void writeSummary(std::ostream& out) const;
+
+private:
+    struct Session;
+
+    /**
+     * \struct Connection
+     * \brief One client's socket and buffers
+     */
+    struct Connection {
+        Connection(int fd);
+
+        int fd;
+        unsigned long index;                ///< The connection's index in connections_
+        Session* session;                   ///< The game played or watched, nullptr until the client says which
+        bool spectator;
+        unsigned long spectatorIndex;       ///< A spectator's index in its session's spectators
+        bool waitingForKeyframe;            ///< Spectators skip deltas until the next keyframe
+        std::vector<uint8_t> input;         ///< Received bytes that don't make up a whole message yet
+        std::vector<uint8_t> output;        ///< Encoded messages waiting to be sent
+        unsigned long outputSent;           ///< How much of output has been sent already
+        bool waitingToWrite;                ///< True while the socket is full and epoll is watching for room
+    };
+
+    /**
+     * \struct SpectatorStream
+     * \brief The stream of messages shared by everyone watching a game
+     */
+    struct SpectatorStream {
+        SpectatorStream();
+
+        GameState snapshots[2];             ///< A worker fills one on each tick while the encoder reads the other
+        StateEncoder encoder;               ///< Only used by the encoder thread
+        std::vector<uint8_t> message;       ///< The last encoded message, sent to every spectator
+        unsigned long ticksSinceKeyframe;   ///< Only used by the encoder thread
+        bool keyframeRequested;             ///< Set by the event loop when a spectator needs a keyframe
+        bool forceKeyframe;                 ///< keyframeRequested as handed to the encoder thread
+    };
+
+    /**
+     * \struct Session
+     * \brief One game, its player and its spectators
+     */
+    struct Session {
+        Session(unsigned long id, unsigned int seed);
+
+        unsigned long id;
+        unsigned long index;                ///< The session's index in sessions_
+        Connection* player;
+        GraphicsRunner game;
+        GameState snapshot;                 ///< Reused every tick to hand the game's state to the encoder
+        StateEncoder encoder;
+        std::vector<Connection*> spectators;
+        SpectatorStream* stream;            ///< Only exists while the session has spectators
+    };
+
+    void accept(int listener);
+
+    /**
+     * \brief Reads everything available from a connection and handles each complete message
+     *
+     * \return false if the connection should be closed
+     */
+    bool read(Connection& connection);
+
+    /**
+     * \brief Handles a client's first message, which says whether it plays or watches
+     *
+     * \return false if the message wasn't a valid first message
+     */
+    bool join(Connection& connection, MessageType type, MessageReader& payload);
+
+    /**
+     * \brief Sends as much of a connection's output as the socket takes
+     *
+     * \return false if the connection should be closed
+     */
+    bool write(Connection& connection);
+
+    /**
+     * \brief Steps every game numTicks times on the worker threads, then sends each one's encoded state
+     */
+    void tick(unsigned long numTicks);
+
+    /**
+     * \brief Steps and encodes every session whose index is worker plus a multiple of the number of threads
+     */
+    void stepSessions(unsigned int worker, unsigned long numTicks);
+
+    /**
+     * \brief The body of the encoder thread. Waits for snapshots, encodes each spectator stream, and repeats.
+     */
+    void encodeSpectatorStreams();
+
+    /**
+     * \brief Waits until the encoder thread has finished its current snapshots
+     */
+    void waitForEncoder();
+
+    /**
+     * \brief Appends each spectator stream's last message to its spectators' output
+     */
+    void sendSpectatorStreams();
+
+    /**
+     * \brief Closes a connection. Closing a player also closes its session and everyone watching it.
+     */
+    void close(Connection& connection);
+
+    /**
+     * \brief Removes a spectator from the session it watches, removing the session's stream if it was the last
+     */
+    void stopWatching(Connection& spectator);
+
+    /**
+     * \brief Changes which events epoll reports for a connection
+     */
+    void watch(Connection& connection, bool forWriting);
+
+    int epoll_;
+    int timer_;
+    int signals_;
+    std::vector<int> listeners_;
+    std::vector<Connection*> connections_;              ///< Every open connection, in no particular order
+    std::vector<Connection*> connectionsByFd_;          ///< Indexed by socket, so an epoll event finds its connection
+    std::vector<Session*> sessions_;                    ///< Every session, in no particular order
+    std::unordered_map<unsigned long, Session*> sessionsById_;
+    std::vector<int> failed_;                           ///< Sockets to close once a tick has finished sending
+    unsigned long nextSessionId_;
+    unsigned int nextSeed_;
+
+    WorkerPool workers_;                    ///< Step the games each tick. The event loop's thread is worker 0.
+    unsigned int snapshotIndex_;            ///< Which of each stream's snapshots the workers fill this tick
+
+    // Encoder thread
+    std::thread encoder_;
+    bool stopping_;
+    std::mutex encodeMutex_;
+    std::condition_variable encodeStarted_;
+    std::condition_variable encodeFinished_;
+    std::vector<SpectatorStream*> streamsToEncode_;
+    unsigned int encodeSnapshotIndex_;
+    bool encoding_;                         ///< True from when snapshots are handed over until they are encoded
+
+    // Statistics
+    unsigned long numTicks_;
+    unsigned long numLateTicks_;            ///< Ticks that were stepped late because the loop fell behind
+    unsigned long numSessionsServed_;
+    unsigned long peakSessions_;
+    unsigned long numSpectatorsServed_;
+    unsigned long peakSpectators_;
+    unsigned long numSpectators_;
+    unsigned long bytesReceived_;
+    unsigned long bytesSent_;
+    unsigned long bytesSentToSpectators_;   ///< Bytes queued for spectators, including ones not yet sent
+    std::atomic<unsigned long> numDroppedMessages_;     ///< Messages not sent because a client's output was full
+    double tickSeconds_;                    ///< Total time spent stepping and encoding
+    double maxTickSeconds_;
+};
+
+const unsigned long MAX_CATCH_UP_TICKS = 5;             ///< Ticks missed beyond this many are skipped, not stepped
+
+const unsigned long MAX_PENDING_OUTPUT = 64 * 1024;     ///< Bytes a client may have waiting to send
+
+const unsigned long MAX_PENDING_INPUT = 4 * 1024;       ///< Bytes a client may send without finishing a message
+
+const unsigned long SPECTATOR_KEYFRAME_INTERVAL = 2 * FRAME_RATE;   ///< Ticks between keyframes for spectators
+
+#endif //BRICKBREAKER_GAMESERVER_H
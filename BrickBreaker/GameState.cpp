@@ -0,0 +1,198 @@
+/**
+ * \file GameState.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements writing, reading and comparing game state snapshots
+ */
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include "GameState.h"
+
+using namespace std;
+
+void GameState::write(ostream& out) const {
+    // Enough digits that every float and double reads back as exactly the same value
+    streamsize oldPrecision = out.precision(numeric_limits<double>::max_digits10);
+
+    // Characters are written as numbers since status and special can be '\0'
+    out << "state " << tick << ' ' << level << ' ' << int(status) << ' ' << timerStart << ' ' << timerLength << ' '
+        << pauseStart << ' ' << secondsPaused << ' ' << numSafetyBricks << ' ' << numBricks << '\n';
+
+    out << "random " << random << '\n';
+
+    out << "paddle " << paddle.x << ' ' << paddle.y << ' ' << paddle.rotation << ' ' << paddle.width << ' '
+        << paddle.vel << ' ' << paddle.accel << ' ' << paddle.timer << '\n';
+
+    out << "bricks " << bricks.size() << '\n';
+    for (const BrickState& brick : bricks) {
+        out << brick.x << ' ' << brick.y << ' ' << brick.width << ' ' << brick.height << ' ' << int(brick.special)
+            << ' ' << brick.deleted;
+
+        // Bricks that take several hits carry how many they have left
+        if (brick.special == 'h' || brick.special == 'r')
+            out << ' ' << int(brick.hitPoints);
+
+        // Scripted bricks carry their script's state on the end of the line
+        if (brick.special == 'x') {
+            out << ' ' << int(brick.script) << ' ' << brick.hits << ' ' << int(brick.shade);
+            for (int16_t value : brick.registers)
+                out << ' ' << value;
+        }
+        out << '\n';
+    }
+
+    out << "balls " << nextBallId << ' ' << balls.size() << '\n';
+    for (const BallState& ball : balls) {
+        out << ball.x << ' ' << ball.y << ' ' << ball.xVel << ' ' << ball.yVel << ' ' << ball.attached << ' '
+            << ball.id << ' ' << ball.deleted << ' ' << ball.radius << ' ' << ball.resizeTimer << '\n';
+    }
+
+    out << "powerups " << dropPowerUps << ' ' << powerUps.size() << '\n';
+    for (const PowerUpState& powerUp : powerUps) {
+        out << powerUp.x << ' ' << powerUp.y << ' ' << int(powerUp.type) << '\n';
+    }
+
+    out << "lasers " << laserTimer << ' ' << lasers.size() << '\n';
+    for (const LaserState& laser : lasers) {
+        out << laser.x << ' ' << laser.y << '\n';
+    }
+
+    out.precision(oldPrecision);
+}
+
+bool GameState::read(istream& in) {
+    string label;
+    int statusValue;
+    unsigned long count;
+
+    // Each section starts with a label, if any label is wrong the file isn't a valid state
+    if (!(in >> label) || label != "state")
+        return false;
+    in >> tick >> level >> statusValue >> timerStart >> timerLength >> pauseStart >> secondsPaused
+       >> numSafetyBricks >> numBricks;
+    status = char(statusValue);
+
+    if (!(in >> label) || label != "random")
+        return false;
+    in >> ws >> random;    // The engine's extractor doesn't skip whitespace itself
+
+    if (!(in >> label) || label != "paddle")
+        return false;
+    in >> paddle.x >> paddle.y >> paddle.rotation >> paddle.width >> paddle.vel >> paddle.accel >> paddle.timer;
+
+    if (!(in >> label >> count) || label != "bricks")
+        return false;
+    bricks.resize(count);
+    for (BrickState& brick : bricks) {
+        int special;
+        in >> brick.x >> brick.y >> brick.width >> brick.height >> special >> brick.deleted;
+        brick.special = char(special);
+
+        int hitPoints = 0;
+        if (brick.special == 'h' || brick.special == 'r')
+            in >> hitPoints;
+        brick.hitPoints = uint8_t(hitPoints);
+
+        int script = -1;
+        int shade = 0;
+        brick.hits = 0;
+        fill(brick.registers, brick.registers + BRICK_SCRIPT_REGISTERS, 0);
+        if (brick.special == 'x') {
+            in >> script >> brick.hits >> shade;
+            for (int16_t& value : brick.registers)
+                in >> value;
+        }
+        brick.script = int8_t(script);
+        brick.shade = uint8_t(shade);
+    }
+
+    if (!(in >> label >> nextBallId >> count) || label != "balls")
+        return false;
+    balls.resize(count);
+    for (BallState& ball : balls) {
+        in >> ball.x >> ball.y >> ball.xVel >> ball.yVel >> ball.attached >> ball.id >> ball.deleted >> ball.radius
+           >> ball.resizeTimer;
+    }
+
+    if (!(in >> label >> dropPowerUps >> count) || label != "powerups")
+        return false;
+    powerUps.resize(count);
+    for (PowerUpState& powerUp : powerUps) {
+        int type;
+        in >> powerUp.x >> powerUp.y >> type;
+        powerUp.type = char(type);
+    }
+
+    if (!(in >> label >> laserTimer >> count) || label != "lasers")
+        return false;
+    lasers.resize(count);
+    for (LaserState& laser : lasers) {
+        in >> laser.x >> laser.y;
+    }
+
+    return bool(in);
+}
+
+unsigned long GameState::getHeapBytes() const {
+    return bricks.capacity() * sizeof(BrickState) + balls.capacity() * sizeof(BallState)
+           + powerUps.capacity() * sizeof(PowerUpState) + lasers.capacity() * sizeof(LaserState);
+}
+
+bool GameState::operator==(const GameState& other) const {
+    // Compare the simple values first
+    if (tick != other.tick || level != other.level || status != other.status || timerStart != other.timerStart
+        || timerLength != other.timerLength || pauseStart != other.pauseStart
+        || secondsPaused != other.secondsPaused || numSafetyBricks != other.numSafetyBricks
+        || numBricks != other.numBricks || random != other.random) {
+        return false;
+    }
+
+    if (paddle.x != other.paddle.x || paddle.y != other.paddle.y || paddle.rotation != other.paddle.rotation
+        || paddle.width != other.paddle.width || paddle.vel != other.paddle.vel || paddle.accel != other.paddle.accel
+        || paddle.timer != other.paddle.timer) {
+        return false;
+    }
+
+    // Then every brick, ball, power-up and laser shot
+    if (bricks.size() != other.bricks.size() || balls.size() != other.balls.size() || nextBallId != other.nextBallId
+        || dropPowerUps != other.dropPowerUps || powerUps.size() != other.powerUps.size()
+        || laserTimer != other.laserTimer || lasers.size() != other.lasers.size())
+        return false;
+
+    for (unsigned long i = 0; i < bricks.size(); ++i) {
+        const BrickState& a = bricks[i];
+        const BrickState& b = other.bricks[i];
+        if (a.x != b.x || a.y != b.y || a.width != b.width || a.height != b.height || a.special != b.special
+            || a.deleted != b.deleted || a.hitPoints != b.hitPoints || a.script != b.script || a.hits != b.hits || a.shade != b.shade
+            || !equal(a.registers, a.registers + BRICK_SCRIPT_REGISTERS, b.registers)) {
+            return false;
+        }
+    }
+
+    for (unsigned long i = 0; i < balls.size(); ++i) {
+        const BallState& a = balls[i];
+        const BallState& b = other.balls[i];
+        if (a.x != b.x || a.y != b.y || a.xVel != b.xVel || a.yVel != b.yVel || a.attached != b.attached
+            || a.id != b.id || a.deleted != b.deleted || a.radius != b.radius || a.resizeTimer != b.resizeTimer) {
+            return false;
+        }
+    }
+
+    for (unsigned long i = 0; i < powerUps.size(); ++i) {
+        const PowerUpState& a = powerUps[i];
+        const PowerUpState& b = other.powerUps[i];
+        if (a.x != b.x || a.y != b.y || a.type != b.type)
+            return false;
+    }
+
+    for (unsigned long i = 0; i < lasers.size(); ++i) {
+        if (lasers[i].x != other.lasers[i].x || lasers[i].y != other.lasers[i].y)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,116 @@
+/**
+ * \file GameState.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a plain copy of everything needed to resume a game from a given tick
+ */
+
+#ifndef BRICKBREAKER_GAMESTATE_H
+#define BRICKBREAKER_GAMESTATE_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <vector>
+#include "BrickScript.h"
+
+/**
+ * \struct GameState
+ * \brief A snapshot of a game's simulation state
+ *
+ * \details Holds only plain values so a snapshot can be copied, compared and written to file cheaply. Text on screen
+ *      and high scores are not part of the simulation and are not stored. Nothing in it is formatted or parsed until it
+ *      is written, so saving and restoring are cheap enough to do every tick. Floats are written with enough digits to be
+ *      read back exactly, so restoring a snapshot and replaying the same input reproduces the game tick for tick.
+ */
+struct GameState {
+    struct PaddleState {
+        float x, y;             ///< Position of the top center of the paddle
+        float rotation;         ///< In degrees
+        float width;            ///< Width of the rectangular part of the paddle
+        float vel;
+        float accel;
+        double timer;           ///< Game time at which the paddle elongation ends
+    };
+
+    struct BrickState {
+        float x, y;             ///< Position of the top left of the brick
+        float width, height;
+        char special;
+        bool deleted;           ///< Marked for deletion on the next tick
+        uint8_t hitPoints;      ///< Hits left for hard and reinforced bricks ('h' and 'r'), 0 for any other brick
+
+        // Only used by scripted bricks (special 'x'), and only written for them
+        int8_t script;
+        int16_t hits;
+        int16_t registers[BRICK_SCRIPT_REGISTERS];
+        uint8_t shade;
+    };
+
+    struct BallState {
+        float x, y;             ///< Position of the center of the ball
+        float xVel, yVel;
+        bool attached;
+        uint32_t id;            ///< Given by the game when the ball was created (see Ball::getId())
+        float radius;
+        double resizeTimer;     ///< Game time at which a big or tiny ball returns to normal
+        bool deleted;
+    };
+
+    struct PowerUpState {
+        float x, y;             ///< Position of the center of the capsule
+        char type;              ///< The special brick it fell from
+    };
+
+    struct LaserState {
+        float x, y;             ///< Position of the top of the shot
+    };
+
+    unsigned long tick;         ///< The tick this state is the start of
+    int level;
+    char status;
+    double timerStart;
+    float timerLength;
+    double pauseStart;
+    double secondsPaused;
+    int numSafetyBricks;
+    int numBricks;
+    std::minstd_rand random;    ///< A copy of the random number generator, which is just one integer of state
+
+    PaddleState paddle;
+    std::vector<BrickState> bricks;     ///< Safety bricks first, then regular bricks, in the game's object order
+    std::vector<BallState> balls;
+    uint32_t nextBallId;                ///< The id the game gives the next ball it creates
+    bool dropPowerUps;                  ///< Whether special bricks drop capsules rather than applying straight away
+    std::vector<PowerUpState> powerUps; ///< The capsules falling, see PowerUps
+    double laserTimer;                  ///< Game time at which the paddle's lasers run out
+    std::vector<LaserState> lasers;     ///< The shots flying, see Lasers
+
+    /**
+     * \brief Writes the state as whitespace separated text
+     */
+    void write(std::ostream& out) const;
+
+    /**
+     * \brief Reads a state previously written by write()
+     *
+     * \return true if a complete state was read, false otherwise
+     */
+    bool read(std::istream& in);
+
+    /**
+     * \brief Returns the number of bytes the snapshot holds on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+    /**
+     * \brief Returns true if both states hold exactly the same values
+     */
+    bool operator==(const GameState& other) const;
+};
+
+#endif //BRICKBREAKER_GAMESTATE_H
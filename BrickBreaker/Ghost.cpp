@@ -0,0 +1,114 @@
+/**
+ * \file Ghost.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a replay of the best run through a level, raced alongside the live game
+ */
+#include <fstream>
+#include <sys/stat.h>
+#include "Ghost.h"
+
+using namespace sf;
+using namespace std;
+
+Ghost::Ghost()
+        : game_(0u),
+          next_(0),
+          racing_(false),
+          renderer_(nullptr)
+{
+    renderer_.setAlpha(GHOST_ALPHA);
+}
+
+bool Ghost::save(int level, const GameState& start, const vector<InputEvent>& events, double score) {
+    mkdir("BrickBreakerData/ghosts", ACCESSPERMS);
+    ofstream file(getPath(level));
+    if (!file.is_open())
+        return false;
+
+    file << "# Best run through level " << level << ": " << score << " seconds\n";
+    file << "keyframe\n";
+    start.write(file);
+    InputRecorder::write(file, events);
+    return bool(file);
+}
+
+bool Ghost::start(int level) {
+    racing_ = false;
+
+    ifstream file(getPath(level));
+    if (!file.is_open())
+        return false;
+
+    // Skip the comment at the top of the file
+    while (file.peek() == '#') {
+        string comment;
+        getline(file, comment);
+    }
+
+    GameState startState;
+    string label;
+    if (!(file >> label) || label != "keyframe" || !startState.read(file) || !InputRecorder::read(file, events_))
+        return false;
+
+    game_.restoreState(startState);
+    next_ = 0;
+    racing_ = true;
+
+    game_.saveMovingState(state_);
+    renderer_.updateMoving(state_);
+    return true;
+}
+
+void Ghost::step() {
+    if (!racing_)
+        return;
+
+    // Keep stepping until a tick in which things moved, so paused ticks don't count against the ghost
+    do {
+        while (next_ < events_.size() && events_[next_].tick <= game_.getTick()) {
+            game_.processKey(events_[next_].type, events_[next_].key);
+            ++next_;
+        }
+        game_.step();
+
+        // A run that ended paused would never unpause
+        if (game_.getStatus() == 'p' && next_ == events_.size()) {
+            racing_ = false;
+            return;
+        }
+    } while (game_.getStatus() == 'p');
+
+    // The ghost is done once its level is over either way
+    if (game_.getStatus() != '\0') {
+        racing_ = false;
+        return;
+    }
+
+    game_.saveMovingState(state_);
+    renderer_.updateMoving(state_);
+}
+
+void Ghost::draw(RenderWindow& window) const {
+    if (racing_)
+        renderer_.drawMoving(window);
+}
+
+bool Ghost::isRacing() const {
+    return racing_;
+}
+
+void Ghost::getMemoryUsage(MemoryReport& report) const {
+    MemoryReport gameReport;
+    game_.getMemoryUsage(gameReport);
+
+    report.add("ghost", 1, sizeof(Ghost) - sizeof(GraphicsRunner) + gameReport.getTotalBytes()
+                           + events_.capacity() * sizeof(InputEvent) + state_.getHeapBytes());
+}
+
+string Ghost::getPath(int level) {
+    return "BrickBreakerData/ghosts/" + to_string(level) + ".txt";
+}
@@ -0,0 +1,97 @@
+/**
+ * \file Ghost.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a replay of the best run through a level, raced alongside the live game
+ */
+
+#ifndef BRICKBREAKER_GHOST_H
+#define BRICKBREAKER_GHOST_H
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "GameState.h"
+#include "GraphicsRunner.h"
+#include "InputRecorder.h"
+#include "MemoryReport.h"
+#include "StateRenderer.h"
+
+/**
+ * \class Ghost
+ * \brief Re-simulates the best recorded run through a level in lockstep with the live game
+ *
+ * \details A best run is the snapshot taken when its level started plus every input event handled during the level,
+ *      written whenever a level's high score is beaten (see save()). The ghost restores that snapshot into a headless
+ *      game and feeds it the recorded input on the ticks it was handled on, so it plays out exactly as the run did.
+ *
+ *      The ghost is stepped once for every tick the live game moves, so the two race in the same time. Ticks the
+ *      recorded run spent paused are skipped straight through, since nothing moves in them. Only the ghost's paddle
+ *      and balls are drawn, translucently and in a single draw call. Its bricks are simulated (balls have to bounce
+ *      off them) but never drawn, and copying its state only touches the paddle and balls.
+ */
+class Ghost {
+public:
+    Ghost();
+
+    /**
+     * \brief Writes a level's best run to BrickBreakerData/ghosts
+     *
+     * \param level     The level the run was through
+     *        start     Snapshot of the game when the level started
+     *        events    Every input event handled since the snapshot
+     *        score     The run's time in seconds, written as a comment
+     *
+     * \return true if the file was written, false otherwise
+     */
+    static bool save(int level, const GameState& start, const std::vector<InputEvent>& events, double score);
+
+    /**
+     * \brief Loads a level's best run and starts racing it. Stops racing if the level has no best run yet.
+     *
+     * \return true if a run was loaded, false otherwise
+     */
+    bool start(int level);
+
+    /**
+     * \brief Advances the ghost by one tick of movement, skipping any ticks the recorded run spent paused
+     *
+     * \details Racing stops once the ghost's level is cleared or lost, or if it runs out of input while paused
+     */
+    void step();
+
+    /**
+     * \brief Draws the ghost's paddle and balls, if it is racing
+     */
+    void draw(sf::RenderWindow& window) const;
+
+    /**
+     * \brief Returns true while there is a run being raced
+     */
+    bool isRacing() const;
+
+    /**
+     * \brief Adds the ghost's memory, including its game's, to a report as one entry
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+private:
+    /**
+     * \brief Returns the path of a level's best run
+     */
+    static std::string getPath(int level);
+
+    GraphicsRunner game_;               ///< Headless, restored from the recorded run's starting snapshot
+    std::vector<InputEvent> events_;    ///< The recorded run's input
+    unsigned long next_;                ///< Index in events_ of the next event to feed to the game
+    bool racing_;
+    GameState state_;                   ///< Only the paddle and balls are kept up to date
+    StateRenderer renderer_;
+};
+
+const sf::Uint8 GHOST_ALPHA = 90;   ///< Opacity of the ghost's paddle and balls
+
+#endif //BRICKBREAKER_GHOST_H
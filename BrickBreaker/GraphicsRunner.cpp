@@ -7,29 +7,67 @@
  *
  * \brief Implements the graphics runner class
  */
+#include <algorithm>
 #include <iostream>
+#include <sys/stat.h>
 #include "GraphicsRunner.h"
 #include "Barrier.h"
+#include "Ghost.h"
+#include "ParticleSystem.h"
 #include "Paddle.h"
 
 using namespace sf;
 using namespace std;
 
 GraphicsRunner::GraphicsRunner(RenderWindow& window)
+        : GraphicsRunner(&window, window.getSize(), (unsigned int)time(0))
+{
+}
+
+GraphicsRunner::GraphicsRunner(unsigned int seed)
+        : GraphicsRunner(nullptr, Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT), seed)
+{
+}
+
+GraphicsRunner::GraphicsRunner(RenderWindow* window, Vector2u windowSize, unsigned int seed)
         : window_(window),
-          windowSize_(window.getSize()),
+          windowSize_(windowSize),
+          random_(seed),
+          nextBallId_(0),
           builder_(objects_,
-                   Vector2f(window.getSize().x - 2 * BARRIER_BUFFER - 2 * BARRIER_WIDTH,
-                            window.getSize().y - BANNER_HEIGHT - BARRIER_BUFFER - BARRIER_WIDTH),
+                   random_,
+                   Vector2f(windowSize.x - 2 * BARRIER_BUFFER - 2 * BARRIER_WIDTH,
+                            windowSize.y - BANNER_HEIGHT - BARRIER_BUFFER - BARRIER_WIDTH),
                    Vector2f(BARRIER_BUFFER + BARRIER_WIDTH, BANNER_HEIGHT + BARRIER_BUFFER + BARRIER_WIDTH),
                    BRICK_HEIGHT,
                    BRICK_SEPARATION),
           status_('\0'),
           timerLength_(0),
-          level_(0) // nextLevel() increments this before loading the level (so 0 -> start at level 1)
+          level_(0), // nextLevel() increments this before loading the level (so 0 -> start at level 1)
+          // The overlay sits in the gaps of the banner, text between the level and title, graph between title and timer
+          hud_(font_,
+               Vector2f(windowSize.x * .12f, 0),
+               FloatRect(windowSize.x * .65f, BARRIER_BUFFER,
+                         windowSize.x * .2f, BANNER_HEIGHT - BARRIER_BUFFER)),
+          tick_(0),
+          specialsCleared_(0),
+          lastCaptureTime_(0),    // Nothing is captured while the game warms up
+          replaying_(false),
+          replayMode_(false),
+          replayIndex_(0),
+          levelStarting_(false),
+          levelStart_(),      // Level 0 until the first level starts, so no run is saved without a start
+          ghost_(nullptr),
+          timeScale_(1),
+          tickBudget_(0),
+          scripts_(nullptr),
+          particles_(window != nullptr ? new ParticleSystem() : nullptr),
+          showTrails_(true),
+          dropPowerUps_(false),
+          numScriptEvents_(0)
 {
-    float windowWidth = window_.getSize().x;
-    float windowHeight = window_.getSize().y;
+    float windowWidth = windowSize_.x;
+    float windowHeight = windowSize_.y;
 
     // Add objects. If more objects are added/order is changed, make sure to update getters appropriately
     // Also, the first object cannot not be deletable
@@ -40,16 +78,19 @@ GraphicsRunner::GraphicsRunner(RenderWindow& window)
     // Record the index of the first safety brick
     indexOfFirstSafetyBrick_ = int(objects_.size());
 
-    // Load the font and base text objects
-    loadFont();
+    // Load the font and base text objects. Headless games never draw text so they don't need the font.
+    if (window_ != nullptr)
+        loadFont();
     addText("Level 0", DEFAULT_COLOR, (unsigned int)(BANNER_HEIGHT-2*BARRIER_BUFFER), false, 'l');
     addText("Brick Breaker", Color(25,200,229), (unsigned int)(BANNER_HEIGHT-2*BARRIER_BUFFER), false, 'm');
     addText("00:00", DEFAULT_COLOR, (unsigned int)(BANNER_HEIGHT-2*BARRIER_BUFFER), false, 'r');
 
     baseNumTextObjects_ = text_.size();
 
-    // Populate the scores_ data member with high score data from file
-    loadHighScores();
+    // Populate the scores_ data member with high score data from file. Headless games don't touch the high score file
+    // since many of them can run at once.
+    if (window_ != nullptr)
+        loadHighScores();
 
     // Load the first level, no need to clear the stage first
     nextLevel(false);
@@ -59,106 +100,451 @@ GraphicsRunner::GraphicsRunner(RenderWindow& window)
     addText("Brick Breaker", Color(25,200,229), 54);
     addText("by gustebeast", DEFAULT_COLOR, 34, false);
     addText("Use J/L to move, A/D to rotate, and space to release a ball", DEFAULT_COLOR, 34, false);
+
+    // Start keeping snapshots for slow frame captures
+    saveState(keyframe_);
+    previousKeyframe_ = keyframe_;
 }
 
 GraphicsRunner::~GraphicsRunner() {
-    // Write high score data to file
-    writeHighScores();
+    // Write high score data to file, unless the scores came from replaying someone else's input or a headless game
+    if (window_ != nullptr && !replayMode_)
+        writeHighScores();
 
     // And delete all the game's objects
     for (Object* object : objects_)
         delete object;
+
+    delete ghost_;
+    delete particles_;
 }
 
 void GraphicsRunner::update() {
-    // Clear the graphics window with a slight gray background
-    window_.clear(BACKGROUND_COLOR);
-
-    // Move and draw all objects while removing ones that need deletion
-    for (auto i = objects_.begin(); i != objects_.end(); ++i) {
-        Object* object = *i;
-
-        // If the object needs to be deleted
-        if (object->delete_) {
-            // First check to see this object is a brick
-            if (Brick* brick = dynamic_cast<Brick*>(object)) {
-                // And if it is, apply any special properties the brick might have. This function also decrements either
-                // numBricks_ or numSpecialBricks_ depending on the brick's type
-                handleSpecialBrick(brick);
+    profiler_.beginFrame();
+
+    // Run however many ticks the time scale owes this frame. In slow motion that is often none, in fast forward
+    // several, each one exactly the tick step() runs.
+    tickBudget_ += timeScale_;
+    unsigned int numTicks = (unsigned int)tickBudget_;
+    tickBudget_ -= numTicks;
+
+    for (unsigned int i = 0; i < numTicks; ++i) {
+        profiler_.beginPhase(Profiler::SIMULATION);
+        removeDeletedObjects();
+        rememberPositions();
+        simulate();
+        profiler_.endPhase(Profiler::SIMULATION);
+
+        finishTick();
+
+        // Balls leave particles behind them while they move, unless trails are turned off
+        if (status_ == '\0' && showTrails_) {
+            for (long j = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; j < long(objects_.size()); ++j) {
+                Ball* ball = dynamic_cast<Ball*>(objects_[j]);
+                if (!ball->isAttached())
+                    particles_->emitTrail(ball->getPosition(), ball->getVelocity(), ball->getRadius());
             }
+        }
+    }
+
+    // The timer only needs setting once however many ticks ran
+    if (status_ == '\0')
+        updateTimerText();
+
+    profiler_.beginPhase(Profiler::RENDER);
 
-            // Free the memory
-            delete object;
+    // Particles keep to the game's speed, and stop while it's paused
+    profiler_.beginPhase(Profiler::PARTICLES);
+    particles_->update(status_ == 'p' ? 0 : timeScale_);
+    profiler_.endPhase(Profiler::PARTICLES);
 
-            // Erase the object from the containing vector. The iterator now points at the next object.
-            i = objects_.erase(i);
+    // Draw the moving objects between where they started and ended the last tick. At normal speed the budget is
+    // always used up, so they are drawn as they were before the tick moved them, just as when drawing came first.
+    drawObjects(tickBudget_);
+    profiler_.endPhase(Profiler::RENDER);
 
-            // Decrement the iterator since it will be incremented in the for loop.
-            // Note! If i == objects_.begin() then this will cause undefined behavior. The first object should never
-            // be deleted!
-            --i;
+    profiler_.endFrame();
+
+    // Capture frames that went over budget, but not so often that writing captures causes more slow frames
+    if (!replaying_ && profiler_.getFrameTime() > SLOW_FRAME_TIME
+        && getGameTime() - lastCaptureTime_ > SLOW_FRAME_COOLDOWN) {
+        captureSlowFrame();
+    }
+
+    // The overlay is drawn after the frame is recorded so that it doesn't show up in its own statistics
+    if (hud_.visible_) {
+        hud_.update(profiler_);
+        hud_.draw(*window_);
+    }
+
+    // Finally display all the objects on the screen.
+    window_->display();
+}
+
+void GraphicsRunner::step() {
+    profiler_.beginFrame();
+
+    profiler_.beginPhase(Profiler::SIMULATION);
+    removeDeletedObjects();
+    simulate();
+    profiler_.endPhase(Profiler::SIMULATION);
+
+    profiler_.endFrame();
+    finishTick();
+}
+
+void GraphicsRunner::removeDeletedObjects() {
+    specialsCleared_ = 0;
+
+    // When replaying, handle the recorded input for this tick as though it came from the keyboard
+    while (replaying_ && replayIndex_ < replayEvents_.size() && replayEvents_[replayIndex_].tick == tick_) {
+        processKey(replayEvents_[replayIndex_].type, replayEvents_[replayIndex_].key);
+        ++replayIndex_;
+    }
+
+    // Remove objects that need deletion, moving the rest down over them in one pass so that clearing many bricks at
+    // once (see Explosions) doesn't shift the list once per brick. handleSpecialBrick() adds balls and looks through
+    // the ones there are, so the specials are only applied once the bricks are gone and the counts match the list.
+    removedBricks_.assign((unsigned long)(numSafetyBricks_ + numBricks_), false);
+    clearedSpecials_.clear();
+    bool bricksRemoved = false;
+    unsigned long kept = 0;
+    for (unsigned long i = 0; i < objects_.size(); ++i) {
+        Object* object = objects_[i];
+
+        // Objects that stay move down over the ones removed before them. The first object should never be deleted!
+        if (!object->delete_) {
+            objects_[kept++] = object;
             continue;
         }
 
-        // Move and draw
-        object->draw(window_);
-        if (status_ == '\0')
-            object->move();
+        // If this object is a brick, count it off and remember any special properties it has
+        if (Brick* brick = dynamic_cast<Brick*>(object)) {
+            if (brick->special_ == 's')
+                --numSafetyBricks_;
+            else
+                --numBricks_;
+
+            // Power-ups being dropped fall from the middle of the brick, unless there's no room left for them
+            FloatRect bounds = brick->getBounds();
+            bool dropped = dropPowerUps_ && PowerUps::isPowerUp(brick->special_)
+                           && powerUps_.drop(bounds.left + bounds.width / 2, bounds.top + bounds.height / 2,
+                                             brick->special_);
+            if (brick->special_ != '\0' && !dropped)
+                clearedSpecials_.push_back(brick->special_);
+
+            // Only windowed games show the brick breaking
+            unsigned long batchIndex = (unsigned long)(i - indexOfFirstSafetyBrick_);
+            if (particles_ != nullptr)
+                particles_->emitShatter(bounds, bricks_.getColor(batchIndex));
+            removedBricks_[batchIndex] = true;
+            bricksRemoved = true;
+        }
+
+        // Free the memory
+        delete object;
+    }
+    objects_.resize(kept);
+
+    if (bricksRemoved) {
+        bricks_.erase(removedBricks_);
+        grid_.invalidate();
+    }
+
+    for (char special : clearedSpecials_)
+        handleSpecialBrick(special);
+}
+
+void GraphicsRunner::drawObjects(float alpha) {
+    // Clear the graphics window with a slight gray background
+    window_->clear(BACKGROUND_COLOR);
+
+    // The ghost goes underneath everything else
+    if (ghost_ != nullptr && ghost_->isRacing()) {
+        ghost_->draw(*window_);
+        ++profiler_.drawCalls_;
+    }
+
+    // The paddle and barrier, then every brick in one go, then the balls
+    long firstBall = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_;
+    for (long i = 0; i < indexOfFirstSafetyBrick_; ++i) {
+        objects_[i]->drawInterpolated(*window_, alpha);
+        profiler_.drawCalls_ += objects_[i]->getNumDrawCalls();
+    }
+
+    bricks_.draw(*window_);
+    particles_->draw(*window_);
+    powerUps_.draw(*window_, alpha);
+    lasers_.draw(*window_, alpha);
+    profiler_.drawCalls_ += 2 + (powerUps_.getCount() > 0) + (lasers_.getCount() > 0);
+
+    // Every ball's trail in one go, underneath the balls. Each trail after the first repeats the last vertex before it
+    // and its own first one, so the triangles joining them have no area.
+    if (showTrails_) {
+        unsigned long maxVertices = (objects_.size() - firstBall) * BALL_TRAIL_VERTICES;
+        if (trailVertices_.size() < maxVertices)
+            trailVertices_.resize(maxVertices);
+
+        unsigned long numVertices = 0;
+        for (long i = firstBall; i < long(objects_.size()); ++i) {
+            unsigned long start = numVertices > 0 ? numVertices + 2 : 0;
+            unsigned int written = dynamic_cast<Ball*>(objects_[i])->writeTrail(&trailVertices_[start], alpha);
+            if (written == 0)
+                continue;
+
+            if (start > 0) {
+                trailVertices_[numVertices] = trailVertices_[numVertices - 1];
+                trailVertices_[numVertices + 1] = trailVertices_[start];
+            }
+            numVertices = start + written;
+        }
+
+        if (numVertices > 0) {
+            window_->draw(&trailVertices_[0], numVertices, TrianglesStrip);
+            ++profiler_.drawCalls_;
+        }
+    }
+
+    // Where an attached ball would go if it were released now. The path is only traced again when it changes.
+    if (status_ == '\0') {
+        for (long i = firstBall; i < long(objects_.size()); ++i) {
+            Ball* ball = dynamic_cast<Ball*>(objects_[i]);
+            if (ball->isAttached()) {
+                aim_.update(ball->getPosition(), ball->getLaunchVelocity(), ball->getRadius(),
+                            dynamic_cast<Barrier*>(getBarrier())->getInnerBounds(), getBrickGrid());
+                aim_.draw(*window_);
+                ++profiler_.drawCalls_;
+                break;
+            }
+        }
+    }
+
+    for (long i = firstBall; i < long(objects_.size()); ++i) {
+        objects_[i]->drawInterpolated(*window_, alpha);
+        profiler_.drawCalls_ += objects_[i]->getNumDrawCalls();
     }
 
     // Draw the game text
-    for (Text text : text_)
-        window_.draw(text);
+    for (const Text& text : text_)
+        window_->draw(text);
+    profiler_.drawCalls_ += text_.size();
+}
 
-    // Update the level timer if the game isn't paused
-    if (status_ == '\0')
-        text_[2].setString(getTimeStringFromSeconds(difftime(time(0), timerStart_) - secondsPaused_));
+void GraphicsRunner::simulate() {
+    // Move all objects
+    profiler_.beginPhase(Profiler::COLLISION);
+    bool moved = status_ == '\0';
+    if (moved) {
+        // Balls bounce off each other first, all at once, then everything moves and collides with everything else
+        profiler_.collisionTests_ += ballContacts_.find(objects_, indexOfFirstSafetyBrick_ + numSafetyBricks_
+                                                                  + numBricks_);
+        ballContacts_.resolve();
+
+        for (Object* object : objects_)
+            object->move();
 
-    // Finally display all the objects on the screen.
-    window_.display();
+        // Falling power-ups move with everything else, and the paddle catches them with the same test balls use
+        if (powerUps_.getCount() > 0) {
+            unsigned int numCaught = powerUps_.update(dynamic_cast<Paddle*>(getPaddle())->getShape(),
+                                                      float(windowSize_.y), caughtPowerUps_);
+            for (unsigned int i = 0; i < numCaught; ++i)
+                handleSpecialBrick(caughtPowerUps_[i]);
+        }
+
+        // A paddle with lasers fires from both ends, and the shots hit whatever brick they were aimed at
+        if (getGameTime() < lasers_.getTimer() && tick_ % (unsigned long)(LASER_FIRE_INTERVAL * FRAME_RATE) == 0) {
+            Capsule shape = dynamic_cast<Paddle*>(getPaddle())->getShape();
+            lasers_.fire(shape.start.x, shape.start.y - shape.radius);
+            lasers_.fire(shape.end.x, shape.end.y - shape.radius);
+        }
+        if (lasers_.getCount() > 0) {
+            unsigned int numHits = lasers_.update(objects_, getBrickGrid(),
+                                                  dynamic_cast<Barrier*>(getBarrier())->getInnerBounds().top,
+                                                  laserHits_);
+            profiler_.collisionTests_ += lasers_.getNumCasts();
+            for (unsigned int i = 0; i < numHits; ++i)
+                hitBrick(laserHits_[i]);
+        }
+    }
+    profiler_.endPhase(Profiler::COLLISION);
+
+    // Then let the scripted bricks that were hit respond
+    if (numScriptEvents_ > 0) {
+        profiler_.beginPhase(Profiler::SCRIPTS);
+        runBrickScripts();
+        profiler_.endPhase(Profiler::SCRIPTS);
+    }
+
+    // Explosive bricks destroyed by the balls or the scripts take out the bricks around them, all within the tick
+    if (explosions_.isPending())
+        explode();
+
+    // The ghost keeps pace with the game, moving only when it does
+    if (moved && ghost_ != nullptr) {
+        profiler_.beginPhase(Profiler::GHOST);
+        ghost_->step();
+        profiler_.endPhase(Profiler::GHOST);
+    }
 
     // And check the status of the game for the next frame
     checkStatus();
+
+    // Record how much is on the stage for the profiler
+    profiler_.numBricks_ = (unsigned int)(numSafetyBricks_ + numBricks_);
+    profiler_.numBalls_ = (unsigned int)(objects_.size() - (indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_));
+}
+
+void GraphicsRunner::finishTick() {
+    // The next tick starts here, so snapshots taken from now on hold the state at the start of that tick
+    ++tick_;
+
+    if (replaying_) {
+        // Once the replay reaches the end of the capture, check that it reproduced the captured state
+        if (tick_ == replayEndState_.tick) {
+            GameState state;
+            saveState(state);
+            if (state == replayEndState_) {
+                cout << "Replay reproduced the captured state at tick " << tick_ << endl;
+            }
+            else {
+                cout << "Replay diverged from the captured state at tick " << tick_ << endl;
+            }
+
+            // Stop on the captured frame so it can be looked at
+            replaying_ = false;
+            togglePause();
+        }
+    }
+
+    // Headless games run as fast as they can, so they have no frame budget to go over
+    else if (window_ != nullptr) {
+        // Record the start of a level that was just loaded, in case it turns out to be the best run through it
+        if (levelStarting_) {
+            levelStarting_ = false;
+            saveState(levelStart_);
+            levelInputs_.clear();
+            if (ghost_ != nullptr)
+                ghost_->start(level_);
+        }
+
+        // Keep the last two keyframes so a capture always has at least KEYFRAME_INTERVAL seconds of history
+        if (tick_ % (unsigned long)(KEYFRAME_INTERVAL * FRAME_RATE) == 0) {
+            swap(previousKeyframe_, keyframe_);
+            saveState(keyframe_);
+        }
+    }
+}
+
+void GraphicsRunner::rememberPositions() {
+    dynamic_cast<Paddle*>(getPaddle())->rememberPosition();
+    for (long i = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; i < long(objects_.size()); ++i) {
+        dynamic_cast<Ball*>(objects_[i])->rememberPosition();
+    }
+}
+
+void GraphicsRunner::updateTimerText() {
+    string timer = getTimeStringFromSeconds(getGameTime() - timerStart_ - secondsPaused_);
+    if (timeScale_ != 1) {
+        char scale[16];
+        snprintf(scale, sizeof(scale), "\tx%g", timeScale_);
+        timer += scale;
+    }
+
+    // Keep the timer right justified as its length changes
+    text_[2].setString(timer);
+    text_[2].setPosition(windowSize_.x - BARRIER_BUFFER - text_[2].getGlobalBounds().width, BARRIER_BUFFER);
 }
 
 void GraphicsRunner::handleEvent(Event &event) {
-    if (event.type == Event::Closed)
-        window_.close();
+    if (event.type == Event::Closed && window_ != nullptr)
+        window_->close();
 
     // If a key is pressed or released and is unique (not the same event as the one just processed)
     if ((event.type == Event::KeyPressed || event.type == Event::KeyReleased) &&
         (event.type != lastEvent_.type || event.key.code != lastEvent_.key.code)) {
 
-        // Then see what key was pressed and execute the appropriate action
-        Keyboard::Key& key = event.key.code;
-
-        if (status_ == '\0' && (key == Keyboard::J || key == Keyboard::L || key == Keyboard::A || key == Keyboard::D)) {
-            // Move the paddle in the appropriate direction or rotate it
-            dynamic_cast<Paddle*>(getPaddle())->processKey(event.type, key);
+        // The overlay isn't part of the game, so it isn't recorded and still works during a replay
+        if (event.key.code == Keyboard::F3) {
+            if (event.type == Event::KeyPressed)
+                hud_.visible_ = !hud_.visible_;
         }
 
-        // For all other keys we only want key press events
-        else if (event.type != Event::KeyReleased) {
-
-            switch (key) {
-                case Keyboard::Space: releaseBall();
-                     break;
-
-                case Keyboard::Escape: togglePause();
-                     break;
+        // Neither are ball trails
+        else if (event.key.code == Keyboard::F5) {
+            if (event.type == Event::KeyPressed)
+                showTrails_ = !showTrails_;
+        }
 
-                case Keyboard::Return: start();
-                     break;
+        // Nor the memory report
+        else if (event.key.code == Keyboard::F4) {
+            if (event.type == Event::KeyPressed) {
+                MemoryReport report;
+                getMemoryUsage(report);
+                report.write(cout);
+            }
+        }
 
-                default: break;
+        // Nor is the time scale, since it doesn't change what happens on any tick. [ and ] step down and up through
+        // TIME_SCALES and \ goes back to normal speed.
+        else if (event.key.code == Keyboard::LBracket || event.key.code == Keyboard::RBracket
+                 || event.key.code == Keyboard::BackSlash) {
+            if (event.type == Event::KeyPressed) {
+                float scale = 1;
+                if (event.key.code == Keyboard::LBracket) {
+                    scale = TIME_SCALES[0];
+                    for (float timeScale : TIME_SCALES) {
+                        if (timeScale < timeScale_)
+                            scale = timeScale;
+                    }
+                }
+                else if (event.key.code == Keyboard::RBracket) {
+                    scale = TIME_SCALES[NUM_TIME_SCALES - 1];
+                    for (unsigned int i = NUM_TIME_SCALES; i-- > 0;) {
+                        if (TIME_SCALES[i] > timeScale_)
+                            scale = TIME_SCALES[i];
+                    }
+                }
+                setTimeScale(scale);
             }
         }
 
+        // While replaying, the game only takes recorded input
+        else if (!replaying_) {
+            inputRecorder_.record(tick_, event.type, event.key.code);
+            levelInputs_.push_back(InputEvent{tick_, event.type, event.key.code});
+            processKey(event.type, event.key.code);
+        }
+
         // And update the previous event since this new one is different
         lastEvent_ = event;
     }
 }
 
+void GraphicsRunner::processKey(Event::EventType type, Keyboard::Key key) {
+    // See what key was pressed and execute the appropriate action
+    if (status_ == '\0' && (key == Keyboard::J || key == Keyboard::L || key == Keyboard::A || key == Keyboard::D)) {
+        // Move the paddle in the appropriate direction or rotate it
+        dynamic_cast<Paddle*>(getPaddle())->processKey(type, key);
+    }
+
+    // For all other keys we only want key press events
+    else if (type != Event::KeyReleased) {
+
+        switch (key) {
+            case Keyboard::Space: releaseBall();
+                 break;
+
+            case Keyboard::Escape: togglePause();
+                 break;
+
+            case Keyboard::Return: start();
+                 break;
+
+            default: break;
+        }
+    }
+}
+
 void GraphicsRunner::releaseBall() {
     // If the game is paused, don't release a ball
     if (status_ != '\0')
@@ -169,7 +555,7 @@ void GraphicsRunner::releaseBall() {
         addText("");
 
     // Loop through all the game's balls
-    for (long i = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; i < objects_.size(); ++i) {
+    for (long i = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; i < long(objects_.size()); ++i) {
         Ball* ball = dynamic_cast<Ball*>(objects_[i]);
 
         // If the ball is attached, release it then break out (only release one ball at a time)
@@ -180,6 +566,334 @@ void GraphicsRunner::releaseBall() {
     }
 }
 
+char GraphicsRunner::getStatus() const {
+    return status_;
+}
+
+int GraphicsRunner::getLevel() const {
+    return level_;
+}
+
+unsigned long GraphicsRunner::getTick() const {
+    return tick_;
+}
+
+double GraphicsRunner::getGameTime() const {
+    return double(tick_) / FRAME_RATE;
+}
+
+void GraphicsRunner::setTimeScale(float scale) {
+    timeScale_ = max(TIME_SCALES[0], min(scale, TIME_SCALES[NUM_TIME_SCALES - 1]));
+
+    // Show the new speed right away, even while paused
+    if (window_ != nullptr)
+        updateTimerText();
+}
+
+float GraphicsRunner::getTimeScale() const {
+    return timeScale_;
+}
+
+unsigned int GraphicsRunner::getNumSpecialsCleared() const {
+    return specialsCleared_;
+}
+
+bool GraphicsRunner::addJunkRow() {
+    long firstBrick = indexOfFirstSafetyBrick_ + numSafetyBricks_;
+    long firstBall = firstBrick + numBricks_;
+
+    // Rows only make sense while a level is being played
+    if (status_ != '\0')
+        return false;
+
+    // Start below the lowest regular brick, or where level 1's first row is if there are none
+    float top = BANNER_HEIGHT + BARRIER_BUFFER + BARRIER_WIDTH + BRICK_SEPARATION
+                + NUM_EMPTY_ROWS * (BRICK_HEIGHT + BRICK_SEPARATION);
+    for (long i = firstBrick; i < firstBall; ++i) {
+        FloatRect bounds = dynamic_cast<Brick*>(objects_[i])->getBounds();
+        top = max(top, bounds.top + bounds.height + BRICK_SEPARATION);
+    }
+
+    if (top + BRICK_HEIGHT > dynamic_cast<Paddle*>(getPaddle())->getPos()->y - JUNK_ROW_CLEARANCE)
+        return false;
+
+    unsigned long oldSize = objects_.size();
+    builder_.addJunkRow(top, int(random_() % NUM_BRICKS_PER_LINE));
+
+    // Leave out bricks that would land on a ball, it would be stuck inside them
+    for (unsigned long i = oldSize; i < objects_.size(); ++i) {
+        FloatRect bounds = dynamic_cast<Brick*>(objects_[i])->getBounds();
+        for (long j = firstBall; j < long(oldSize); ++j) {
+            Ball* ball = dynamic_cast<Ball*>(objects_[j]);
+            const Vector2f& center = ball->getPosition();
+            float radius = ball->getRadius();
+            if (bounds.intersects(FloatRect(center.x - radius, center.y - radius, 2 * radius, 2 * radius))) {
+                delete objects_[i];
+                objects_.erase(objects_.begin() + i);
+                --i;
+                break;
+            }
+        }
+    }
+
+    // Balls come after the bricks, so move the new bricks in front of them
+    rotate(objects_.begin() + firstBall, objects_.begin() + oldSize, objects_.end());
+    numBricks_ += int(objects_.size() - oldSize);
+
+    for (long i = firstBall; i < indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; ++i)
+        bricks_.add(*dynamic_cast<Brick*>(objects_[i]));
+    grid_.invalidate();
+    return true;
+}
+
+void GraphicsRunner::saveState(GameState& state) const {
+    state.tick = tick_;
+    state.level = level_;
+    state.status = status_;
+    state.timerStart = timerStart_;
+    state.timerLength = timerLength_;
+    state.pauseStart = pauseStart_;
+    state.secondsPaused = secondsPaused_;
+    state.numSafetyBricks = numSafetyBricks_;
+    state.numBricks = numBricks_;
+
+    state.random = random_;
+
+    // Bricks come right after the barrier, and balls after the bricks
+    long firstBall = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_;
+
+    state.bricks.resize(firstBall - indexOfFirstSafetyBrick_);
+    for (long i = indexOfFirstSafetyBrick_; i < firstBall; ++i) {
+        GameState::BrickState& brickState = state.bricks[i - indexOfFirstSafetyBrick_];
+        dynamic_cast<Brick*>(objects_[i])->saveState(brickState);
+
+        // Only bricks that take several hits have any worth keeping
+        brickState.hitPoints = uint8_t(BrickBatch::getMaxHitPoints(brickState.special) > 1
+                                       ? bricks_.getHitPoints((unsigned long)(i - indexOfFirstSafetyBrick_)) : 0);
+    }
+
+    saveMovingState(state);
+    state.nextBallId = nextBallId_;
+
+    state.dropPowerUps = dropPowerUps_;
+    powerUps_.saveState(state.powerUps);
+    state.laserTimer = lasers_.getTimer();
+    lasers_.saveState(state.lasers);
+}
+
+void GraphicsRunner::saveMovingState(GameState& state) const {
+    dynamic_cast<Paddle*>(getPaddle())->saveState(state.paddle);
+
+    long firstBall = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_;
+    state.balls.resize(objects_.size() - firstBall);
+    for (long i = firstBall; i < long(objects_.size()); ++i) {
+        dynamic_cast<Ball*>(objects_[i])->saveState(state.balls[i - firstBall]);
+    }
+}
+
+void GraphicsRunner::restoreState(const GameState& state) {
+    // Get rid of the current bricks and balls, and any effects from before
+    clear();
+    if (particles_ != nullptr)
+        particles_->clear();
+
+    tick_ = state.tick;
+    level_ = state.level;
+    status_ = state.status;
+    timerStart_ = state.timerStart;
+    timerLength_ = state.timerLength;
+    pauseStart_ = state.pauseStart;
+    secondsPaused_ = state.secondsPaused;
+    numSafetyBricks_ = state.numSafetyBricks;
+    numBricks_ = state.numBricks;
+
+    random_ = state.random;
+
+    text_[0].setString("Level " + to_string(level_));
+
+    dynamic_cast<Paddle*>(getPaddle())->restoreState(state.paddle);
+
+    // Recreate the bricks in the same order (safety bricks first)
+    scripts_ = StageBuilder::getScripts(level_);
+    for (const GameState::BrickState& brickState : state.bricks) {
+        Brick* brick = new Brick(brickState.x, brickState.y, brickState.width, brickState.height, brickState.special);
+        brick->restoreState(brickState);
+        objects_.push_back(brick);
+
+        bricks_.add(*brick);
+        if (brickState.hitPoints > 0)
+            bricks_.setHitPoints(objects_.size() - 1 - indexOfFirstSafetyBrick_, brickState.hitPoints);
+    }
+
+    // Then the balls. Attached balls need the constructor that attaches them to the paddle.
+    for (const GameState::BallState& ballState : state.balls) {
+        Ball* ball = ballState.attached ? new Ball(*this)
+                                        : new Ball(*this, ballState.x, ballState.y, ballState.xVel, ballState.yVel);
+        ball->restoreState(ballState);
+        objects_.push_back(ball);
+    }
+
+    // Balls created from here on get the same ids they did when it was saved, even if the newest balls are gone
+    nextBallId_ = state.nextBallId;
+
+    dropPowerUps_ = state.dropPowerUps;
+    powerUps_.restoreState(state.powerUps);
+    lasers_.restoreState(state.laserTimer, state.lasers);
+}
+
+void GraphicsRunner::enablePowerUpDrops() {
+    dropPowerUps_ = true;
+}
+
+void GraphicsRunner::enableGhost() {
+    if (ghost_ == nullptr)
+        ghost_ = new Ghost();
+
+    // Start racing the level being played if it hasn't really started yet
+    if (tick_ == 0)
+        levelStarting_ = true;
+}
+
+bool GraphicsRunner::loadReplay(const string& path) {
+    ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    // Skip the comment lines at the top of the file (the profiler's statistics)
+    while (file.peek() == '#') {
+        string comment;
+        getline(file, comment);
+    }
+
+    GameState startState;
+    string label;
+    if (!(file >> label) || label != "keyframe" || !startState.read(file)
+        || !InputRecorder::read(file, replayEvents_)
+        || !(file >> label) || label != "end" || !replayEndState_.read(file)) {
+        return false;
+    }
+
+    // Start from the captured snapshot with no text on screen
+    restoreState(startState);
+    addText("");
+
+    replayIndex_ = 0;
+    replaying_ = true;
+    replayMode_ = true;
+    return true;
+}
+
+void GraphicsRunner::captureSlowFrame() {
+    lastCaptureTime_ = getGameTime();
+
+    mkdir("BrickBreakerData/slowframes", ACCESSPERMS);
+    ofstream file("BrickBreakerData/slowframes/" + to_string(tick_) + ".txt");
+    if (!file.is_open())
+        return;
+
+    // The profiler's view of the slow frame, as comments
+    file << "# Slow frame before tick " << tick_ << ": " << profiler_.getFrameTime() << "ms (budget "
+         << SLOW_FRAME_TIME << "ms)\n";
+    file << "#";
+    for (int phase = 0; phase < Profiler::NUM_PHASES; ++phase) {
+        file << ' ' << Profiler::getName(Profiler::Phase(phase)) << ' '
+             << profiler_.getPhaseTime(Profiler::Phase(phase)) << "ms";
+    }
+    file << "\n# collision tests " << profiler_.collisionTests_ << ", draw calls " << profiler_.drawCalls_
+         << ", balls " << profiler_.numBalls_ << ", bricks " << profiler_.numBricks_ << ", allocations "
+         << profiler_.getAllocations() << "\n";
+
+    // Every input event since the older keyframe. If some were lost the replay won't match, so say so.
+    vector<InputEvent> events;
+    if (!inputRecorder_.getEventsSince(previousKeyframe_.tick, events)) {
+        file << "# Input history overflowed, the replay will be incomplete\n";
+    }
+
+    file << "keyframe\n";
+    previousKeyframe_.write(file);
+    InputRecorder::write(file, events);
+
+    GameState state;
+    saveState(state);
+    file << "end\n";
+    state.write(file);
+}
+
+void GraphicsRunner::getMemoryUsage(MemoryReport& report) const {
+    long firstBall = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_;
+    unsigned long numBricks = (unsigned long)(firstBall - indexOfFirstSafetyBrick_);
+    unsigned long numBalls = objects_.size() - firstBall;
+
+    // The game instance itself, minus the members that are reported as their own subsystem below
+    report.add("game instance", 1, sizeof(GraphicsRunner) - sizeof(Profiler) - sizeof(PerformanceHud)
+                                   - sizeof(InputRecorder) - 4 * sizeof(GameState) - sizeof(PowerUps)
+                                   - sizeof(Lasers));
+
+    // Objects are each allocated separately
+    report.add("paddle and barrier", 2, sizeof(Paddle) + sizeof(Barrier));
+    report.add("bricks", numBricks, numBricks * sizeof(Brick) + bricks_.getHeapBytes() + grid_.getHeapBytes()
+                                    + explosions_.getHeapBytes() + removedBricks_.capacity() / 8
+                                    + clearedSpecials_.capacity());
+    report.add("balls", numBalls, numBalls * sizeof(Ball) + trailVertices_.capacity() * sizeof(Vertex)
+                                  + ballContacts_.getHeapBytes());
+
+    // The list of objects and the high score list
+    unsigned long levelBytes = objects_.capacity() * sizeof(Object*) + scores_.capacity() * sizeof(string);
+    for (const string& score : scores_)
+        levelBytes += score.capacity();
+    report.add("level data", objects_.size() + scores_.size(), levelBytes);
+
+    // Text objects and the font glyph cache for each character size in use. Asking the font for a size it has no
+    // glyphs for makes it allocate a page, so only sizes of text that has been drawn are looked at, and headless games
+    // never draw any.
+    unsigned long textBytes = text_.capacity() * sizeof(Text);
+    vector<unsigned int> characterSizes;
+    for (const Text& text : text_) {
+        textBytes += MemoryReport::getTextHeapBytes(text);
+        if (window_ != nullptr && !text.getString().isEmpty()
+            && find(characterSizes.begin(), characterSizes.end(), text.getCharacterSize()) == characterSizes.end())
+            characterSizes.push_back(text.getCharacterSize());
+    }
+    report.add("text objects", text_.size(), textBytes);
+
+    if (window_ != nullptr && hud_.visible_
+        && find(characterSizes.begin(), characterSizes.end(), HUD_TEXT_SIZE) == characterSizes.end())
+        characterSizes.push_back(HUD_TEXT_SIZE);
+
+    // Glyphs are cached in one texture per character size, 4 bytes per pixel
+    unsigned long glyphBytes = 0;
+    for (unsigned int size : characterSizes) {
+        Vector2u textureSize = font_.getTexture(size).getSize();
+        glyphBytes += textureSize.x * textureSize.y * 4;
+    }
+    report.add("font glyph caches", characterSizes.size(), sizeof(Font) + glyphBytes);
+
+    // Slow frame keyframes, recent input, a loaded replay, and the current level's run
+    report.add("replay buffers", 4 + InputRecorder::CAPACITY + replayEvents_.size() + levelInputs_.size(),
+               4 * sizeof(GameState) + keyframe_.getHeapBytes() + previousKeyframe_.getHeapBytes()
+               + replayEndState_.getHeapBytes() + levelStart_.getHeapBytes() + sizeof(InputRecorder)
+               + (replayEvents_.capacity() + levelInputs_.capacity()) * sizeof(InputEvent));
+
+    if (ghost_ != nullptr)
+        ghost_->getMemoryUsage(report);
+
+    if (particles_ != nullptr)
+        particles_->getMemoryUsage(report);
+    powerUps_.getMemoryUsage(report);
+    lasers_.getMemoryUsage(report);
+
+    report.add("profiler", 1, sizeof(Profiler));
+    hud_.getMemoryUsage(report);
+}
+
+const BrickGrid& GraphicsRunner::getBrickGrid() {
+    if (!grid_.isValid()) {
+        grid_.build(objects_, indexOfFirstSafetyBrick_, indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_,
+                    windowSize_, BALL_RADIUS);
+    }
+    return grid_;
+}
+
 vector<Object*>& GraphicsRunner::getObjects() {
     return objects_;
 }
@@ -194,28 +908,146 @@ Object* GraphicsRunner::getBarrier() const {
     return objects_[1];
 }
 
-void GraphicsRunner::handleSpecialBrick(Brick* brick) {
-    char& special = brick->special_;
-
-    // Extra ball special brick
+void GraphicsRunner::handleSpecialBrick(char special) {
     switch(special) {
-        case 's': // Safety brick
-            --numSafetyBricks_;
-            return; // Prevents decrementing "numBricks_" which occurs after the switch statement
-
         case 'b': // Extra ball
             objects_.push_back(new Ball(*this)); // Create a ball attached to the game's paddle
+            ++specialsCleared_;
             break;
 
         case 'l': // Extra long paddle
             dynamic_cast<Paddle*>(getPaddle())->changeLength(true);
+            ++specialsCleared_;
+            break;
+
+        case 'g': // Big balls
+        case 't': // Tiny balls
+            for (long i = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_; i < long(objects_.size()); ++i)
+                dynamic_cast<Ball*>(objects_[i])->resize(special == 'g' ? BALL_BIG_RADIUS : BALL_TINY_RADIUS);
+            ++specialsCleared_;
+            break;
+
+        case 'z': // Lasers
+            lasers_.power(getGameTime() + LASER_TIME);
+            ++specialsCleared_;
             break;
 
 
         default: break; // Do nothing in the default case
     }
+}
+
+void GraphicsRunner::hitBrick(long index) {
+    Brick* brick = dynamic_cast<Brick*>(objects_[index]);
+
+    // A brick already destroyed this tick is just waiting to be removed
+    if (brick->delete_)
+        return;
+
+    if (brick->special_ != 'x' || scripts_ == nullptr) {
+        damageBrick(index);
+        return;
+    }
+
+    // The hit is only counted once its script runs (see runBrickScripts()), so a dropped event leaves no trace
+    if (numScriptEvents_ < BRICK_SCRIPT_MAX_EVENTS)
+        scriptEvents_[numScriptEvents_++] = {index, false};
+}
+
+void GraphicsRunner::damageBrick(long index) {
+    Brick* brick = dynamic_cast<Brick*>(objects_[index]);
+    brick->delete_ = bricks_.damage((unsigned long)(index - indexOfFirstSafetyBrick_));
+    if (brick->delete_ && brick->special_ == 'e')
+        explosions_.trigger((unsigned long)(index - indexOfFirstSafetyBrick_));
+}
+
+void GraphicsRunner::explode() {
+    long first = indexOfFirstSafetyBrick_;
+    profiler_.collisionTests_ += explosions_.spread(objects_, first, first + numSafetyBricks_ + numBricks_, bricks_,
+                                                    getBrickGrid());
+
+    // The bricks are removed at the start of the next tick like any other
+    const vector<uint64_t>& destroyed = explosions_.getDestroyed();
+    for (unsigned long word = 0; word < destroyed.size(); ++word) {
+        uint64_t bits = destroyed[word];
+        for (unsigned long bit = 0; bits != 0; ++bit, bits >>= 1) {
+            if (bits & 1)
+                objects_[first + word * 64 + bit]->delete_ = true;
+        }
+    }
+}
+
+void GraphicsRunner::runBrickScripts() {
+    unsigned int budget = BRICK_SCRIPT_STEPS_PER_TICK;
+    BrickScriptRun run;
+
+    // Signals are queued behind the events already waiting, so the queue can grow while it is worked through
+    for (unsigned int i = 0; i < numScriptEvents_ && budget > 0; ++i) {
+        long index = scriptEvents_[i].index;
+        Brick* brick = dynamic_cast<Brick*>(objects_[index]);
+        if (brick->delete_)
+            continue;
+
+        // A hit from a ball counts as the script sees it, so two hits in one tick run once with each count
+        if (!scriptEvents_[i].signaled)
+            ++brick->hits_;
+        run.hits = brick->hits_;
+        run.signaled = scriptEvents_[i].signaled;
+        run.registers = brick->registers_;
+        scripts_->run(brick->script_, run, budget);
+
+        // Apply what the script asked for
+        if (run.shade >= 0) {
+            brick->setShade(run.shade);
+            bricks_.setColor((unsigned long)(index - indexOfFirstSafetyBrick_), brick->getColor());
+        }
+
+        if (run.destroy)
+            brick->delete_ = true;
+
+        for (unsigned int k = 0; k < run.numBalls; ++k) {
+            objects_.push_back(new Ball(*this)); // Attached to the paddle, like an extra ball brick's
+            ++specialsCleared_;
+        }
+
+        if (run.longPaddle) {
+            dynamic_cast<Paddle*>(getPaddle())->changeLength(true);
+            ++specialsCleared_;
+        }
+
+        // A signaled scripted brick runs its own script, anything else takes a hit as if from a ball
+        for (unsigned int k = 0; k < run.numSignals; ++k) {
+            long neighbor = findNeighbor(index, run.signals[k][0], run.signals[k][1]);
+            if (neighbor < 0)
+                continue;
+
+            Brick* other = dynamic_cast<Brick*>(objects_[neighbor]);
+            if (other->delete_)
+                continue;
+
+            if (other->special_ != 'x')
+                damageBrick(neighbor);
+            else if (numScriptEvents_ < BRICK_SCRIPT_MAX_EVENTS)
+                scriptEvents_[numScriptEvents_++] = {neighbor, true};
+        }
+    }
+
+    numScriptEvents_ = 0;
+}
 
-    --numBricks_;
+long GraphicsRunner::findNeighbor(long index, int columns, int rows) const {
+    // Level bricks sit on a grid, each one a brick's size plus the separation from the next
+    FloatRect bounds = dynamic_cast<Brick*>(objects_[index])->getBounds();
+    float x = bounds.left + bounds.width / 2 + columns * (bounds.width + BRICK_SEPARATION);
+    float y = bounds.top + bounds.height / 2 + rows * (bounds.height + BRICK_SEPARATION);
+
+    // Safety bricks aren't part of the grid
+    long firstBall = indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_;
+    for (long i = indexOfFirstSafetyBrick_ + numSafetyBricks_; i < firstBall; ++i) {
+        if (dynamic_cast<Brick*>(objects_[i])->getBounds().contains(x, y))
+            return i;
+    }
+    return -1;
 }
 
 void GraphicsRunner::addText(string str, Color color, unsigned int size, bool needClear, char position) {
@@ -305,28 +1137,32 @@ void GraphicsRunner::togglePause() {
         }
 
         status_ = 'p';
-        pauseStart_ = time(0);
+        pauseStart_ = getGameTime();
     }
     else if (status_ == 'p') {
         addText("");
         status_ = '\0';
-        secondsPaused_ += difftime(time(0), pauseStart_);
+        secondsPaused_ += getGameTime() - pauseStart_;
     }
 }
 
 void GraphicsRunner::checkStatus() {
     // In normal status, check to make sure the game isn't over
     if (status_ == '\0') {
-        // If no bricks remain, the player won
-        if (numBricks_ == 0) {
+        // If no bricks remain (other than armored ones), the player won
+        if (numBricks_ == int(bricks_.getNumArmored())) {
             addText("Level Cleared!", WIN_COLOR, 54);
             status_ = 'c';
-            saveHighScore(difftime(time(0), timerStart_) - secondsPaused_);
-            timerStart_ = time(0);  // Timer for the break between levels
+
+            // The timer stops here, so show the exact time being scored even if more ticks run this frame
+            if (window_ != nullptr)
+                updateTimerText();
+            saveHighScore(getGameTime() - timerStart_ - secondsPaused_);
+            timerStart_ = getGameTime();  // Timer for the break between levels
             timerLength_ = LEVEL_BREAK_TIME;
         }
         // If no balls remain, the player lost
-        else if (objects_.size() == indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_) {
+        else if (long(objects_.size()) == indexOfFirstSafetyBrick_ + numSafetyBricks_ + numBricks_) {
             gameOver();
         }
     }
@@ -334,7 +1170,7 @@ void GraphicsRunner::checkStatus() {
     // Also check the timer to see if we need to clear off any text, or perhaps load the next level
     if (timerLength_ > 0) {
         // If the timer is over
-        if (difftime(time(0), timerStart_) > timerLength_) {
+        if (getGameTime() - timerStart_ > timerLength_) {
             timerLength_ = 0;
 
             // If the player just completed a level, load the next one
@@ -355,18 +1191,24 @@ void GraphicsRunner::clear() {
     --i;
 
     // While there are objects other than the paddle and the barrier
-    while (objects_.size() > indexOfFirstSafetyBrick_) {
+    while (long(objects_.size()) > indexOfFirstSafetyBrick_) {
         // Deallocate the memory and pop the object off the objects vector
         delete *i;
         --i;
         objects_.pop_back();
     }
+
+    bricks_.clear();
+    grid_.invalidate();
+    ballContacts_.clear();
+    powerUps_.clear();
+    lasers_.clear();
 }
 
 void GraphicsRunner::nextLevel(bool needClear) {
     // If a player is already paused going into a level, make it as though they paused right when the level begins
     secondsPaused_ = 0;
-    pauseStart_ = time(0);
+    pauseStart_ = getGameTime();
 
     // Increment the level and update the display text
     ++level_;
@@ -380,9 +1222,13 @@ void GraphicsRunner::nextLevel(bool needClear) {
     }
 
     addText("level " + to_string(level_), DEFAULT_COLOR, 54);
-    timerStart_ = time(0);  // Marks the start of the level timer
+    timerStart_ = getGameTime();  // Marks the start of the level timer
     timerLength_ = LEVEL_BREAK_TIME/2;
 
+    profiler_.beginPhase(Profiler::LEVEL_LOAD);
+
+    scripts_ = StageBuilder::getScripts(level_);
+
     // One fewer safety brick every level
     numSafetyBricks_ = NUM_SAFETY_BRICKS - level_ + 1;
 
@@ -396,9 +1242,16 @@ void GraphicsRunner::nextLevel(bool needClear) {
 
     // Record the number of bricks before adding the ball
     numBricks_ = int(objects_.size()) - (indexOfFirstSafetyBrick_ + numSafetyBricks_);
+    for (long i = indexOfFirstSafetyBrick_; i < long(objects_.size()); ++i)
+        bricks_.add(*dynamic_cast<Brick*>(objects_[i]));
+    grid_.invalidate();
 
     // Create a ball attached to the paddle
     objects_.push_back(new Ball(*this));
+
+    levelStarting_ = true;
+
+    profiler_.endPhase(Profiler::LEVEL_LOAD);
 }
 
 void GraphicsRunner::gameOver(bool won) {
@@ -442,7 +1295,7 @@ string GraphicsRunner::getTimeStringFromSeconds(double totalSeconds) {
 
 void GraphicsRunner::saveHighScore(double score) {
     // If no high score exists yet for this level, create a new one
-    if (scores_.size() < level_) {
+    if (int(scores_.size()) < level_) {
         // NOTE! This assumes that level_ = scores_.size() + 1
         scores_.push_back(to_string(score));
     }
@@ -452,6 +1305,16 @@ void GraphicsRunner::saveHighScore(double score) {
             scores_[level_-1] = to_string(score);
             addText("New High Score!", DEFAULT_COLOR, 24, false);
         }
+        else {
+            return;
+        }
+    }
+
+    // Keep the run to race against later. Only runs recorded from the start of the level are kept, and like the
+    // scores, none are kept from replays or headless games.
+    if (window_ != nullptr && !replayMode_ && levelStart_.level == level_
+        && !Ghost::save(level_, levelStart_, levelInputs_, score)) {
+        cerr << "Could not save the run through level " << level_ << endl;
     }
 }
 
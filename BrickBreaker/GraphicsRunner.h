@@ -14,14 +14,34 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Window/Event.hpp>
+#include <random>
 #include "Object.h"
 #include "StageBuilder.h"
 #include "Brick.h"
+#include "AimAssist.h"
+#include "BallContacts.h"
+#include "BrickBatch.h"
+#include "BrickGrid.h"
+#include "BrickScript.h"
 #include "Constants.h"
+#include "Explosions.h"
+#include "Lasers.h"
+#include "PowerUps.h"
+#include "Profiler.h"
+#include "PerformanceHud.h"
+#include "GameState.h"
+#include "InputRecorder.h"
+#include "MemoryReport.h"
+
+class Ghost;
+class ParticleSystem;
 
 /**
  * \class GraphicsRunner
  * \brief The main game instance. Contains all the game's objects and deals with moving and drawing them.
+ *
+ * \details Everything a game changes lives inside its instance (objects, timers, random number generator, profiler),
+ *      so any number of games can run in one process as long as each one is only used by one thread at a time.
  */
 class GraphicsRunner {
 public:
@@ -32,6 +52,16 @@ public:
      */
     GraphicsRunner(sf::RenderWindow& window);
 
+    /**
+     * \brief Constructor for a headless game, one that is only simulated and never drawn
+     *
+     * \details Headless games lay out the stage as though they had a WINDOW_WIDTH by WINDOW_HEIGHT window. They don't
+     *      load the font, read or write high scores, or capture slow frames. Advance them with step().
+     *
+     * \param seed  Seed for the game's random number generator. Games with the same seed and input play out the same.
+     */
+    explicit GraphicsRunner(unsigned int seed);
+
     /**
      * \brief Destructor for the game
      *
@@ -42,11 +72,21 @@ public:
     /**
      * \brief Updates the graphics and game state for the next frame
      *
-     * \details Clears the window, moves and draws all objects, and handles any other needed checks (checking if the
-     *      game is over for example)
+     * \details Runs as many ticks as the time scale calls for (none on some frames in slow motion, several in fast
+     *      forward), then clears the window and draws all objects part way between their last two ticks so motion stays
+     *      smooth at any speed. Each part of the frame is timed by profiler_, and if the frame goes over budget the
+     *      game's recent history is written to file (see captureSlowFrame()).
      */
     void update();
 
+    /**
+     * \brief Advances the game state by one tick without drawing anything
+     *
+     * \details Does everything update() does except clearing, drawing and displaying the window. This is the only
+     *      way to advance a headless game.
+     */
+    void step();
+
     /**
      * \brief Takes in an event and handles it appropriately
      *
@@ -57,6 +97,17 @@ public:
      */
     void handleEvent(sf::Event& event);
 
+    /**
+     * \brief Applies a key press or release to the game
+     *
+     * \details Unlike handleEvent(), the key isn't recorded or checked against the last event, so games whose input
+     *      is decided per tick from elsewhere (see VersusSession) get exactly the keys they are given.
+     *
+     * \param type  Either a key press or key release
+     *        key   The key pressed or released
+     */
+    void processKey(sf::Event::EventType type, sf::Keyboard::Key key);
+
     /**
      * \brief Releases a ball attached to the game's paddle (if there is one)
      *
@@ -67,6 +118,129 @@ public:
      */
     void releaseBall();
 
+    /**
+     * \brief Handles a ball hitting a brick
+     *
+     * \details Regular bricks are marked for deletion, and bricks that take several hits once they run out (see
+     *      BrickBatch). Scripted bricks count the hit and queue a run of their script, which happens once every object
+     *      has moved (see runBrickScripts()). Explosive bricks go off once the scripts have run (see explode()).
+     *
+     * \param index The brick's index in the list of objects
+     */
+    void hitBrick(long index);
+
+    /**
+     * \brief Returns the game's status (see the declaration of status_)
+     */
+    char getStatus() const;
+
+    /**
+     * \brief Returns the level being played, 1 is the first level
+     */
+    int getLevel() const;
+
+    /**
+     * \brief Returns how many times the game has been updated
+     */
+    unsigned long getTick() const;
+
+    /**
+     * \brief Returns the number of seconds the game has been running, measured in ticks rather than wall time
+     *
+     * \details All of the game's timers use this so that a game can be replayed exactly
+     */
+    double getGameTime() const;
+
+    /**
+     * \brief Sets how many ticks update() runs per frame, from TIME_SCALES[0] (slow motion) to the last of TIME_SCALES
+     *      (fast forward)
+     *
+     * \details Ticks are the same fixed length at any speed, so a game plays out the same and its timer and scores
+     *      stay in game time. Also changed while playing with [ and ] (slower and faster) and \\ (normal speed).
+     */
+    void setTimeScale(float scale);
+
+    /**
+     * \brief Returns how many ticks update() runs per frame
+     */
+    float getTimeScale() const;
+
+    /**
+     * \brief Returns how many extra ball and long paddle bricks were cleared on the last tick
+     */
+    unsigned int getNumSpecialsCleared() const;
+
+    /**
+     * \brief Adds a row of junk bricks below the lowest regular brick, with one random brick left out
+     *
+     * \details Used by versus mode to push the opponent's stage down. Bricks that would land on a ball are left out
+     *      too. Nothing is added once the bricks get within JUNK_ROW_CLEARANCE of the paddle.
+     *
+     * \return true if the row was added
+     */
+    bool addJunkRow();
+
+    /**
+     * \brief Copies the game's simulation state into a snapshot
+     *
+     * \param state   The snapshot to fill. Its vectors are reused, so saving into the same snapshot every tick doesn't
+     *                  allocate once they are big enough.
+     */
+    void saveState(GameState& state) const;
+
+    /**
+     * \brief Copies only the paddle and balls into a snapshot, leaving the rest of it as it was
+     *
+     * \details Enough to draw the game without its bricks (see Ghost)
+     */
+    void saveMovingState(GameState& state) const;
+
+    /**
+     * \brief Replaces the game's simulation state with a snapshot
+     *
+     * \details Deletes all bricks and balls, then recreates them from the snapshot
+     */
+    void restoreState(const GameState& state);
+
+    /**
+     * \brief Loads a file written by captureSlowFrame() and replays it
+     *
+     * \details Restores the file's starting snapshot, then feeds the recorded input to the game on the same ticks it
+     *      was originally handled on while ignoring the keyboard. Once the capture's last tick is reached the state is
+     *      compared against the captured one, the result is printed, and the game is paused at that point.
+     *
+     * \return true if the file was read successfully, false otherwise
+     */
+    bool loadReplay(const std::string& path);
+
+    /**
+     * \brief Races every level against the best run through it so far, if one has been saved
+     *
+     * \details The best run's paddle and balls are drawn translucently behind the game's (see Ghost). Starts with the
+     *      next level to begin, or the first if called before the game is first updated.
+     */
+    void enableGhost();
+
+    /**
+     * \brief Makes special bricks drop capsules that have to be caught with the paddle, instead of applying their
+     *      effects as soon as they are destroyed (see PowerUps)
+     */
+    void enablePowerUpDrops();
+
+    /**
+     * \brief Adds the memory used by each of the game's subsystems to a report
+     *
+     * \details Every byte of the GraphicsRunner itself is counted exactly once, either by the subsystem it belongs to
+     *      or in the "game instance" entry, so the report's total is the memory needed for one more instance.
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+    /**
+     * \brief Returns the grid of the game's bricks, first rebuilding it if bricks were added or removed since it was
+     *      last built
+     */
+    const BrickGrid& getBrickGrid();
+
     /**
      * \brief Returns a vector of all the objects active in the game
      */
@@ -90,20 +264,112 @@ public:
     int numSafetyBricks_;           ///< The number of safety bricks on the stage
     int numBricks_;                 ///< The number of bricks on the stage
     sf::Vector2u windowSize_;       ///< Holds the original window size to handle window resizing
+    Profiler profiler_;             ///< Times each frame. Objects add to its counters while moving and drawing
+    std::minstd_rand random_;       ///< All of the game's randomness comes from here so its state can be saved
+    uint32_t nextBallId_;           ///< The id the next ball created gets, see Ball::getId()
 
 
 private:
     std::vector<Object*> objects_;
-    sf::RenderWindow& window_;
+    BrickBatch bricks_;             ///< Hit points and colors of the bricks in objects_, in the same order
+    BrickGrid grid_;                ///< The bricks in objects_ by where they are, rebuilt after they change
+    BallContacts ballContacts_;     ///< The pairs of balls touching each other, found again every tick
+    Explosions explosions_;         ///< The explosive bricks destroyed this tick and the bricks they take out
+    std::vector<bool> removedBricks_;   ///< Which bricks removeDeletedObjects() is removing, kept between ticks
+    std::vector<char> clearedSpecials_; ///< The specials of the bricks it removed, applied once they are gone
+    PowerUps powerUps_;             ///< Capsules falling from special bricks, when they are dropped
+    Lasers lasers_;                 ///< Shots the paddle fires while it has lasers
+    sf::RenderWindow* window_;      ///< nullptr for headless games
     sf::Event lastEvent_;    ///< Stores what the last event was to prevent registering the same event multiple times
     StageBuilder builder_;
 
     /**
-     * \brief Checks if a brick is special, and if it is, applies the correct behavior
+     * \brief Constructor that both public constructors delegate to
+     *
+     * \param window        The graphics window on which to display the game, nullptr for a headless game
+     *        windowSize    The size of the area the stage is laid out in
+     *        seed          Seed for the game's random number generator
+     */
+    GraphicsRunner(sf::RenderWindow* window, sf::Vector2u windowSize, unsigned int seed);
+
+    // A game owns its objects and they hold references back to it, so it can't be copied
+    GraphicsRunner(const GraphicsRunner&) = delete;
+    GraphicsRunner& operator=(const GraphicsRunner&) = delete;
+
+    /**
+     * \brief Handles replayed input for this tick and deletes objects marked for deletion
+     */
+    void removeDeletedObjects();
+
+    /**
+     * \brief Clears the window and draws all objects and text
+     *
+     * \param alpha How far between their last two ticks to draw the objects that move (see Object::drawInterpolated())
+     */
+    void drawObjects(float alpha);
+
+    /**
+     * \brief Moves all objects, updates the level timer and checks the game's status
+     */
+    void simulate();
+
+    /**
+     * \brief Advances the tick count, then checks on the replay or keeps keyframes
+     */
+    void finishTick();
+
+    /**
+     * \brief Remembers where the paddle and balls are at the start of a tick, so frames can be drawn between ticks
+     */
+    void rememberPositions();
+
+    /**
+     * \brief Sets the banner's timer from the level time, followed by the time scale if it isn't normal speed
+     */
+    void updateTimerText();
+
+    /**
+     * \brief Writes everything needed to reproduce the last frame to a file in BrickBreakerData/slowframes
+     *
+     * \details The file holds the profiler's statistics for the frame, a snapshot from a few seconds earlier, every
+     *      input event since that snapshot, and a snapshot of the current state. Loading it with loadReplay() replays
+     *      the stutter deterministically.
+     */
+    void captureSlowFrame();
+
+    /**
+     * \brief Applies the behavior of a special brick that has just been removed
+     *
+     * \param special   The brick's special character (see Brick::special_)
+     */
+    void handleSpecialBrick(char special);
+
+    /**
+     * \brief Takes a hit point from a brick that isn't scripted, marking it for deletion once it runs out, and sets it
+     *      off if it is explosive
+     */
+    void damageBrick(long index);
+
+    /**
+     * \brief Marks every brick taken out by the explosive bricks destroyed this tick for deletion
+     */
+    void explode();
+
+    /**
+     * \brief Runs the scripts queued by hitBrick() this tick, and any they signal, then empties the queue
      *
-     * \param brick The brick that has just been hit and could possibly have special properties
+     * \details All the runs in a tick share BRICK_SCRIPT_STEPS_PER_TICK instructions. Events left when they run out
+     *      are dropped rather than carried into the next tick, so scripts can never hold up a frame and the queue is
+     *      never part of a snapshot. A brick's hit count only goes up when a hit's script runs, so a dropped hit is as
+     *      if it never happened.
+     */
+    void runBrickScripts();
+
+    /**
+     * \brief Returns the index in objects_ of the brick a number of columns and rows away from another, or -1 if there
+     *      isn't one
      */
-    void handleSpecialBrick(Brick* brick);
+    long findNeighbor(long index, int columns, int rows) const;
 
     /**
      * \brief Changes the text to be displayed in the center of the screen
@@ -188,6 +454,8 @@ private:
     /**
      * \brief Saves a high score for the current level if it beats the current high score
      *
+     * \details A score that is saved also has its run saved as the level's ghost, if the whole run was recorded
+     *
      * \param score The score for the current level in seconds
      *
      * \note Assumes that scores for all levels other than the current one are filled (cant beat level 5 before level 4)
@@ -227,15 +495,81 @@ private:
 
     unsigned long baseNumTextObjects_;  ///< The number of text objects permanently present (ones in the banner)
 
-    time_t pauseStart_;                 ///< Holds the time at which the player paused the game
+    double pauseStart_;                 ///< Holds the time at which the player paused the game
 
     double secondsPaused_;               ///< How many seconds the game has been paused for
 
-    time_t timerStart_;                 ///< Holds the time at which a timer started. Otherwise when the level started
+    double timerStart_;                 ///< Holds the time at which a timer started. Otherwise when the level started
 
     float timerLength_;                 ///< Holds how long the current timer should go for
 
     int level_;                         ///< 1 is the first level as well as the loneliest number
+
+    PerformanceHud hud_;                ///< Overlay showing profiler_'s statistics, toggled with F3. F4 prints memory.
+
+    unsigned long tick_;                ///< How many times the game has been updated
+
+    unsigned int specialsCleared_;      ///< Extra ball and long paddle bricks cleared on the last tick
+
+    InputRecorder inputRecorder_;       ///< Recent input, written out along with slow frames
+
+    GameState keyframe_;                ///< Snapshot taken every KEYFRAME_INTERVAL seconds
+
+    GameState previousKeyframe_;        ///< The snapshot before keyframe_, so captures include a few seconds of input
+
+    double lastCaptureTime_;            ///< Game time of the last slow frame capture
+
+    bool replaying_;                    ///< True while recorded input is being fed to the game instead of the keyboard
+
+    bool replayMode_;                   ///< True if a replay was ever loaded. High scores are not saved in replay mode.
+
+    std::vector<InputEvent> replayEvents_;  ///< The input being replayed
+
+    unsigned long replayIndex_;         ///< Index in replayEvents_ of the next event to replay
+
+    GameState replayEndState_;          ///< The state the replay should reach on its last tick
+
+    bool levelStarting_;                ///< Set when a level is loaded, so its start is recorded at the end of the tick
+
+    GameState levelStart_;              ///< Snapshot from the start of the current level, saved with its best run
+
+    std::vector<InputEvent> levelInputs_;   ///< Every input event handled since levelStart_
+
+    Ghost* ghost_;                      ///< The best run being raced, nullptr unless ghosts are enabled
+
+    float timeScale_;                   ///< Ticks run per frame
+
+    float tickBudget_;                  ///< Ticks owed to the next frame, the fraction is how far to interpolate
+
+    const BrickScript* scripts_;        ///< The current level's scripts, nullptr if it has none
+
+    ParticleSystem* particles_;         ///< Brick shatter and ball trail effects, nullptr for headless games
+
+    bool showTrails_;                   ///< Whether balls are drawn with motion trails, toggled with F5
+
+    bool dropPowerUps_;                 ///< Whether special bricks drop capsules, see enablePowerUpDrops()
+
+    AimAssist aim_;                     ///< The path an attached ball would take, drawn until it is released
+
+    /// Every ball's trail joined into one triangle strip. Only grows when there are more balls than ever before.
+    std::vector<sf::Vertex> trailVertices_;
+
+    /**
+     * \struct ScriptEvent
+     * \brief A scripted brick waiting to run its script this tick
+     */
+    struct ScriptEvent {
+        long index;                     ///< The brick's index in objects_, which doesn't change during a tick
+        bool signaled;                  ///< Signaled by a neighbor rather than hit by a ball
+    };
+
+    ScriptEvent scriptEvents_[BRICK_SCRIPT_MAX_EVENTS];
+
+    unsigned int numScriptEvents_;
+
+    char caughtPowerUps_[POWER_UP_CAPACITY];    ///< The types of the capsules caught this tick
+
+    long laserHits_[LASER_CAPACITY];            ///< The bricks hit by laser shots this tick
 };
 
 
@@ -0,0 +1,75 @@
+/**
+ * \file InputRecorder.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a fixed size history of the player's input
+ */
+#include <string>
+#include "InputRecorder.h"
+
+using namespace sf;
+
+InputRecorder::InputRecorder()
+        : next_(0),
+          numRecorded_(0)
+{
+}
+
+void InputRecorder::record(unsigned long tick, Event::EventType type, Keyboard::Key key) {
+    events_[next_].tick = tick;
+    events_[next_].type = type;
+    events_[next_].key = key;
+
+    next_ = (next_ + 1) % CAPACITY;
+    ++numRecorded_;
+}
+
+bool InputRecorder::getEventsSince(unsigned long tick, std::vector<InputEvent>& events) const {
+    events.clear();
+
+    // Only the last CAPACITY events are still in the buffer
+    unsigned int numValid = numRecorded_ < CAPACITY ? (unsigned int)numRecorded_ : CAPACITY;
+    unsigned int oldest = (next_ + CAPACITY - numValid) % CAPACITY;
+
+    for (unsigned int i = 0; i < numValid; ++i) {
+        const InputEvent& event = events_[(oldest + i) % CAPACITY];
+        if (event.tick >= tick) {
+            events.push_back(event);
+        }
+    }
+
+    // If the buffer has wrapped and even the oldest remembered event is after the tick, some events were lost
+    return numRecorded_ <= CAPACITY || events_[oldest].tick < tick;
+}
+
+void InputRecorder::clear() {
+    next_ = 0;
+    numRecorded_ = 0;
+}
+
+void InputRecorder::write(std::ostream& out, const std::vector<InputEvent>& events) {
+    out << "inputs " << events.size() << '\n';
+    for (const InputEvent& event : events) {
+        out << event.tick << ' ' << int(event.type) << ' ' << int(event.key) << '\n';
+    }
+}
+
+bool InputRecorder::read(std::istream& in, std::vector<InputEvent>& events) {
+    std::string label;
+    unsigned long count;
+    if (!(in >> label >> count) || label != "inputs")
+        return false;
+
+    events.resize(count);
+    for (InputEvent& event : events) {
+        int type, key;
+        in >> event.tick >> type >> key;
+        event.type = Event::EventType(type);
+        event.key = Keyboard::Key(key);
+    }
+
+    return bool(in);
+}
@@ -0,0 +1,76 @@
+/**
+ * \file InputRecorder.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a fixed size history of the player's input
+ */
+
+#ifndef BRICKBREAKER_INPUTRECORDER_H
+#define BRICKBREAKER_INPUTRECORDER_H
+
+#include <SFML/Window/Event.hpp>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/**
+ * \struct InputEvent
+ * \brief A key press or release and the tick it was handled on
+ */
+struct InputEvent {
+    unsigned long tick;
+    sf::Event::EventType type;  ///< Either KeyPressed or KeyReleased
+    sf::Keyboard::Key key;
+};
+
+/**
+ * \class InputRecorder
+ * \brief Remembers the most recent input events in a ring buffer
+ *
+ * \details The buffer never grows, so recording never allocates. Once full, each new event overwrites the oldest.
+ */
+class InputRecorder {
+public:
+    static const unsigned int CAPACITY = 256;   ///< Far more key events than a player makes in a few seconds
+
+    InputRecorder();
+
+    /**
+     * \brief Adds an event to the history, overwriting the oldest one if the history is full
+     */
+    void record(unsigned long tick, sf::Event::EventType type, sf::Keyboard::Key key);
+
+    /**
+     * \brief Copies every remembered event handled on or after the given tick into events, oldest first
+     *
+     * \return false if events from that tick on may have been overwritten (the history is incomplete), true otherwise
+     */
+    bool getEventsSince(unsigned long tick, std::vector<InputEvent>& events) const;
+
+    /**
+     * \brief Forgets all recorded events
+     */
+    void clear();
+
+    /**
+     * \brief Writes a list of events as text, one per line, preceded by the number of events
+     */
+    static void write(std::ostream& out, const std::vector<InputEvent>& events);
+
+    /**
+     * \brief Reads a list of events written by write()
+     *
+     * \return true if the whole list was read, false otherwise
+     */
+    static bool read(std::istream& in, std::vector<InputEvent>& events);
+
+private:
+    InputEvent events_[CAPACITY];
+    unsigned int next_;         ///< Where the next event will be written
+    unsigned long numRecorded_; ///< Total events ever recorded, used to tell how many slots hold valid events
+};
+
+#endif //BRICKBREAKER_INPUTRECORDER_H
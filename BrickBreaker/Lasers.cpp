@@ -0,0 +1,175 @@
+/**
+ * \file Lasers.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a pool of laser shots fired up from the paddle, each aimed at a brick with a ray cast
+ */
+#include <algorithm>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include "Brick.h"
+#include "Constants.h"
+#include "Lasers.h"
+
+using namespace sf;
+using namespace std;
+
+Lasers::Lasers()
+        : x_(LASER_CAPACITY),
+          y_(LASER_CAPACITY),
+          impact_(LASER_CAPACITY),
+          targets_(LASER_CAPACITY),
+          pool_(LASER_CAPACITY),
+          numAimed_(0),
+          aimedVersion_(0),
+          numCasts_(0),
+          timer_(0) // Game time starts at 0, so the paddle starts without lasers
+{
+}
+
+void Lasers::power(double until) {
+    timer_ = max(timer_, until);
+}
+
+double Lasers::getTimer() const {
+    return timer_;
+}
+
+bool Lasers::fire(float x, float y) {
+    unsigned int index;
+    if (!pool_.add(index))
+        return false;
+
+    x_[index] = x;
+    y_[index] = y;
+    return true;
+}
+
+unsigned int Lasers::update(const vector<Object*>& objects, const BrickGrid& grid, float top, long* hits) {
+    // Every shot is aimed again once the bricks change, otherwise only the ones fired since the last tick are
+    if (grid.getVersion() != aimedVersion_) {
+        aimedVersion_ = grid.getVersion();
+        numAimed_ = 0;
+    }
+
+    numCasts_ = pool_.getCount() - numAimed_;
+    for (unsigned int i = numAimed_; i < pool_.getCount(); ++i)
+        aim(i, objects, grid, top);
+
+    float* y = y_.data();
+    const float* impact = impact_.data();
+
+    unsigned int first = 0;
+
+#ifdef __SSE__
+    // Four shots at a time, flagging those that reached their brick or the top of the stage
+    static_assert(LASER_CAPACITY % 4 == 0, "the last group of four shots must fit in the pool");
+    const __m128 rise = _mm_set1_ps(LASER_SPEED);
+    first = pool_.flagGroups([&](unsigned int i) {
+        __m128 y4 = _mm_sub_ps(_mm_loadu_ps(y + i), rise);
+        _mm_storeu_ps(y + i, y4);
+        return _mm_movemask_ps(_mm_cmple_ps(y4, _mm_loadu_ps(impact + i)));
+    });
+#endif
+
+    // One at a time where SSE isn't available
+    pool_.flagEach(first, [&](unsigned int i) {
+        y[i] -= LASER_SPEED;
+        return y[i] <= impact[i];
+    });
+
+    // Then only the flagged ones
+    unsigned int numHits = 0;
+    pool_.forEachFlagged([&](unsigned int i) {
+        // A shot whose brick was destroyed earlier in the tick carries on to whatever is behind it
+        if (targets_[i] >= 0 && objects[targets_[i]]->delete_) {
+            ++numCasts_;
+            aim(i, objects, grid, top);
+            if (y[i] > impact[i])
+                return;
+        }
+
+        if (targets_[i] >= 0)
+            hits[numHits++] = targets_[i];
+        pool_.remove(i, x_, y_, impact_, targets_);
+    });
+
+    numAimed_ = pool_.getCount();
+    return numHits;
+}
+
+void Lasers::aim(unsigned int index, const vector<Object*>& objects, const BrickGrid& grid, float top) {
+    // The height comes from the brick itself rather than how far along the ray it was, so a shot aimed again
+    // further up hits at exactly the same height. Bricks destroyed this tick stay on the grid until they're removed
+    // at the start of the next, so the ray starts again from the top of each one it finds.
+    Vector2f origin(x_[index], y_[index]);
+    BrickGrid::Hit hit;
+    while (origin.y > top && grid.rayCast(origin, Vector2f(0, -1), origin.y - top, 0, hit)) {
+        const Box& shape = static_cast<Brick*>(objects[hit.index])->getShape();
+        if (!objects[hit.index]->delete_) {
+            impact_[index] = shape.bottom;
+            targets_[index] = hit.index;
+            return;
+        }
+        origin.y = shape.top;
+    }
+
+    impact_[index] = top;
+    targets_[index] = -1;
+}
+
+void Lasers::draw(RenderWindow& window, float alpha) {
+    const unsigned int count = pool_.getCount();
+    if (count == 0)
+        return;
+
+    if (vertices_.empty())
+        vertices_.resize(LASER_CAPACITY * 2);
+
+    // A line per shot, where it was part way through the tick
+    for (unsigned int i = 0; i < count; ++i) {
+        float y = y_[i] + LASER_SPEED * (1 - alpha);
+
+        Vertex* line = &vertices_[i * 2];
+        line[0].position = Vector2f(x_[i], y);
+        line[1].position = Vector2f(x_[i], y + LASER_LENGTH);
+        line[0].color = line[1].color = LASER_COLOR;
+    }
+
+    window.draw(&vertices_[0], count * 2, Lines);
+}
+
+void Lasers::clear() {
+    pool_.clear();
+    numAimed_ = 0;
+}
+
+unsigned int Lasers::getCount() const {
+    return pool_.getCount();
+}
+
+unsigned int Lasers::getNumCasts() const {
+    return numCasts_;
+}
+
+void Lasers::saveState(vector<GameState::LaserState>& states) const {
+    states.resize(pool_.getCount());
+    for (unsigned int i = 0; i < pool_.getCount(); ++i)
+        states[i] = GameState::LaserState{x_[i], y_[i]};
+}
+
+void Lasers::restoreState(double timer, const vector<GameState::LaserState>& states) {
+    clear();
+    timer_ = timer;
+    for (const GameState::LaserState& state : states)
+        fire(state.x, state.y);
+}
+
+void Lasers::getMemoryUsage(MemoryReport& report) const {
+    report.add("lasers", pool_.getCount(), sizeof(Lasers) + LASER_CAPACITY * (3 * sizeof(float) + sizeof(long))
+                                           + pool_.getHeapBytes() + vertices_.capacity() * sizeof(Vertex));
+}
@@ -0,0 +1,137 @@
+/**
+ * \file Lasers.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a pool of laser shots fired up from the paddle, each aimed at a brick with a ray cast
+ */
+
+#ifndef BRICKBREAKER_LASERS_H
+#define BRICKBREAKER_LASERS_H
+
+#include <vector>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "BrickGrid.h"
+#include "FlaggedPool.h"
+#include "GameState.h"
+#include "MemoryReport.h"
+#include "Object.h"
+
+/**
+ * \class Lasers
+ * \brief A fixed size pool of shots flying straight up, stored one array per field, that never test a brick as they
+ *      move
+ *
+ * \details A shot only ever moves up, so the first brick above it is the one it hits. Rather than moving each shot and
+ *      testing it against the bricks around it, the grid is ray cast once per shot to find that brick, and the shot
+ *      keeps the brick's bottom edge as the height it hits at. The bricks only change when the grid is rebuilt, so
+ *      every shot is cast again then, all in one batch, and on any other tick moving the shots and finding the ones
+ *      that hit is a subtraction and a comparison each, done four at a time with SSE.
+ *
+ *      Shots that reach the top of the stage without hitting anything just disappear. Like PowerUps, the pool's count
+ *      and the flags picking out the shots that hit are kept by a FlaggedPool.
+ */
+class Lasers {
+public:
+    Lasers();
+
+    /**
+     * \brief Gives the paddle lasers until a game time, or for longer if it already has them until later
+     */
+    void power(double until);
+
+    /**
+     * \brief Returns the game time at which the paddle's lasers run out
+     */
+    double getTimer() const;
+
+    /**
+     * \brief Fires a shot straight up from a point
+     *
+     * \return false if the pool is full, in which case nothing is fired
+     */
+    bool fire(float x, float y);
+
+    /**
+     * \brief Moves every shot up a tick's worth, and removes the ones that hit a brick or left the stage
+     *
+     * \param objects   The game's objects
+     *        grid      The bricks by where they are, built from the same objects
+     *        top       The top of the stage
+     *        hits      Where the indices in objects of the bricks hit are written, with room for getCount() of them
+     *
+     * \return How many shots hit a brick
+     */
+    unsigned int update(const std::vector<Object*>& objects, const BrickGrid& grid, float top, long* hits);
+
+    /**
+     * \brief Draws every shot in one draw call
+     *
+     * \param alpha How far between the last tick and the next to draw them, as for Object::drawInterpolated()
+     */
+    void draw(sf::RenderWindow& window, float alpha);
+
+    /**
+     * \brief Removes every shot, leaving the paddle's lasers as they are
+     */
+    void clear();
+
+    /**
+     * \brief Returns the number of shots flying
+     */
+    unsigned int getCount() const;
+
+    /**
+     * \brief Returns the number of ray casts done by the last call to update(), for the profiler
+     */
+    unsigned int getNumCasts() const;
+
+    /**
+     * \brief Copies every shot into a snapshot
+     */
+    void saveState(std::vector<GameState::LaserState>& states) const;
+
+    /**
+     * \brief Replaces the shots with those in a snapshot, and the paddle's lasers with the snapshot's timer
+     */
+    void restoreState(double timer, const std::vector<GameState::LaserState>& states);
+
+    /**
+     * \brief Adds the pool to a report as one entry
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+private:
+    /**
+     * \brief Finds the brick a shot hits, if any, and the height it hits at
+     */
+    void aim(unsigned int index, const std::vector<Object*>& objects, const BrickGrid& grid, float top);
+
+    // One entry per shot in each, only the first pool_.getCount() are live
+    std::vector<float> x_, y_;
+    std::vector<float> impact_;         ///< Height of the bottom of the brick the shot hits, or the top of the stage
+    std::vector<long> targets_;         ///< Index in the game's objects of the brick the shot hits, -1 for none
+    FlaggedPool pool_;
+
+    std::vector<sf::Vertex> vertices_;  ///< Two per shot, only allocated once the pool is first drawn
+
+    unsigned int numAimed_;             ///< Shots before this have been aimed, those fired since haven't
+    unsigned long aimedVersion_;        ///< The grid version they were aimed with
+    unsigned int numCasts_;
+    double timer_;                      ///< The game time at which the paddle's lasers run out
+};
+
+const unsigned int LASER_CAPACITY = 1024;       ///< Most shots flying at once, a multiple of four
+
+const float LASER_SPEED = 12;                   ///< How far shots fly each tick
+
+const float LASER_LENGTH = 10;                  ///< How long shots are drawn
+
+const float LASER_TIME = 10;                    ///< In seconds, how long the paddle has lasers for
+
+const float LASER_FIRE_INTERVAL = 0.25f;        ///< In seconds, how often the paddle fires while it has lasers
+
+#endif //BRICKBREAKER_LASERS_H
@@ -0,0 +1,261 @@
+/**
+ * \file LoadTester.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a client that opens many sessions on a game server at once
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Constants.h"
+#include "LoadTester.h"
+#include "Socket.h"
+
+using namespace sf;
+
+LoadTester::LoadTester(const std::string& address, unsigned int numClients, unsigned int spectatorsPerClient)
+        : address_(address),
+          numClients_(numClients),
+          spectatorsPerClient_(spectatorsPerClient),
+          epoll_(-1),
+          numConnected_(0),
+          numSpectators_(0),
+          spectatorBytesReceived_(0),
+          numSpectatorKeyframes_(0),
+          numDisconnected_(0),
+          numKeyframes_(0),
+          numDeltas_(0),
+          numMissedTicks_(0),
+          bytesReceived_(0),
+          bytesSent_(0),
+          seconds_(0)
+{
+}
+
+LoadTester::~LoadTester() {
+    for (Client* client : clients_) {
+        if (client->fd >= 0)
+            close(client->fd);
+        delete client;
+    }
+}
+
+bool LoadTester::run(double seconds) {
+    Socket::raiseFileLimit();
+
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_ < 0)
+        return false;
+
+    // Spectators connect once their player's session id arrives
+    for (unsigned int i = 0; i < numClients_ && connect(0); ++i) {
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(seconds));
+
+    epoll_event events[256];
+    while (numDisconnected_ < clients_.size() && std::chrono::steady_clock::now() < end) {
+        int timeout = int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                end - std::chrono::steady_clock::now()).count());
+        int numEvents = epoll_wait(epoll_, events, 256, std::max(timeout, 0));
+
+        for (int i = 0; i < numEvents; ++i) {
+            Client& client = *static_cast<Client*>(events[i].data.ptr);
+            if (client.fd >= 0 && !read(client)) {
+                epoll_ctl(epoll_, EPOLL_CTL_DEL, client.fd, nullptr);
+                close(client.fd);
+                client.fd = -1;
+                ++numDisconnected_;
+            }
+        }
+    }
+
+    seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(epoll_);
+    return numConnected_ > 0;
+}
+
+bool LoadTester::connect(unsigned long sessionId) {
+    int fd = Socket::connect(address_);
+    if (fd < 0)
+        return false;
+
+    Client* client = new Client();
+    client->fd = fd;
+    client->spectator = sessionId != 0;
+    client->heldKey = Keyboard::Unknown;
+    client->tappedKey = Keyboard::Unknown;
+    client->messagesUntilSpace = 0;
+    clients_.push_back(client);
+
+    if (client->spectator)
+        ++numSpectators_;
+    else
+        ++numConnected_;
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = client;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+
+    message_.clear();
+    MessageWriter writer(message_, client->spectator ? MESSAGE_WATCH : MESSAGE_PLAY);
+    if (client->spectator)
+        writer.writeVarint(uint32_t(sessionId));
+    writer.finish();
+    send(*client, message_);
+
+    return true;
+}
+
+bool LoadTester::read(Client& client) {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t numRead = ::read(client.fd, buffer, sizeof(buffer));
+        if (numRead > 0) {
+            bytesReceived_ += numRead;
+            if (client.spectator)
+                spectatorBytesReceived_ += numRead;
+            client.input.insert(client.input.end(), buffer, buffer + numRead);
+        }
+        else if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (numRead < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    while (MessageReader::next(client.input.data(), client.input.size(), offset, type, payload)) {
+        // Once a player knows its session's id, its spectators can connect
+        if (type == MESSAGE_WELCOME) {
+            unsigned long sessionId = payload.readVarint();
+            for (unsigned int i = 0; !client.spectator && i < spectatorsPerClient_ && connect(sessionId); ++i) {
+            }
+            continue;
+        }
+
+        unsigned long previousTick = client.decoder.getState().tick;
+        bool hadKeyframe = client.decoder.hasKeyframe();
+
+        if (!client.decoder.apply(type, payload)) {
+            std::cerr << "Client " << client.fd << " got a malformed message" << std::endl;
+            return false;
+        }
+
+        if (type == MESSAGE_KEYFRAME) {
+            ++numKeyframes_;
+            if (client.spectator)
+                ++numSpectatorKeyframes_;
+        }
+        else if (type == MESSAGE_DELTA) {
+            ++numDeltas_;
+        }
+
+        // Several ticks can be stepped at once when the server falls behind, but they should never go backwards
+        unsigned long tick = client.decoder.getState().tick;
+        if (hadKeyframe && tick > previousTick + 1)
+            numMissedTicks_ += tick - previousTick - 1;
+
+        if (!client.spectator)
+            play(client);
+    }
+    client.input.erase(client.input.begin(), client.input.begin() + offset);
+
+    return true;
+}
+
+void LoadTester::play(Client& client) {
+    const GameState& state = client.decoder.getState();
+
+    // Finish a tap started last message
+    if (client.tappedKey != Keyboard::Unknown) {
+        sendKey(client, Event::KeyReleased, client.tappedKey);
+        client.tappedKey = Keyboard::Unknown;
+        return;
+    }
+
+    if (state.status == 'o') {
+        client.tappedKey = Keyboard::Return;
+        sendKey(client, Event::KeyPressed, Keyboard::Return);
+        return;
+    }
+
+    if (state.status != '\0')
+        return;
+
+    if (client.messagesUntilSpace == 0) {
+        client.messagesUntilSpace = LOAD_TEST_SPACE_INTERVAL;
+        client.tappedKey = Keyboard::Space;
+        sendKey(client, Event::KeyPressed, Keyboard::Space);
+        return;
+    }
+    --client.messagesUntilSpace;
+
+    // Stay under the lowest ball
+    const GameState::BallState* lowest = nullptr;
+    for (const GameState::BallState& ball : state.balls) {
+        if (lowest == nullptr || ball.y > lowest->y)
+            lowest = &ball;
+    }
+
+    Keyboard::Key wantedKey = Keyboard::Unknown;
+    if (lowest != nullptr && lowest->x > state.paddle.x + PADDLE_WIDTH / 4)
+        wantedKey = Keyboard::L;
+    else if (lowest != nullptr && lowest->x < state.paddle.x - PADDLE_WIDTH / 4)
+        wantedKey = Keyboard::J;
+
+    if (wantedKey != client.heldKey) {
+        if (client.heldKey != Keyboard::Unknown)
+            sendKey(client, Event::KeyReleased, client.heldKey);
+        if (wantedKey != Keyboard::Unknown)
+            sendKey(client, Event::KeyPressed, wantedKey);
+        client.heldKey = wantedKey;
+    }
+}
+
+void LoadTester::sendKey(Client& client, Event::EventType type, Keyboard::Key key) {
+    message_.clear();
+    MessageWriter writer(message_, MESSAGE_INPUT);
+    writer.writeU8(uint8_t(type));
+    writer.writeU8(uint8_t(key));
+    writer.finish();
+    send(client, message_);
+}
+
+void LoadTester::send(Client& client, const std::vector<uint8_t>& message) {
+    ssize_t numSent = ::send(client.fd, message.data(), message.size(), MSG_NOSIGNAL);
+    if (numSent > 0)
+        bytesSent_ += numSent;
+}
+
+void LoadTester::writeSummary(std::ostream& out) const {
+    out << "Players: " << numConnected_ << " of " << numClients_ << " connected\n";
+    out << "Spectators: " << numSpectators_ << " of " << numConnected_ * spectatorsPerClient_ << " connected\n";
+    out << "Disconnected early: " << numDisconnected_ << "\n";
+    out << "Messages: " << numKeyframes_ << " keyframes (" << numSpectatorKeyframes_ << " to spectators), "
+        << numDeltas_ << " deltas, " << numMissedTicks_ << " ticks missed\n";
+
+    if (numConnected_ > 0 && seconds_ > 0) {
+        unsigned long playerBytes = bytesReceived_ - spectatorBytesReceived_;
+        out << "Received: " << bytesReceived_ << " bytes, " << playerBytes / seconds_ / numConnected_
+            << " bytes/s per player";
+        if (numSpectators_ > 0)
+            out << ", " << spectatorBytesReceived_ / seconds_ / numSpectators_ << " bytes/s per spectator";
+        out << "\nSent: " << bytesSent_ << " bytes\n";
+    }
+}
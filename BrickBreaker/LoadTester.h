@@ -0,0 +1,127 @@
+/**
+ * \file LoadTester.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a client that opens many sessions on a game server at once
+ */
+
+#ifndef BRICKBREAKER_LOADTESTER_H
+#define BRICKBREAKER_LOADTESTER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <SFML/Window/Event.hpp>
+#include "StateDecoder.h"
+
+/**
+ * \class LoadTester
+ * \brief Connects many clients to a GameServer and plays each of their games from the decoded state stream
+ *
+ * \details Every client decodes every message it gets, so a run also checks that the server's stream decodes
+ *      cleanly and that no ticks go missing. Players play by holding J or L to stay under the lowest ball, tapping
+ *      space now and then to release attached balls, and pressing return when the game is over. Each player can
+ *      also have a number of spectators watching its game. Linux only, and built into the server's executable.
+ */
+class LoadTester {
+public:
+    /**
+     * \brief Parametrized constructor for a load tester
+     *
+     * \param address               The server's address (see Socket for the format)
+     *        numClients            How many sessions to open
+     *        spectatorsPerClient   How many spectators watch each session
+     */
+    LoadTester(const std::string& address, unsigned int numClients, unsigned int spectatorsPerClient = 0);
+
+    LoadTester(const LoadTester&) = delete;
+    LoadTester& operator=(const LoadTester&) = delete;
+
+    /**
+     * \brief Disconnects every client
+     */
+    ~LoadTester();
+
+    /**
+     * \brief Connects the clients and plays for a number of seconds
+     *
+     * \return false if no client could connect
+     */
+    bool run(double seconds);
+
+    /**
+     * \brief Writes how many messages and bytes each client got and any problems found in the stream
+     */
+    void writeSummary(std::ostream& out) const;
+
+private:
+    /**
+     * \struct Client
+     * \brief One connection to the server and what it knows about its game
+     */
+    struct Client {
+        int fd;
+        bool spectator;
+        StateDecoder decoder;
+        std::vector<uint8_t> input;         ///< Received bytes that don't make up a whole message yet
+        sf::Keyboard::Key heldKey;          ///< J, L or Unknown
+        sf::Keyboard::Key tappedKey;        ///< A key pressed last message that is released this message
+        unsigned int messagesUntilSpace;
+    };
+
+    /**
+     * \brief Reads and decodes everything available from a client's socket, answering each message with input
+     *
+     * \return false if the connection closed or the stream was malformed
+     */
+    bool read(Client& client);
+
+    /**
+     * \brief Opens a connection and sends its first message
+     *
+     * \param sessionId     The session to watch, or 0 to play a new one
+     *
+     * \return false if the connection couldn't be made
+     */
+    bool connect(unsigned long sessionId);
+
+    /**
+     * \brief Decides what keys to send after a message
+     */
+    void play(Client& client);
+
+    void sendKey(Client& client, sf::Event::EventType type, sf::Keyboard::Key key);
+
+    /**
+     * \brief Sends a message without waiting. Client messages are tiny, so one that doesn't fit means the server is
+     *      gone anyway.
+     */
+    void send(Client& client, const std::vector<uint8_t>& message);
+
+    std::string address_;
+    unsigned int numClients_;
+    unsigned int spectatorsPerClient_;
+    std::vector<Client*> clients_;
+    std::vector<uint8_t> message_;          ///< Reused for every message sent
+    int epoll_;
+
+    // Statistics
+    unsigned long numConnected_;
+    unsigned long numSpectators_;
+    unsigned long spectatorBytesReceived_;
+    unsigned long numSpectatorKeyframes_;
+    unsigned long numDisconnected_;         ///< Clients whose connection closed or whose stream didn't decode
+    unsigned long numKeyframes_;
+    unsigned long numDeltas_;
+    unsigned long numMissedTicks_;          ///< Ticks skipped between consecutive messages to the same client
+    unsigned long bytesReceived_;
+    unsigned long bytesSent_;
+    double seconds_;
+};
+
+const unsigned int LOAD_TEST_SPACE_INTERVAL = 30;   ///< Messages between taps of the space bar
+
+#endif //BRICKBREAKER_LOADTESTER_H
@@ -0,0 +1,42 @@
+/**
+ * \file MemoryReport.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a report of how much memory each part of a game uses
+ */
+#include <cstdio>
+#include <SFML/Graphics/Vertex.hpp>
+#include "MemoryReport.h"
+
+void MemoryReport::add(const char* name, unsigned long objects, unsigned long bytes) {
+    Entry entry = {name, objects, bytes};
+    entries_.push_back(entry);
+}
+
+unsigned long MemoryReport::getTextHeapBytes(const sf::Text& text) {
+    return text.getString().getSize() * (sizeof(sf::Uint32) + 4 * sizeof(sf::Vertex));
+}
+
+unsigned long MemoryReport::getTotalBytes() const {
+    unsigned long total = 0;
+    for (const Entry& entry : entries_)
+        total += entry.bytes;
+    return total;
+}
+
+void MemoryReport::write(std::ostream& out) const {
+    char line[128];
+    snprintf(line, sizeof(line), "%-20s %10s %12s\n", "subsystem", "objects", "bytes");
+    out << line;
+
+    for (const Entry& entry : entries_) {
+        snprintf(line, sizeof(line), "%-20s %10lu %12lu\n", entry.name, entry.objects, entry.bytes);
+        out << line;
+    }
+
+    snprintf(line, sizeof(line), "%-20s %10s %12lu\n", "total", "", getTotalBytes());
+    out << line;
+}
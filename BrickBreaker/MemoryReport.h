@@ -0,0 +1,64 @@
+/**
+ * \file MemoryReport.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a report of how much memory each part of a game uses
+ */
+
+#ifndef BRICKBREAKER_MEMORYREPORT_H
+#define BRICKBREAKER_MEMORYREPORT_H
+
+#include <SFML/Graphics/Text.hpp>
+#include <ostream>
+#include <vector>
+
+/**
+ * \class MemoryReport
+ * \brief A list of subsystems with the number of live objects and bytes each one holds
+ *
+ * \details Each subsystem reports the memory it owns, so inline members are counted once as part of whatever object
+ *      contains them and heap storage is counted by the subsystem that owns it. Sizes are what the game asked for,
+ *      not including allocator overhead.
+ */
+class MemoryReport {
+public:
+    /**
+     * \brief Adds a subsystem's usage to the report
+     *
+     * \param name      A short name for the subsystem. Must outlive the report (string literals are expected).
+     *        objects   How many live objects the subsystem holds
+     *        bytes     How many bytes those objects use
+     */
+    void add(const char* name, unsigned long objects, unsigned long bytes);
+
+    /**
+     * \brief Estimates the heap memory held by a text object for its string and glyph vertices
+     *
+     * \details A text object keeps its string as 32 bit characters and four vertices for each character's glyph
+     */
+    static unsigned long getTextHeapBytes(const sf::Text& text);
+
+    /**
+     * \brief Returns the sum of every subsystem's bytes
+     */
+    unsigned long getTotalBytes() const;
+
+    /**
+     * \brief Writes one line per subsystem followed by the total
+     */
+    void write(std::ostream& out) const;
+
+private:
+    struct Entry {
+        const char* name;
+        unsigned long objects;
+        unsigned long bytes;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+#endif //BRICKBREAKER_MEMORYREPORT_H
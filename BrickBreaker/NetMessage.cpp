@@ -0,0 +1,136 @@
+/**
+ * \file NetMessage.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the framing and byte level encoding of messages between the game server and its clients
+ */
+#include "NetMessage.h"
+
+MessageWriter::MessageWriter(std::vector<uint8_t>& buffer, MessageType type)
+        : buffer_(buffer),
+          start_(buffer.size())
+{
+    // Leave room for the length, it is filled in by finish()
+    buffer_.push_back(0);
+    buffer_.push_back(0);
+    buffer_.push_back(type);
+}
+
+void MessageWriter::writeU8(uint8_t value) {
+    buffer_.push_back(value);
+}
+
+void MessageWriter::writeU16(uint16_t value) {
+    buffer_.push_back(uint8_t(value));
+    buffer_.push_back(uint8_t(value >> 8));
+}
+
+void MessageWriter::writeVarint(uint32_t value) {
+    while (value >= 0x80) {
+        buffer_.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(uint8_t(value));
+}
+
+void MessageWriter::writeBytes(const uint8_t* bytes, size_t size) {
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+}
+
+bool MessageWriter::finish() {
+    // The length covers the type byte and the payload
+    size_t length = buffer_.size() - start_ - 2;
+    if (length > MAX_MESSAGE_SIZE) {
+        buffer_.resize(start_);
+        return false;
+    }
+
+    buffer_[start_] = uint8_t(length);
+    buffer_[start_ + 1] = uint8_t(length >> 8);
+    return true;
+}
+
+MessageReader::MessageReader(const uint8_t* data, size_t size)
+        : data_(data),
+          size_(size),
+          position_(0),
+          valid_(true)
+{
+}
+
+uint8_t MessageReader::readU8() {
+    if (position_ + 1 > size_) {
+        valid_ = false;
+        return 0;
+    }
+    return data_[position_++];
+}
+
+uint16_t MessageReader::readU16() {
+    if (position_ + 2 > size_) {
+        valid_ = false;
+        return 0;
+    }
+    uint16_t value = uint16_t(data_[position_] | (data_[position_ + 1] << 8));
+    position_ += 2;
+    return value;
+}
+
+uint32_t MessageReader::readVarint() {
+    uint32_t value = 0;
+    for (unsigned int shift = 0; shift < 35; shift += 7) {
+        uint8_t byte = readU8();
+        value |= uint32_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    // More than 5 bytes can't be a 32 bit value
+    valid_ = false;
+    return 0;
+}
+
+const uint8_t* MessageReader::readBytes(size_t size) {
+    if (position_ + size > size_) {
+        valid_ = false;
+        return nullptr;
+    }
+    const uint8_t* bytes = data_ + position_;
+    position_ += size;
+    return bytes;
+}
+
+bool MessageReader::isValid() const {
+    return valid_;
+}
+
+bool MessageReader::atEnd() const {
+    return position_ == size_;
+}
+
+bool MessageReader::next(const uint8_t* data, size_t size, size_t& offset, MessageType& type,
+                         MessageReader& payload) {
+    if (size - offset < MESSAGE_HEADER_SIZE)
+        return false;
+
+    size_t length = data[offset] | (data[offset + 1] << 8);
+
+    // A message always has a type, so an empty one is malformed. Report it as type 0 so the caller can reject it.
+    if (length == 0) {
+        type = MessageType(0);
+        payload = MessageReader();
+        offset += 2;
+        return true;
+    }
+
+    if (size - offset - 2 < length)
+        return false;
+
+    type = MessageType(data[offset + 2]);
+    payload = MessageReader(data + offset + MESSAGE_HEADER_SIZE, length - 1);
+    offset += 2 + length;
+    return true;
+}
@@ -0,0 +1,135 @@
+/**
+ * \file NetMessage.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the framing and byte level encoding of messages between the game server and its clients
+ */
+
+#ifndef BRICKBREAKER_NETMESSAGE_H
+#define BRICKBREAKER_NETMESSAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief The kinds of message sent between the server and its clients, and between versus peers
+ *
+ * \details Every message is framed as a 2 byte little endian length, then a 1 byte type, then length - 1 bytes of
+ *      payload. Multi byte values are little endian, counts and ticks are variable length integers (7 bits per byte,
+ *      high bit set on every byte but the last).
+ */
+enum MessageType : uint8_t {
+    MESSAGE_INPUT = 1,      ///< Client to server: a key event. Payload is the event type and key as one byte each.
+    MESSAGE_KEYFRAME = 2,   ///< Server to client: everything visible in the game (see StateEncoder)
+    MESSAGE_DELTA = 3,      ///< Server to client: what changed since the previous keyframe or delta
+    MESSAGE_PLAY = 4,       ///< Client to server, first message only: start a new game. No payload.
+    MESSAGE_WATCH = 5,      ///< Client to server, first message only: spectate a game. Payload is its id (varint).
+    MESSAGE_WELCOME = 6,    ///< Server to client: the id of the game being played or watched (varint)
+
+    // Between the two peers of a versus match (see VersusSession)
+    MESSAGE_VERSUS_HELLO = 7,       ///< Host to guest, first message: the games' seed and the input delay (varints)
+    MESSAGE_VERSUS_INPUT = 8,       ///< The sender's input for a tick: the tick (varint) and its keys (one byte)
+    MESSAGE_VERSUS_CHECKSUM = 9,    ///< A hash of both games at the start of a confirmed tick: the tick, then the hash
+
+    MESSAGE_KEYFRAME_BRICKS = 10,   ///< Server to client: the rest of the bricks of the keyframe before it
+};
+
+/**
+ * \class MessageWriter
+ * \brief Appends one framed message to a byte buffer
+ *
+ * \details The header is written by the constructor and its length filled in by finish(), so the payload is written
+ *      straight into the buffer without an intermediate copy.
+ */
+class MessageWriter {
+public:
+    /**
+     * \brief Parametrized constructor for a message writer
+     *
+     * \param buffer    The buffer the message is appended to
+     *        type      The message's type
+     */
+    MessageWriter(std::vector<uint8_t>& buffer, MessageType type);
+
+    void writeU8(uint8_t value);
+    void writeU16(uint16_t value);
+    void writeVarint(uint32_t value);
+    void writeBytes(const uint8_t* bytes, size_t size);
+
+    /**
+     * \brief Fills in the message's length. Nothing may be written after this.
+     *
+     * \return false if the message is too long to frame, in which case it is removed from the buffer
+     */
+    bool finish();
+
+private:
+    std::vector<uint8_t>& buffer_;
+    size_t start_;      ///< Where this message's header starts in buffer_
+};
+
+/**
+ * \class MessageReader
+ * \brief Reads values from one message's payload
+ *
+ * \details Reading past the end returns zeros and marks the reader invalid instead of reading out of bounds, so a
+ *      decoder can read a whole message and check isValid() once at the end.
+ */
+class MessageReader {
+public:
+    /**
+     * \brief Parametrized constructor for a message reader
+     *
+     * \param data  The start of the payload
+     *        size  The payload's length in bytes
+     */
+    MessageReader(const uint8_t* data = nullptr, size_t size = 0);
+
+    uint8_t readU8();
+    uint16_t readU16();
+    uint32_t readVarint();
+
+    /**
+     * \brief Returns a pointer to the next size bytes and skips past them, or nullptr if there aren't that many
+     */
+    const uint8_t* readBytes(size_t size);
+
+    /**
+     * \brief Returns false if any read went past the end of the payload
+     */
+    bool isValid() const;
+
+    /**
+     * \brief Returns true if every byte of the payload has been read
+     */
+    bool atEnd() const;
+
+    /**
+     * \brief Finds the next complete message in a buffer of received bytes
+     *
+     * \param data      The received bytes
+     *        size      How many bytes were received
+     *        offset    Where to look for the next message. Moved past the message if one is found.
+     *        type      Set to the message's type
+     *        payload   Set to read the message's payload
+     *
+     * \return true if a whole message was found, false if more bytes are needed
+     */
+    static bool next(const uint8_t* data, size_t size, size_t& offset, MessageType& type, MessageReader& payload);
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_;
+    bool valid_;
+};
+
+const size_t MESSAGE_HEADER_SIZE = 3;       ///< Length and type
+
+const size_t MAX_MESSAGE_SIZE = 65535;      ///< Largest length that fits in the header, including the type byte
+
+#endif //BRICKBREAKER_NETMESSAGE_H
@@ -16,6 +16,9 @@
 /**
  * \class Object
  * \brief An abstract class to categorize objects that can be drawn and possibly moved
+ *
+ * \details Objects that collide each give their shape from a getShape() (see Collision.h), so which test runs between
+ *      two of them is decided by their types at compile time rather than through this class.
  */
 
 class Object {
@@ -31,27 +34,23 @@ public:
     virtual void draw(sf::RenderWindow& window) const = 0;
 
     /**
-     * \brief Updates the object's position (could mean not moving at all). Normally ran every frame.
+     * \brief Draws the object part way through the last tick, for frames that fall between two ticks
+     *
+     * \details Objects that don't move just draw themselves where they are
+     *
+     * \param alpha  0 to draw the object where it was at the start of the last tick, 1 to draw it where it is now
      */
-    virtual void move() {};
+    virtual void drawInterpolated(sf::RenderWindow& window, float /*alpha*/) const { draw(window); }
 
     /**
-     * \brief   Determines if another object collides with this one and returns the collision type
-     *
-     * \details Uses SFML's built in intersects() method to determine if two object's boundary boxes overlap,
-     *      then determines the relative positions of the objects to return the collision type. For corner and circle
-     *      collisions, the "top" and "left" values of the referenced boundingBox are updated to store the value of the
-     *      corner's coordinates or the other ball's initial velocity. This data is then used in collision handling for
-     *      the other object.
-     *
-     * \returns One of the following characters:
-     *      'n' : No collision occurred
-     *      'y' : A collision occurred, but not in a simple direction (i.e. two circles)
-     *      'v' : The other object hit this object's top or bottom edge (a vertical collision)
-     *      'h' : The other object hit this object's left or right edge (a horizontal collision)
-     *      'c' : The other object hit a corner of this object
+     * \brief Returns how many draw calls draw() makes. Used for profiling.
+     */
+    virtual unsigned int getNumDrawCalls() const { return 1; };
+
+    /**
+     * \brief Updates the object's position (could mean not moving at all). Normally ran every frame.
      */
-    virtual const char collision(sf::FloatRect& boundingBox) const = 0;
+    virtual void move() {};
 
     /**
      * \brief If true, this object should be deleted on the next frame. Otherwise it should not.
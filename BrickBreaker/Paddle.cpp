@@ -8,8 +8,10 @@
  * \brief Implements a paddle, an object sub type
  */
 
+#include <algorithm>
 #include <math.h>
 #include "Paddle.h"
+#include "Barrier.h"
 
 using namespace std;
 using namespace sf;
@@ -21,17 +23,18 @@ Paddle::Paddle(GraphicsRunner& game, float xPos, float yPos, float width, float
           rightCircle_(height / 2, 50),
           vel_(0),
           accel_(0),
-          timer_(time(0) - 30) // Just to make sure that the timer is behind us when we start
+          orientation_(NUM_PADDLE_ORIENTATIONS / 2),
+          timer_(0), // Game time starts at 0, so the timer is already over
+          previousPosition_(xPos, yPos)
 {
     // The origin of the paddle is on the top halfway along its width, the origin for the circles is their center
     rectangle_.setOrigin(width / 2, 0);
     leftCircle_.setOrigin(height / 2, height / 2);
     rightCircle_.setOrigin(height / 2, height / 2);
 
-    // Position the circles on the ends of the rectangle
+    // Position the capsule and the circles on the ends of the rectangle
     rectangle_.setPosition(xPos, yPos);
-    leftCircle_.setPosition(xPos - width / 2, yPos + height / 2);
-    rightCircle_.setPosition(xPos + width / 2, yPos + height / 2);
+    updateCapsule();
 
     rectangle_.setFillColor(color);
     leftCircle_.setFillColor(color);
@@ -44,21 +47,40 @@ void Paddle::draw(RenderWindow &window) const {
     window.draw(rightCircle_);
 }
 
+unsigned int Paddle::getNumDrawCalls() const {
+    return 3;
+}
+
+void Paddle::drawInterpolated(RenderWindow& window, float alpha) const {
+    Transform transform;
+    transform.translate((previousPosition_ - rectangle_.getPosition()) * (1 - alpha));
+    window.draw(rectangle_, transform);
+    window.draw(leftCircle_, transform);
+    window.draw(rightCircle_, transform);
+}
+
+void Paddle::rememberPosition() {
+    previousPosition_ = rectangle_.getPosition();
+}
+
 void Paddle::move() {
     // If the elongation timer is over, return the paddle to normal
-    if (difftime(time(0), timer_) == 0) {
+    if (game_.getGameTime() >= timer_ && rectangle_.getSize().x != PADDLE_WIDTH) {
         changeLength(false);
     }
 
-    // A reference is needed for the call to collision()
-    FloatRect leftCircle = leftCircle_.getGlobalBounds();
-    FloatRect rightCircle = rightCircle_.getGlobalBounds();
-    FloatRect rectangle = rectangle_.getGlobalBounds();
-
-    // Paddle only needs to check for a collision with the barrier
-    if (game_.getBarrier()->collision(leftCircle) != 'n' || game_.getBarrier()->collision(rightCircle) != 'n'
-            || game_.getBarrier()->collision(rectangle) != 'n') {
-        handleCollision();
+    // Paddle only needs to check for a collision with the barrier, using the box around its capsule
+    Box bounds{min(capsuleStart_.x, capsuleEnd_.x) - capsuleRadius_,
+               min(capsuleStart_.y, capsuleEnd_.y) - capsuleRadius_,
+               max(capsuleStart_.x, capsuleEnd_.x) + capsuleRadius_,
+               max(capsuleStart_.y, capsuleEnd_.y) + capsuleRadius_};
+    const Box* walls = static_cast<Barrier*>(game_.getBarrier())->getWalls();
+    Contact contact;
+    for (unsigned int i = 0; i < NUM_BARRIER_WALLS; ++i) {
+        if (collide(bounds, walls[i], contact)) {
+            handleCollision();
+            break;
+        }
     }
 
     // Apply acceleration
@@ -70,79 +92,29 @@ void Paddle::move() {
     // Move the paddle left or right based on the velocity
     rectangle_.move(vel_, 0);
 
-    // Move the circular sides to the edges of the paddle using some temporary variables to prevent unnecessary calls
+    updateCapsule();
+}
+
+void Paddle::updateCapsule() {
+    // Move the segment's ends, and the circular sides drawn around them, to the edges of the paddle using some
+    // temporary variables to prevent unnecessary calls
     const Vector2f& size = rectangle_.getSize();
     Vector2f center(rectangle_.getPosition().x, rectangle_.getPosition().y + size.y/2);
-    float rotation = rectangle_.getRotation()*.017453294f; // Convert to radians
-
-    leftCircle_.setPosition(center.x - size.x/2*cosf(rotation), center.y - size.x/2*sinf(rotation));
-    rightCircle_.setPosition(center.x + size.x/2*cosf(rotation), center.y + size.x/2*sinf(rotation));
-}
-
-const char Paddle::collision(sf::FloatRect& boundingBox) const {
-    // First check for collision with the rectangular part of the paddle, so get that part's bounds
-    FloatRect rectBounds = rectangle_.getGlobalBounds();
-
-    // If the incoming object is within the paddle's bounding box and is between the sides, do further checking
-    if (rectBounds.intersects(boundingBox) && boundingBox.left + boundingBox.width/2 > leftCircle_.getPosition().x
-                                           && boundingBox.left + boundingBox.width/2 < rightCircle_.getPosition().x) {
-        // This math calculates the distance of the center of the incoming object to the line cutting lengthwise through
-        // the rectangle of the paddle.
-        float ax = boundingBox.left + boundingBox.width/2 - leftCircle_.getPosition().x;
-        float ay = leftCircle_.getPosition().y - (boundingBox.top + boundingBox.width/2);
-        float bx = rightCircle_.getPosition().x - leftCircle_.getPosition().x;
-        float by = leftCircle_.getPosition().y - rightCircle_.getPosition().y;
-        float projFactor = (ax*bx + ay*by)/(bx*bx + by*by);
-        float dist = powf(powf(ax - bx*projFactor, 2) + powf(ay - by*projFactor, 2), .5);
-
-        // If the distance is less than the radius of the incoming object plus half the width of the paddle, it has hit
-        if (dist < boundingBox.width/2 + rectangle_.getSize().y/2) {
-            // a collision has occurred so store velocity and position data in the bounding box and return out
-            boundingBox.left = rectangle_.getRotation(); // Rotation needed for the incoming ball's collision handling
-            boundingBox.width = vel_;
-            boundingBox.height = 0;
-            return 'v';
-        }
-    }
-
-    // Next check for possible side circle collision
-    FloatRect leftCircleBounds = leftCircle_.getGlobalBounds();
-    FloatRect rightCircleBounds = rightCircle_.getGlobalBounds();
-
-    // This boolean prevents calling intersects() twice
-    bool temp = leftCircleBounds.intersects(boundingBox);
-
-    // If the ball hits one of the circles on the side of the paddle
-    if ( temp || rightCircleBounds.intersects(boundingBox)) {
-        Vector2f thisCenter;
-
-        // If the left circle was hit
-        if (temp) {
-            thisCenter = leftCircle_.getPosition();
-        }
-            // If the right circle was hit
-        else {
-            thisCenter = rightCircle_.getPosition();
-        }
-
-        // Get the center of the incoming circle
-        Vector2f otherCenter(boundingBox.left + boundingBox.width / 2, boundingBox.top + boundingBox.height / 2);
+    Vector2f halfLength(PADDLE_ORIENTATIONS[orientation_].directionX * size.x/2,
+                        PADDLE_ORIENTATIONS[orientation_].directionY * size.x/2);
 
-        // If the distance between the two circles is less than the sum of their radii
-        if (powf(powf(thisCenter.x - otherCenter.x, 2) + powf(thisCenter.y - otherCenter.y, 2), .5)
-            < boundingBox.width / 2 + rightCircle_.getRadius()) {
+    capsuleStart_ = center - halfLength;
+    capsuleEnd_ = center + halfLength;
+    capsuleRadius_ = size.y/2;
 
-            // a collision has occurred so store velocity and position data in the bounding box and return out
-            boundingBox.left = thisCenter.x;
-            boundingBox.top = thisCenter.y;
-            boundingBox.width = vel_;
-            boundingBox.height = 0;
-            return 's';
-        }
-
-    }
+    leftCircle_.setPosition(capsuleStart_);
+    rightCircle_.setPosition(capsuleEnd_);
+}
 
-    return 'n';     // Otherwise no collision
+Capsule Paddle::getShape() const {
+    const PaddleOrientation& orientation = PADDLE_ORIENTATIONS[orientation_];
+    return Capsule{capsuleStart_, capsuleEnd_, capsuleRadius_, Vector2f(orientation.normalX, orientation.normalY),
+                   Vector2f(vel_, 0)};
 }
 
 void Paddle::processKey(const Event::EventType &type, const Keyboard::Key &key) {
@@ -174,6 +146,18 @@ const sf::Vector2f* Paddle::getPos() const {
     return &rectangle_.getPosition();
 }
 
+float Paddle::getRotation() const {
+    return PADDLE_ORIENTATIONS[orientation_].rotation;
+}
+
+const PaddleOrientation& Paddle::getOrientation() const {
+    return PADDLE_ORIENTATIONS[orientation_];
+}
+
+float Paddle::getVelocity() const {
+    return vel_;
+}
+
 void Paddle::handleCollision() {
     // If the paddle is on the left half of the stage, move it to the right
     if (rectangle_.getPosition().x < game_.windowSize_.x/2) {
@@ -189,29 +173,55 @@ void Paddle::handleCollision() {
 }
 
 void Paddle::rotate(bool direction) {
-    // This turns rotations counter clockwise into negative degrees
-    float rotation = rectangle_.getRotation();
-    if (rotation > PADDLE_MAX_ROTATION) {
-        rotation -= 360;
-    }
-
     // Don't rotate further than the maximum paddle rotation
-    if ((direction && rotation < PADDLE_MAX_ROTATION) || (!direction && rotation > -PADDLE_MAX_ROTATION)) {
-        // 3 is the amount to increment for each key press
-        rectangle_.rotate(3*(direction*2-1));
+    int orientation = orientation_ + (direction ? 1 : -1);
+    if (orientation >= 0 && orientation < NUM_PADDLE_ORIENTATIONS) {
+        orientation_ = orientation;
+        rectangle_.setRotation(PADDLE_ORIENTATIONS[orientation_].rotation);
+        updateCapsule();
     }
 }
 
 void Paddle::changeLength(bool type) {
     // Only elongate if the existing timer has passed
-    if (type && difftime(time(0), timer_) > 0) {
+    if (type && game_.getGameTime() >= timer_) {
         // Elongate the paddle for the appropriate amount of time
-        timer_ = time(0) + PADDLE_ELONGATION_TIME;
+        timer_ = game_.getGameTime() + PADDLE_ELONGATION_TIME;
         rectangle_.setSize(Vector2f(PADDLE_WIDTH * PADDLE_ELONGATION_FACTOR, rectangle_.getSize().y));
         rectangle_.setOrigin(rectangle_.getSize().x / 2, 0);
+        updateCapsule();
     }
     else if (!type && rectangle_.getSize().x != PADDLE_WIDTH) {
         rectangle_.setSize(Vector2f(PADDLE_WIDTH, rectangle_.getSize().y));
         rectangle_.setOrigin(rectangle_.getSize().x / 2, 0);
+        updateCapsule();
     }
 }
+
+void Paddle::saveState(GameState::PaddleState& state) const {
+    state.x = rectangle_.getPosition().x;
+    state.y = rectangle_.getPosition().y;
+    state.rotation = rectangle_.getRotation();
+    state.width = rectangle_.getSize().x;
+    state.vel = vel_;
+    state.accel = accel_;
+    state.timer = timer_;
+}
+
+void Paddle::restoreState(const GameState::PaddleState& state) {
+    rectangle_.setSize(Vector2f(state.width, rectangle_.getSize().y));
+    rectangle_.setOrigin(state.width / 2, 0);
+    rectangle_.setPosition(state.x, state.y);
+    previousPosition_ = rectangle_.getPosition();
+    rectangle_.setRotation(state.rotation);
+
+    // Snapshots hold the rotation as drawn, from 0 to 360 degrees, so turn it back into one of the orientations
+    float rotation = state.rotation > PADDLE_MAX_ROTATION ? state.rotation - 360 : state.rotation;
+    orientation_ = int(lroundf(rotation / PADDLE_ROTATION_STEP)) + NUM_PADDLE_ORIENTATIONS / 2;
+    orientation_ = min(max(orientation_, 0), NUM_PADDLE_ORIENTATIONS - 1);
+    vel_ = state.vel;
+    accel_ = state.accel;
+    timer_ = state.timer;
+
+    updateCapsule();
+}
@@ -18,10 +18,17 @@
 #include "Ball.h"
 #include "Constants.h"
 #include "GraphicsRunner.h"
+#include "GameState.h"
+#include "PaddleOrientation.h"
+#include "Collision.h"
 
 /**
  * \class Paddle
  * \brief A thin paddle that can be moved along the bottom of the screen using arrow keys
+ *
+ * \details Drawn as a rectangle with a circle on each end, and collided with as the capsule those make: every point
+ *      within half the paddle's height of the segment joining the circles' centers. The segment is moved along with
+ *      the paddle whenever it moves, rotates or changes length.
  */
 class Paddle : public Object {
 public:
@@ -43,6 +50,23 @@ public:
      */
     void draw(sf::RenderWindow& window) const;
 
+    /**
+     * \brief Returns 3 since the paddle is drawn as three shapes
+     */
+    unsigned int getNumDrawCalls() const;
+
+    /**
+     * \brief Draws the paddle between where it was at the start of the last tick and where it is now
+     *
+     * \details Only the position is interpolated. Rotation comes straight from key presses so it is drawn as it is.
+     */
+    void drawInterpolated(sf::RenderWindow& window, float alpha) const;
+
+    /**
+     * \brief Remembers where the paddle is as the start of the next tick, for drawInterpolated()
+     */
+    void rememberPosition();
+
     /**
      * \brief Moves the paddle left or right based on its velocity and runs collision checking with the barrier
      *
@@ -51,23 +75,9 @@ public:
     void move();
 
     /**
-     * \brief Checks if a ball is colliding with the paddle
-     *
-     * \details If the ball hit the top of the paddle, it is a simple vertical collision. If the ball hit one of the
-     *      paddle's circular sides, update the passed by reference boundingBox to contain the center of the impacted
-     *      circle and the paddle's velocity.
-     *
-     * \param boundingBox A reference to the rectangular bounding box for the incoming object. Also used as a way to
-     *                    "return" more information than just the collision type.
-     *
-     * \return 'v' if the ball hit the top or bottom of the paddle, 's' if it hit the sides, 'n' otherwise.
-     *      If a collision has occurred, "boundingBox" is updated with the following data:
-     *      boundingBox.left stores the collided circle's x position
-     *      boundingBox.top stores the collided circle's y position
-     *      boundingBox.width stores this paddle's x velocity
-     *      boundingBox.height stores this paddle's y velocity
+     * \brief Returns the capsule balls collide with, moving with the paddle's velocity
      */
-    const char collision(sf::FloatRect& boundingBox) const;
+    Capsule getShape() const;
 
     /**
      * \brief Handles user input to move the paddle left and right
@@ -87,10 +97,26 @@ public:
      */
     const sf::Vector2f* getPos() const;
 
+    /**
+     * \brief Returns the paddle's rotation in degrees, negative when rotated counter clockwise
+     */
+    float getRotation() const;
+
+    /**
+     * \brief Returns the geometry of the paddle's current rotation
+     */
+    const PaddleOrientation& getOrientation() const;
+
+    /**
+     * \brief Returns the paddle's x velocity
+     */
+    float getVelocity() const;
+
     /**
      * \brief Rotates the paddle slightly either clockwise or counter clockwise
      *
-     * \note Pivots 3 degrees around the top center point of the paddle, but wont go past the maximum allowed angle
+     * \note Pivots PADDLE_ROTATION_STEP degrees around the top center point of the paddle, but wont go past the maximum
+     *      allowed angle
      *
      * \param direction true to rotate one tick clockwise, false to rotate counter clockwise
      */
@@ -106,6 +132,16 @@ public:
      */
     void changeLength(bool type);
 
+    /**
+     * \brief Copies the paddle's position, rotation, size and motion into a snapshot
+     */
+    void saveState(GameState::PaddleState& state) const;
+
+    /**
+     * \brief Sets the paddle's position, rotation, size and motion from a snapshot
+     */
+    void restoreState(const GameState::PaddleState& state);
+
 private:
     /**
      * \brief Handles paddle-barrier collisions
@@ -114,16 +150,30 @@ private:
      */
     void handleCollision();
 
+    /**
+     * \brief Moves the capsule's segment, and the circular sides drawn around its ends, to the ends of the rectangle,
+     *      accounting for rotation
+     */
+    void updateCapsule();
+
     GraphicsRunner& game_;   ///< The game instance this object lies within
 
     sf::RectangleShape rectangle_;
     sf::CircleShape leftCircle_;
     sf::CircleShape rightCircle_;
 
+    sf::Vector2f capsuleStart_;     ///< Center of the left end of the paddle
+    sf::Vector2f capsuleEnd_;       ///< Center of the right end of the paddle
+    float capsuleRadius_;           ///< Half the paddle's height
+
     float vel_;         ///< Y velocity will always be 0 since the paddle can only move left and right
     float accel_;       ///< The x acceleration of the paddle
 
-    time_t timer_;      ///< Used to handle paddle elongation timing
+    int orientation_;   ///< Index in PADDLE_ORIENTATIONS of the paddle's rotation
+
+    double timer_;      ///< The game time at which the paddle elongation ends
+
+    sf::Vector2f previousPosition_;     ///< Where the paddle was at the start of the last tick
 };
 
 #endif //BRICKBREAKER_PADDLE_H
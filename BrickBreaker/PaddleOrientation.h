@@ -0,0 +1,72 @@
+/**
+ * \file PaddleOrientation.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Defines the geometry of each rotation the paddle can have, worked out at compile time
+ */
+
+#ifndef BRICKBREAKER_PADDLEORIENTATION_H
+#define BRICKBREAKER_PADDLEORIENTATION_H
+
+#include "Constants.h"
+
+/**
+ * \struct PaddleOrientation
+ * \brief One of the rotations the paddle can have, with everything collisions need to know about it
+ *
+ * \details The paddle turns PADDLE_ROTATION_STEP degrees at a time up to PADDLE_MAX_ROTATION either way, so there are
+ *      only NUM_PADDLE_ORIENTATIONS of these. PADDLE_ORIENTATIONS holds them all, from fully counter clockwise to fully
+ *      clockwise, so neither the paddle nor balls bouncing off it need any trigonometry while the game runs.
+ */
+struct PaddleOrientation {
+    float rotation;             ///< In degrees, negative when rotated counter clockwise
+    float directionX;           ///< Along the paddle from its left end to its right, of length 1
+    float directionY;
+    float normalX;              ///< Out of the paddle's bottom, of length 1
+    float normalY;
+    float reflection[4];        ///< Reflects a velocity off the paddle's flat sides, row by row
+};
+
+const int PADDLE_ROTATION_STEP = 3;             ///< How many degrees the paddle turns per key press
+
+const int NUM_PADDLE_ORIENTATIONS = 2 * int(PADDLE_MAX_ROTATION) / PADDLE_ROTATION_STEP + 1;
+
+// Sine and cosine as series, which are exact to a float's precision for angles as small as the paddle's
+constexpr double orientationSin(double x) {
+    return x * (1 - x * x / 6 * (1 - x * x / 20 * (1 - x * x / 42 * (1 - x * x / 72 * (1 - x * x / 110)))));
+}
+
+constexpr double orientationCos(double x) {
+    return 1 - x * x / 2 * (1 - x * x / 12 * (1 - x * x / 30 * (1 - x * x / 56 * (1 - x * x / 90))));
+}
+
+constexpr PaddleOrientation makePaddleOrientation(double degrees, double sin, double cos) {
+    // The normal is the direction turned a quarter clockwise, and reflecting is I - 2 * normal * normal^T
+    return PaddleOrientation{float(degrees), float(cos), float(sin), float(-sin), float(cos),
+                             {float(1 - 2 * sin * sin), float(2 * sin * cos),
+                              float(2 * sin * cos), float(1 - 2 * cos * cos)}};
+}
+
+constexpr PaddleOrientation makePaddleOrientation(int index) {
+    return makePaddleOrientation((index - NUM_PADDLE_ORIENTATIONS / 2) * PADDLE_ROTATION_STEP,
+                                 orientationSin((index - NUM_PADDLE_ORIENTATIONS / 2) * PADDLE_ROTATION_STEP
+                                                * 3.14159265358979323846 / 180),
+                                 orientationCos((index - NUM_PADDLE_ORIENTATIONS / 2) * PADDLE_ROTATION_STEP
+                                                * 3.14159265358979323846 / 180));
+}
+
+/// Every rotation the paddle can have, indexed from 0 (fully counter clockwise) to NUM_PADDLE_ORIENTATIONS - 1
+constexpr PaddleOrientation PADDLE_ORIENTATIONS[] = {
+        makePaddleOrientation(0), makePaddleOrientation(1), makePaddleOrientation(2), makePaddleOrientation(3),
+        makePaddleOrientation(4), makePaddleOrientation(5), makePaddleOrientation(6), makePaddleOrientation(7),
+        makePaddleOrientation(8), makePaddleOrientation(9), makePaddleOrientation(10)
+};
+
+static_assert(sizeof(PADDLE_ORIENTATIONS) / sizeof(PaddleOrientation) == NUM_PADDLE_ORIENTATIONS,
+              "there must be one orientation for every rotation the paddle can have");
+static_assert(PADDLE_ORIENTATIONS[NUM_PADDLE_ORIENTATIONS / 2].rotation == 0, "the middle orientation must be flat");
+
+#endif //BRICKBREAKER_PADDLEORIENTATION_H
@@ -0,0 +1,151 @@
+/**
+ * \file ParticleSystem.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a pool of short lived particles, used for bricks shattering and balls' trails
+ */
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include "Constants.h"
+#include "ParticleSystem.h"
+
+using namespace sf;
+using namespace std;
+
+ParticleSystem::ParticleSystem()
+        : x_(PARTICLE_CAPACITY),
+          y_(PARTICLE_CAPACITY),
+          xVel_(PARTICLE_CAPACITY),
+          yVel_(PARTICLE_CAPACITY),
+          life_(PARTICLE_CAPACITY),
+          fade_(PARTICLE_CAPACITY),
+          colors_(PARTICLE_CAPACITY),
+          vertices_(PARTICLE_CAPACITY * 4),
+          count_(0),
+          random_(1)
+{
+}
+
+void ParticleSystem::emitShatter(const FloatRect& bounds, const Color& color) {
+    uniform_real_distribution<float> unit(0, 1);
+    Vector2f center(bounds.left + bounds.width / 2, bounds.top + bounds.height / 2);
+
+    // Pieces start spread over the brick and fly away from its center, a little upwards
+    for (unsigned int i = 0; i < PARTICLES_PER_BRICK; ++i) {
+        float x = bounds.left + unit(random_) * bounds.width;
+        float y = bounds.top + unit(random_) * bounds.height;
+        spawn(x, y, (x - center.x) / bounds.width * 4 + (unit(random_) - .5f),
+              (y - center.y) / bounds.height * 2 - 1.5f * unit(random_), 40 + 30 * unit(random_), color);
+    }
+}
+
+void ParticleSystem::emitTrail(const Vector2f& position, const Vector2f& velocity, float radius) {
+    uniform_real_distribution<float> jitter(-.3f, .3f);
+
+    // Drift slowly back along the ball's path, without falling
+    spawn(position.x + jitter(random_) * radius, position.y + jitter(random_) * radius,
+          -velocity.x * .1f + jitter(random_), -velocity.y * .1f + jitter(random_) - PARTICLE_GRAVITY * 10, 20,
+          BALL_COLOR);
+}
+
+void ParticleSystem::spawn(float x, float y, float xVel, float yVel, float lifetime, const Color& color) {
+    if (count_ == PARTICLE_CAPACITY)
+        return;
+
+    x_[count_] = x;
+    y_[count_] = y;
+    xVel_[count_] = xVel;
+    yVel_[count_] = yVel;
+    life_[count_] = 1;
+    fade_[count_] = 1 / lifetime;
+    colors_[count_] = color;
+    ++count_;
+}
+
+void ParticleSystem::update(float time) {
+    float* x = x_.data();
+    float* y = y_.data();
+    float* xVel = xVel_.data();
+    float* yVel = yVel_.data();
+    float* life = life_.data();
+    const float* fade = fade_.data();
+    const unsigned int count = count_;
+
+    unsigned int i = 0;
+
+#ifdef __SSE__
+    // Four particles at a time. The capacity is a multiple of four, so the last group can safely run on into unused
+    // slots past the live particles.
+    static_assert(PARTICLE_CAPACITY % 4 == 0, "the last group of four particles must fit in the pool");
+    const __m128 step = _mm_set1_ps(time);
+    const __m128 gravity = _mm_set1_ps(PARTICLE_GRAVITY * time);
+    for (; i < count; i += 4) {
+        __m128 xVel4 = _mm_loadu_ps(xVel + i);
+        __m128 yVel4 = _mm_loadu_ps(yVel + i);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(xVel4, step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(yVel4, step)));
+        _mm_storeu_ps(yVel + i, _mm_add_ps(yVel4, gravity));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), _mm_mul_ps(_mm_loadu_ps(fade + i), step)));
+    }
+#endif
+
+    // One at a time where SSE isn't available
+    for (; i < count; ++i) {
+        x[i] += xVel[i] * time;
+        y[i] += yVel[i] * time;
+        yVel[i] += PARTICLE_GRAVITY * time;
+        life[i] -= fade[i] * time;
+    }
+
+    // Replace each dead particle with the last live one
+    for (unsigned int i = 0; i < count_;) {
+        if (life_[i] > 0) {
+            ++i;
+            continue;
+        }
+
+        --count_;
+        x_[i] = x_[count_];
+        y_[i] = y_[count_];
+        xVel_[i] = xVel_[count_];
+        yVel_[i] = yVel_[count_];
+        life_[i] = life_[count_];
+        fade_[i] = fade_[count_];
+        colors_[i] = colors_[count_];
+    }
+
+    // A square per particle, fading out as it dies
+    for (unsigned int i = 0; i < count_; ++i) {
+        Color color = colors_[i];
+        color.a = Uint8(color.a * life_[i]);
+
+        Vertex* quad = &vertices_[i * 4];
+        quad[0].position = Vector2f(x_[i], y_[i]);
+        quad[1].position = Vector2f(x_[i] + PARTICLE_SIZE, y_[i]);
+        quad[2].position = Vector2f(x_[i] + PARTICLE_SIZE, y_[i] + PARTICLE_SIZE);
+        quad[3].position = Vector2f(x_[i], y_[i] + PARTICLE_SIZE);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+    }
+}
+
+void ParticleSystem::draw(RenderWindow& window) const {
+    if (count_ > 0)
+        window.draw(&vertices_[0], count_ * 4, Quads);
+}
+
+void ParticleSystem::clear() {
+    count_ = 0;
+}
+
+unsigned int ParticleSystem::getCount() const {
+    return count_;
+}
+
+void ParticleSystem::getMemoryUsage(MemoryReport& report) const {
+    report.add("particles", count_, sizeof(ParticleSystem) + PARTICLE_CAPACITY * (6 * sizeof(float) + sizeof(Color)
+                                                                                  + 4 * sizeof(Vertex)));
+}
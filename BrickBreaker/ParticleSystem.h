@@ -0,0 +1,106 @@
+/**
+ * \file ParticleSystem.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a pool of short lived particles, used for bricks shattering and balls' trails
+ */
+
+#ifndef BRICKBREAKER_PARTICLESYSTEM_H
+#define BRICKBREAKER_PARTICLESYSTEM_H
+
+#include <random>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "MemoryReport.h"
+
+/**
+ * \class ParticleSystem
+ * \brief A fixed size pool of particles, stored one array per field and drawn with one draw call
+ *
+ * \details Every array is allocated once, at full capacity, when the pool is created. Spawning a particle writes the
+ *      next slot of each array, and particles that die are replaced by the last live one, so the live particles are
+ *      always the first getCount() slots. Particles spawned while the pool is full are dropped.
+ *
+ *      update() moves four particles at a time with SSE, then writes a quad for each live particle into a vertex array
+ *      that is also allocated up front.
+ *
+ *      Particles are only for show. They have their own random number generator and are never part of a snapshot, so
+ *      they can't change how the game plays out.
+ */
+class ParticleSystem {
+public:
+    ParticleSystem();
+
+    /**
+     * \brief Bursts a destroyed brick into PARTICLES_PER_BRICK pieces of its color
+     */
+    void emitShatter(const sf::FloatRect& bounds, const sf::Color& color);
+
+    /**
+     * \brief Leaves one particle behind a moving ball, scattered over its size
+     */
+    void emitTrail(const sf::Vector2f& position, const sf::Vector2f& velocity, float radius);
+
+    /**
+     * \brief Moves and fades every particle, removes the ones that have faded out, and rebuilds the vertices
+     *
+     * \param time  How many ticks' worth of time to advance by, 0 to leave the particles where they are
+     */
+    void update(float time);
+
+    /**
+     * \brief Draws every live particle in one draw call
+     */
+    void draw(sf::RenderWindow& window) const;
+
+    /**
+     * \brief Removes every particle
+     */
+    void clear();
+
+    /**
+     * \brief Returns the number of live particles
+     */
+    unsigned int getCount() const;
+
+    /**
+     * \brief Adds the pool to a report as one entry
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+private:
+    /**
+     * \brief Adds a particle if there is room
+     *
+     * \param lifetime  In ticks
+     */
+    void spawn(float x, float y, float xVel, float yVel, float lifetime, const sf::Color& color);
+
+    // One entry per particle in each, only the first count_ are live
+    std::vector<float> x_, y_;
+    std::vector<float> xVel_, yVel_;
+    std::vector<float> life_;           ///< From 1 when spawned down to 0 when it dies
+    std::vector<float> fade_;           ///< How much life is lost per tick
+    std::vector<sf::Color> colors_;
+
+    std::vector<sf::Vertex> vertices_;  ///< Four per particle, only the first 4 * count_ are drawn
+
+    unsigned int count_;
+
+    std::minstd_rand random_;           ///< Separate from the game's, so effects don't change the game
+};
+
+const unsigned int PARTICLE_CAPACITY = 100000;  ///< Most particles alive at once
+
+const unsigned int PARTICLES_PER_BRICK = 48;
+
+const float PARTICLE_SIZE = 3;                  ///< Width and height of each particle's square
+
+const float PARTICLE_GRAVITY = .12f;            ///< Added to each particle's downward velocity every tick
+
+#endif //BRICKBREAKER_PARTICLESYSTEM_H
@@ -0,0 +1,144 @@
+/**
+ * \file PerfCounters.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a small wrapper around Linux's hardware performance counters
+ */
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+const char* PerfCounters::getName(Counter counter) {
+    switch (counter) {
+        case CYCLES:        return "cycles";
+        case INSTRUCTIONS:  return "instructions";
+        case L1D_MISSES:    return "L1d misses";
+        case LLC_MISSES:    return "LLC misses";
+        case BRANCH_MISSES: return "branch misses";
+        default:            return "";
+    }
+}
+
+PerfCounters::PerfCounters()
+        : groupSize_(0)
+{
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        fds_[i] = -1;
+        groupIndex_[i] = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (fd != -1)
+            close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::open() {
+#ifdef __linux__
+    // Already open, nothing to do
+    if (isOpen())
+        return true;
+
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.exclude_kernel = 1;    // Only count the game's own code, also lets this work without root
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        // The group leader starts disabled so that every counter in the group is started at the same time below
+        attr.disabled = (i == CYCLES);
+
+        switch (i) {
+            case CYCLES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+
+            case INSTRUCTIONS:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+
+            case L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+
+            case LLC_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+
+            case BRANCH_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+
+            default: break;
+        }
+
+        // Count this thread on whatever cpu it runs on. Every counter after the first joins the first one's group.
+        int fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, (i == CYCLES) ? -1 : fds_[CYCLES], 0));
+
+        if (fd == -1) {
+            // Without the group leader there is nothing to attach the other counters to
+            if (i == CYCLES)
+                return false;
+
+            // Otherwise this counter just isn't supported, so leave it out
+            continue;
+        }
+
+        fds_[i] = fd;
+        groupIndex_[i] = groupSize_;
+        ++groupSize_;
+    }
+
+    // Start every counter in the group
+    ioctl(fds_[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool PerfCounters::isOpen() const {
+    return fds_[CYCLES] != -1;
+}
+
+void PerfCounters::read(uint64_t values[NUM_COUNTERS]) const {
+    for (int i = 0; i < NUM_COUNTERS; ++i)
+        values[i] = 0;
+
+#ifdef __linux__
+    if (!isOpen())
+        return;
+
+    // With PERF_FORMAT_GROUP the leader returns the number of counters followed by each counter's value
+    uint64_t buffer[1 + NUM_COUNTERS];
+    if (::read(fds_[CYCLES], buffer, sizeof(buffer)) < ssize_t(sizeof(uint64_t) * (1 + groupSize_)))
+        return;
+
+    for (int i = 0; i < NUM_COUNTERS; ++i) {
+        if (groupIndex_[i] != -1)
+            values[i] = buffer[1 + groupIndex_[i]];
+    }
+#endif
+}
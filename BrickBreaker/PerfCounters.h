@@ -0,0 +1,78 @@
+/**
+ * \file PerfCounters.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a small wrapper around Linux's hardware performance counters
+ */
+
+#ifndef BRICKBREAKER_PERFCOUNTERS_H
+#define BRICKBREAKER_PERFCOUNTERS_H
+
+#include <cstdint>
+
+/**
+ * \class PerfCounters
+ * \brief Reads the CPU's hardware event counters for the calling thread using perf_event_open
+ *
+ * \details All the counters are opened as a single group so one read() returns a consistent set of values. Counters
+ *      the CPU or kernel doesn't support are left out and always read as 0. On platforms other than Linux open()
+ *      always fails and the class does nothing.
+ */
+class PerfCounters {
+public:
+    /**
+     * \brief The hardware events that are counted
+     */
+    enum Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,         ///< Level 1 data cache read misses
+        LLC_MISSES,         ///< Last level cache misses
+        BRANCH_MISSES,
+        NUM_COUNTERS
+    };
+
+    /**
+     * \brief Returns a short name for a counter, used when printing results
+     */
+    static const char* getName(Counter counter);
+
+    PerfCounters();
+
+    /**
+     * \brief Closes the counters if they are open
+     */
+    ~PerfCounters();
+
+    /**
+     * \brief Opens and starts the counters for the calling thread
+     *
+     * \return true if at least the cycle counter could be opened, false otherwise (unsupported platform, missing
+     *      permissions, perf_event_paranoid, etc.)
+     */
+    bool open();
+
+    /**
+     * \brief Returns true if the counters were successfully opened
+     */
+    bool isOpen() const;
+
+    /**
+     * \brief Reads the current value of every counter into values. Unavailable counters read as 0.
+     */
+    void read(uint64_t values[NUM_COUNTERS]) const;
+
+private:
+    // Counters hold file descriptors, so they can't be copied
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    int fds_[NUM_COUNTERS];             ///< One file descriptor per counter, -1 if the counter isn't available
+    int groupIndex_[NUM_COUNTERS];      ///< The counter's position in the group's read() output, -1 if unavailable
+    int groupSize_;                     ///< How many counters were successfully added to the group
+};
+
+#endif //BRICKBREAKER_PERFCOUNTERS_H
@@ -0,0 +1,115 @@
+/**
+ * \file PerformanceHud.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the performance overlay drawn in the banner
+ */
+#include <algorithm>
+#include <cstdio>
+#include "PerformanceHud.h"
+#include "Constants.h"
+
+using namespace sf;
+
+// Each sparkline is drawn as one line segment (two vertices) between every pair of neighbouring frames
+const unsigned int SPARKLINE_VERTICES = 2 * (Profiler::HISTORY_LENGTH - 1);
+
+PerformanceHud::PerformanceHud(const Font& font, const Vector2f& textPosition, const FloatRect& graphArea)
+        : visible_(false),
+          graph_(Lines, 2 * SPARKLINE_VERTICES + 2),  // Two sparklines plus the frame budget line
+          graphArea_(graphArea),
+          framesUntilRefresh_(0)
+{
+    text_.setFont(font);
+    text_.setCharacterSize(HUD_TEXT_SIZE);
+    text_.setColor(DEFAULT_COLOR);
+    text_.setPosition(textPosition);
+
+    // The frame budget line never moves, so place it once here. Frame times are plotted up to twice the budget, so
+    // the budget sits halfway up the graph.
+    float budgetY = graphArea_.top + graphArea_.height / 2;
+    graph_[2 * SPARKLINE_VERTICES] = Vertex(Vector2f(graphArea_.left, budgetY), WIN_COLOR);
+    graph_[2 * SPARKLINE_VERTICES + 1] = Vertex(Vector2f(graphArea_.left + graphArea_.width, budgetY), WIN_COLOR);
+}
+
+void PerformanceHud::update(const Profiler& profiler) {
+    // Frame times are plotted relative to the time available for one frame
+    float budget = 1000.0f / FRAME_RATE;
+    writeSparkline(0, [&](unsigned int framesAgo) { return profiler.getFrameTime(framesAgo); }, 2 * budget,
+                   DEFAULT_COLOR);
+
+    // Allocations are plotted relative to the worst frame in the history
+    float maxAllocations = 1;
+    for (unsigned int i = 0; i < Profiler::HISTORY_LENGTH; ++i) {
+        maxAllocations = std::max(maxAllocations, float(profiler.getAllocations(i)));
+    }
+    writeSparkline(SPARKLINE_VERTICES,
+                   [&](unsigned int framesAgo) { return float(profiler.getAllocations(framesAgo)); },
+                   maxAllocations, HUD_ALLOCATION_COLOR);
+
+    // Only rebuild the text every few frames, otherwise the numbers change too quickly to read
+    if (framesUntilRefresh_ > 0) {
+        --framesUntilRefresh_;
+        return;
+    }
+    framesUntilRefresh_ = HUD_REFRESH_FRAMES;
+
+    char buffer[256];
+    int length = snprintf(buffer, sizeof(buffer),
+                          "frame %.2fms   sim %.2fms   draw %.2fms   tests %u\n"
+                          "balls %u   bricks %u   draw calls %u   allocs %lu",
+                          profiler.getFrameTime(), profiler.getPhaseTime(Profiler::SIMULATION),
+                          profiler.getPhaseTime(Profiler::RENDER), profiler.collisionTests_,
+                          profiler.numBalls_, profiler.numBricks_, profiler.drawCalls_, profiler.getAllocations());
+
+    // With hardware counters, add a line for the collision phase since that is where data layout matters most
+    if (profiler.hasHardwareCounters() && length > 0 && length < int(sizeof(buffer))) {
+        snprintf(buffer + length, sizeof(buffer) - length,
+                 "\ncollision   cycles %llu   instr %llu   L1d miss %llu   LLC miss %llu   br miss %llu",
+                 (unsigned long long) profiler.getPhaseCount(Profiler::COLLISION, PerfCounters::CYCLES),
+                 (unsigned long long) profiler.getPhaseCount(Profiler::COLLISION, PerfCounters::INSTRUCTIONS),
+                 (unsigned long long) profiler.getPhaseCount(Profiler::COLLISION, PerfCounters::L1D_MISSES),
+                 (unsigned long long) profiler.getPhaseCount(Profiler::COLLISION, PerfCounters::LLC_MISSES),
+                 (unsigned long long) profiler.getPhaseCount(Profiler::COLLISION, PerfCounters::BRANCH_MISSES));
+    }
+    text_.setString(buffer);
+}
+
+void PerformanceHud::draw(RenderWindow& window) const {
+    window.draw(graph_);
+    window.draw(text_);
+}
+
+unsigned int PerformanceHud::getNumDrawCalls() const {
+    return 2;
+}
+
+void PerformanceHud::getMemoryUsage(MemoryReport& report) const {
+    report.add("performance overlay", 1 + graph_.getVertexCount(),
+               sizeof(PerformanceHud) + graph_.getVertexCount() * sizeof(Vertex) + MemoryReport::getTextHeapBytes(text_));
+}
+
+template <typename ValueFunction>
+void PerformanceHud::writeSparkline(unsigned int firstVertex, ValueFunction values, float maxValue,
+                                    const Color& color) {
+    // The oldest frame is on the left of the graph and the newest on the right
+    float step = graphArea_.width / (Profiler::HISTORY_LENGTH - 1);
+    float bottom = graphArea_.top + graphArea_.height;
+
+    // Position of the previous point on the line, starting with the oldest frame
+    Vector2f last(graphArea_.left,
+                  bottom - graphArea_.height * std::min(values(Profiler::HISTORY_LENGTH - 1) / maxValue, 1.0f));
+
+    for (unsigned int i = 1; i < Profiler::HISTORY_LENGTH; ++i) {
+        Vector2f next(graphArea_.left + step * i,
+                      bottom - graphArea_.height * std::min(values(Profiler::HISTORY_LENGTH - 1 - i) / maxValue, 1.0f));
+
+        // Each segment connects the previous point to the next one
+        graph_[firstVertex + 2 * (i - 1)] = Vertex(last, color);
+        graph_[firstVertex + 2 * (i - 1) + 1] = Vertex(next, color);
+        last = next;
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * \file PerformanceHud.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the performance overlay drawn in the banner
+ */
+
+#ifndef BRICKBREAKER_PERFORMANCEHUD_H
+#define BRICKBREAKER_PERFORMANCEHUD_H
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "Profiler.h"
+#include "MemoryReport.h"
+
+/**
+ * \class PerformanceHud
+ * \brief A toggleable overlay showing the profiler's statistics as text and a sparkline history
+ *
+ * \details Everything is drawn with one text object and one vertex array, so showing the overlay only costs two draw
+ *      calls. The vertex array is sized once in the constructor and only has its positions rewritten afterwards.
+ */
+class PerformanceHud {
+public:
+    /**
+     * \brief Parametrized constructor for the overlay
+     *
+     * \param font          The font used for the statistics text
+     *        textPosition  The top left of the statistics text
+     *        graphArea     The area the sparklines are drawn in
+     */
+    PerformanceHud(const sf::Font& font, const sf::Vector2f& textPosition, const sf::FloatRect& graphArea);
+
+    /**
+     * \brief Rebuilds the sparklines from the profiler's history, and every few frames the statistics text as well
+     */
+    void update(const Profiler& profiler);
+
+    /**
+     * \brief Draws the overlay onto a render window
+     */
+    void draw(sf::RenderWindow& window) const;
+
+    /**
+     * \brief Returns how many draw calls draw() makes
+     */
+    unsigned int getNumDrawCalls() const;
+
+    /**
+     * \brief Adds the overlay's memory usage to a report
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+    bool visible_;      ///< The overlay is only updated and drawn if this is true
+
+private:
+    /**
+     * \brief Writes one sparkline into graph_ as a set of line segments
+     *
+     * \param firstVertex   The index in graph_ of the first vertex of this line
+     *        values        A function returning the value to plot for a number of frames ago
+     *        maxValue      The value that maps to the top of the graph area (higher values are clamped)
+     *        color         The line's color
+     */
+    template <typename ValueFunction>
+    void writeSparkline(unsigned int firstVertex, ValueFunction values, float maxValue, const sf::Color& color);
+
+    sf::Text text_;
+    sf::VertexArray graph_;         ///< Holds the frame time line, the allocation line and the frame budget line
+    sf::FloatRect graphArea_;
+    unsigned int framesUntilRefresh_;   ///< The text is only rebuilt every few frames so that it is readable
+};
+
+#endif //BRICKBREAKER_PERFORMANCEHUD_H
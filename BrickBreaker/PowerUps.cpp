@@ -0,0 +1,145 @@
+/**
+ * \file PowerUps.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a pool of power-up capsules falling from destroyed special bricks
+ */
+#include <algorithm>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include "Constants.h"
+#include "PowerUps.h"
+
+using namespace sf;
+using namespace std;
+
+PowerUps::PowerUps()
+        : x_(POWER_UP_CAPACITY),
+          y_(POWER_UP_CAPACITY),
+          types_(POWER_UP_CAPACITY),
+          pool_(POWER_UP_CAPACITY)
+{
+}
+
+bool PowerUps::drop(float x, float y, char type) {
+    unsigned int index;
+    if (!pool_.add(index))
+        return false;
+
+    x_[index] = x;
+    y_[index] = y;
+    types_[index] = type;
+    return true;
+}
+
+unsigned int PowerUps::update(const Capsule& paddle, float bottom, char* caught) {
+    // Any capsule touching the paddle has its center within the paddle's bounding box grown by both radii
+    float reach = paddle.radius + POWER_UP_RADIUS;
+    float left = min(paddle.start.x, paddle.end.x) - reach;
+    float right = max(paddle.start.x, paddle.end.x) + reach;
+    float top = min(paddle.start.y, paddle.end.y) - reach;
+    float lowest = max(paddle.start.y, paddle.end.y) + reach;
+    float gone = bottom + POWER_UP_RADIUS;
+
+    float* x = x_.data();
+    float* y = y_.data();
+
+    unsigned int first = 0;
+
+#ifdef __SSE__
+    // Four capsules at a time, flagging those near the paddle or off the stage
+    static_assert(POWER_UP_CAPACITY % 4 == 0, "the last group of four capsules must fit in the pool");
+    const __m128 fall = _mm_set1_ps(POWER_UP_SPEED);
+    const __m128 left4 = _mm_set1_ps(left), right4 = _mm_set1_ps(right);
+    const __m128 top4 = _mm_set1_ps(top), lowest4 = _mm_set1_ps(lowest);
+    const __m128 gone4 = _mm_set1_ps(gone);
+    first = pool_.flagGroups([&](unsigned int i) {
+        __m128 x4 = _mm_loadu_ps(x + i);
+        __m128 y4 = _mm_add_ps(_mm_loadu_ps(y + i), fall);
+        _mm_storeu_ps(y + i, y4);
+
+        __m128 near = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(x4, left4), _mm_cmple_ps(x4, right4)),
+                                 _mm_and_ps(_mm_cmpge_ps(y4, top4), _mm_cmple_ps(y4, lowest4)));
+        return _mm_movemask_ps(_mm_or_ps(near, _mm_cmpgt_ps(y4, gone4)));
+    });
+#endif
+
+    // One at a time where SSE isn't available
+    pool_.flagEach(first, [&](unsigned int i) {
+        y[i] += POWER_UP_SPEED;
+        bool near = x[i] >= left && x[i] <= right && y[i] >= top && y[i] <= lowest;
+        return near || y[i] > gone;
+    });
+
+    // Then only the flagged ones
+    unsigned int numCaught = 0;
+    Contact contact;
+    pool_.forEachFlagged([&](unsigned int i) {
+        if (y[i] > gone) {
+            pool_.remove(i, x_, y_, types_);
+        }
+        else if (collide(Circle{Vector2f(x[i], y[i]), POWER_UP_RADIUS, Vector2f(0, POWER_UP_SPEED)}, paddle, contact)) {
+            caught[numCaught++] = types_[i];
+            pool_.remove(i, x_, y_, types_);
+        }
+    });
+
+    return numCaught;
+}
+
+void PowerUps::draw(RenderWindow& window, float alpha) {
+    const unsigned int count = pool_.getCount();
+    if (count == 0)
+        return;
+
+    if (vertices_.empty())
+        vertices_.resize(POWER_UP_CAPACITY * 4);
+
+    // A square per capsule, where it was part way through the tick
+    for (unsigned int i = 0; i < count; ++i) {
+        float x = x_[i];
+        float y = y_[i] - POWER_UP_SPEED * (1 - alpha);
+
+        Vertex* quad = &vertices_[i * 4];
+        quad[0].position = Vector2f(x - POWER_UP_RADIUS, y - POWER_UP_RADIUS);
+        quad[1].position = Vector2f(x + POWER_UP_RADIUS, y - POWER_UP_RADIUS);
+        quad[2].position = Vector2f(x + POWER_UP_RADIUS, y + POWER_UP_RADIUS);
+        quad[3].position = Vector2f(x - POWER_UP_RADIUS, y + POWER_UP_RADIUS);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = SPECIAL_BRICK_COLOR;
+    }
+
+    window.draw(&vertices_[0], count * 4, Quads);
+}
+
+void PowerUps::clear() {
+    pool_.clear();
+}
+
+unsigned int PowerUps::getCount() const {
+    return pool_.getCount();
+}
+
+void PowerUps::saveState(vector<GameState::PowerUpState>& states) const {
+    states.resize(pool_.getCount());
+    for (unsigned int i = 0; i < pool_.getCount(); ++i)
+        states[i] = GameState::PowerUpState{x_[i], y_[i], types_[i]};
+}
+
+void PowerUps::restoreState(const vector<GameState::PowerUpState>& states) {
+    clear();
+    for (const GameState::PowerUpState& state : states)
+        drop(state.x, state.y, state.type);
+}
+
+void PowerUps::getMemoryUsage(MemoryReport& report) const {
+    report.add("power-ups", pool_.getCount(), sizeof(PowerUps) + POWER_UP_CAPACITY * (2 * sizeof(float) + sizeof(char))
+                                              + pool_.getHeapBytes() + vertices_.capacity() * sizeof(Vertex));
+}
+
+bool PowerUps::isPowerUp(char special) {
+    return find(begin(SPECIALS), end(SPECIALS), special) != end(SPECIALS);
+}
@@ -0,0 +1,113 @@
+/**
+ * \file PowerUps.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a pool of power-up capsules falling from destroyed special bricks
+ */
+
+#ifndef BRICKBREAKER_POWERUPS_H
+#define BRICKBREAKER_POWERUPS_H
+
+#include <vector>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "Collision.h"
+#include "FlaggedPool.h"
+#include "GameState.h"
+#include "MemoryReport.h"
+
+/**
+ * \class PowerUps
+ * \brief A fixed size pool of falling capsules, stored one array per field, that the paddle has to catch
+ *
+ * \details When the game drops power-ups, a special brick's effect isn't applied when it is destroyed. A capsule
+ *      carrying it falls from where the brick was instead, and the effect is only applied if the paddle catches it.
+ *
+ *      Like ParticleSystem, every array is allocated once at full capacity, and capsules that are caught or fall off
+ *      the stage are replaced by the last live one, with a FlaggedPool keeping the count. update() moves four capsules
+ *      at a time with SSE and checks them against the paddle's bounding box in the same pass, so only capsules right
+ *      next to the paddle get the exact test the balls use for it.
+ *
+ *      Unlike particles, capsules change how the game plays out, so they are part of every snapshot.
+ */
+class PowerUps {
+public:
+    PowerUps();
+
+    /**
+     * \brief Drops a capsule from a point
+     *
+     * \param x, y  Where the capsule's center starts
+     *        type  The special brick it came from (see Brick::special_)
+     *
+     * \return false if the pool is full, in which case nothing is dropped
+     */
+    bool drop(float x, float y, char type);
+
+    /**
+     * \brief Moves every capsule down a tick's worth, and removes the ones caught or fallen off the stage
+     *
+     * \param paddle    The paddle's shape
+     *        bottom    The bottom of the stage
+     *        caught    Where the types of the capsules caught are written, with room for getCount() of them
+     *
+     * \return How many capsules were caught
+     */
+    unsigned int update(const Capsule& paddle, float bottom, char* caught);
+
+    /**
+     * \brief Draws every capsule in one draw call
+     *
+     * \param alpha How far between the last tick and the next to draw them, as for Object::drawInterpolated()
+     */
+    void draw(sf::RenderWindow& window, float alpha);
+
+    /**
+     * \brief Removes every capsule
+     */
+    void clear();
+
+    /**
+     * \brief Returns the number of capsules falling
+     */
+    unsigned int getCount() const;
+
+    /**
+     * \brief Copies every capsule into a snapshot
+     */
+    void saveState(std::vector<GameState::PowerUpState>& states) const;
+
+    /**
+     * \brief Replaces the capsules with those in a snapshot
+     */
+    void restoreState(const std::vector<GameState::PowerUpState>& states);
+
+    /**
+     * \brief Adds the pool to a report as one entry
+     */
+    void getMemoryUsage(MemoryReport& report) const;
+
+    /**
+     * \brief Returns whether a special brick's effect is one that can be dropped, which is any listed in SPECIALS
+     */
+    static bool isPowerUp(char special);
+
+private:
+    // One entry per capsule in each, only the first pool_.getCount() are live
+    std::vector<float> x_, y_;
+    std::vector<char> types_;
+    FlaggedPool pool_;
+
+    std::vector<sf::Vertex> vertices_;  ///< Four per capsule, only allocated once the pool is first drawn
+};
+
+const unsigned int POWER_UP_CAPACITY = 1024;    ///< Most capsules falling at once, a multiple of four
+
+const float POWER_UP_RADIUS = 8;                ///< Capsules are caught as circles of this radius
+
+const float POWER_UP_SPEED = 2.5f;              ///< How far capsules fall each tick
+
+#endif //BRICKBREAKER_POWERUPS_H
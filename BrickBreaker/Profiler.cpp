@@ -0,0 +1,235 @@
+/**
+ * \file Profiler.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the game's frame profiler
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "Profiler.h"
+
+// Heap allocation counting //
+
+namespace {
+    thread_local unsigned long allocationCount = 0;     ///< Per thread so that threads don't fight over a cache line
+}
+
+// Replace the global allocation functions so every allocation in the program is counted
+void* operator new(std::size_t size) {
+    ++allocationCount;
+
+    // malloc(0) is allowed to return nullptr, but operator new must return a unique pointer
+    void* memory = std::malloc(size ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+// // // // // // // // // // // // // // // // // // // // // // // // //
+
+const char* Profiler::getName(Phase phase) {
+    switch (phase) {
+        case SIMULATION: return "simulation";
+        case RENDER:     return "render";
+        case COLLISION:  return "collision";
+        case LEVEL_LOAD: return "level load";
+        case GHOST:      return "ghost";
+        case SCRIPTS:    return "scripts";
+        case PARTICLES:  return "particles";
+        default:         return "";
+    }
+}
+
+Profiler::Profiler()
+        : collisionTests_(0),
+          drawCalls_(0),
+          numBalls_(0),
+          numBricks_(0),
+          frameStart_(0),
+          allocationsStart_(0),
+          numFrames_(0),
+          historyHead_(0)
+{
+    // Start with an empty history
+    for (unsigned int i = 0; i < HISTORY_LENGTH; ++i) {
+        frameTimes_[i] = 0;
+        allocations_[i] = 0;
+        for (int phase = 0; phase < NUM_PHASES; ++phase) {
+            phaseTimes_[phase][i] = 0;
+        }
+    }
+
+    // And with nothing measured for any phase
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        phaseStart_[phase] = 0;
+        phaseTotal_[phase] = 0;
+        phaseRan_[phase] = false;
+        phaseCounted_[phase] = false;
+        phaseFrames_[phase] = 0;
+        countedFrames_[phase] = 0;
+        totalPhaseTimes_[phase] = 0;
+        for (int counter = 0; counter < PerfCounters::NUM_COUNTERS; ++counter) {
+            phaseStartCounts_[phase][counter] = 0;
+            phaseCounts_[phase][counter] = 0;
+            lastPhaseCounts_[phase][counter] = 0;
+            totalPhaseCounts_[phase][counter] = 0;
+        }
+    }
+}
+
+bool Profiler::enableHardwareCounters() {
+    return counters_.open();
+}
+
+bool Profiler::hasHardwareCounters() const {
+    return counters_.isOpen();
+}
+
+void Profiler::beginFrame() {
+    frameStart_ = clock_.getElapsedTime().asSeconds();
+    allocationsStart_ = getAllocationCount();
+
+    // Reset the per frame counters
+    collisionTests_ = 0;
+    drawCalls_ = 0;
+}
+
+void Profiler::endFrame() {
+    // Move the head of the ring buffers forward, overwriting the oldest entry
+    historyHead_ = (historyHead_ + 1) % HISTORY_LENGTH;
+
+    // Record this frame's statistics (times are stored in milliseconds)
+    frameTimes_[historyHead_] = (clock_.getElapsedTime().asSeconds() - frameStart_) * 1000;
+    allocations_[historyHead_] = getAllocationCount() - allocationsStart_;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        phaseTimes_[phase][historyHead_] = phaseTotal_[phase] * 1000;
+    }
+
+    // Add this frame to the totals used for the report
+    ++numFrames_;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        if (phaseRan_[phase]) {
+            ++phaseFrames_[phase];
+        }
+        if (phaseCounted_[phase]) {
+            ++countedFrames_[phase];
+        }
+        totalPhaseTimes_[phase] += phaseTotal_[phase];
+
+        for (int counter = 0; counter < PerfCounters::NUM_COUNTERS; ++counter) {
+            totalPhaseCounts_[phase][counter] += phaseCounts_[phase][counter];
+            lastPhaseCounts_[phase][counter] = phaseCounts_[phase][counter];
+            phaseCounts_[phase][counter] = 0;
+        }
+
+        // Start the next frame with nothing measured
+        phaseTotal_[phase] = 0;
+        phaseRan_[phase] = false;
+        phaseCounted_[phase] = false;
+    }
+}
+
+void Profiler::beginPhase(Phase phase) {
+    phaseRan_[phase] = true;
+
+    // Read the hardware counters before the clock so that reading them isn't included in the phase's time
+    if (counters_.isOpen()) {
+        phaseCounted_[phase] = true;
+        counters_.read(phaseStartCounts_[phase]);
+    }
+
+    phaseStart_[phase] = clock_.getElapsedTime().asSeconds();
+}
+
+void Profiler::endPhase(Phase phase) {
+    phaseTotal_[phase] += clock_.getElapsedTime().asSeconds() - phaseStart_[phase];
+
+    if (counters_.isOpen()) {
+        uint64_t counts[PerfCounters::NUM_COUNTERS];
+        counters_.read(counts);
+        for (int counter = 0; counter < PerfCounters::NUM_COUNTERS; ++counter) {
+            phaseCounts_[phase][counter] += counts[counter] - phaseStartCounts_[phase][counter];
+        }
+    }
+}
+
+float Profiler::getFrameTime(unsigned int framesAgo) const {
+    return frameTimes_[historyIndex(framesAgo)];
+}
+
+float Profiler::getPhaseTime(Phase phase, unsigned int framesAgo) const {
+    return phaseTimes_[phase][historyIndex(framesAgo)];
+}
+
+unsigned long Profiler::getAllocations(unsigned int framesAgo) const {
+    return allocations_[historyIndex(framesAgo)];
+}
+
+uint64_t Profiler::getPhaseCount(Phase phase, PerfCounters::Counter counter) const {
+    return lastPhaseCounts_[phase][counter];
+}
+
+void Profiler::writeReport(std::ostream& out) const {
+    out << "Profile over " << numFrames_ << " frames";
+    if (!counters_.isOpen()) {
+        out << " (hardware counters unavailable)";
+    }
+    out << "\n";
+
+    // Column headers
+    char line[256];
+    snprintf(line, sizeof(line), "%-12s %8s %10s", "phase", "frames", "ms/frame");
+    out << line;
+    if (counters_.isOpen()) {
+        for (int counter = 0; counter < PerfCounters::NUM_COUNTERS; ++counter) {
+            snprintf(line, sizeof(line), " %14s", PerfCounters::getName(PerfCounters::Counter(counter)));
+            out << line;
+        }
+    }
+    out << "\n";
+
+    // One row per phase, averaged over the frames the phase actually ran in. Counts are only averaged over the frames
+    // they were read in, so a level loaded before the counters were enabled doesn't dilute them.
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        double frames = phaseFrames_[phase] ? phaseFrames_[phase] : 1;
+        double countedFrames = countedFrames_[phase] ? countedFrames_[phase] : 1;
+
+        snprintf(line, sizeof(line), "%-12s %8lu %10.3f", getName(Phase(phase)), phaseFrames_[phase],
+                 totalPhaseTimes_[phase] * 1000 / frames);
+        out << line;
+
+        if (counters_.isOpen()) {
+            for (int counter = 0; counter < PerfCounters::NUM_COUNTERS; ++counter) {
+                snprintf(line, sizeof(line), " %14.0f", totalPhaseCounts_[phase][counter] / countedFrames);
+                out << line;
+            }
+        }
+        out << "\n";
+    }
+}
+
+unsigned long Profiler::getAllocationCount() {
+    return allocationCount;
+}
+
+unsigned int Profiler::historyIndex(unsigned int framesAgo) const {
+    // Add HISTORY_LENGTH before subtracting so the unsigned value never wraps around
+    return (historyHead_ + HISTORY_LENGTH - framesAgo) % HISTORY_LENGTH;
+}
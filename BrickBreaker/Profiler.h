@@ -0,0 +1,161 @@
+/**
+ * \file Profiler.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the game's frame profiler
+ */
+
+#ifndef BRICKBREAKER_PROFILER_H
+#define BRICKBREAKER_PROFILER_H
+
+#include <SFML/System/Clock.hpp>
+#include <ostream>
+#include "PerfCounters.h"
+
+/**
+ * \class Profiler
+ * \brief Measures how long each frame takes and keeps a short history of per frame statistics
+ *
+ * \details A frame is split into phases (see Phase below). The time spent in each phase is accumulated between calls
+ *      to beginPhase() and endPhase(), and the public counters are reset at the start of every frame so the rest of
+ *      the game can simply increment them. If hardware counters are enabled, the CPU's event counts (cycles, cache
+ *      misses, etc.) are accumulated for each phase the same way.
+ */
+class Profiler {
+public:
+    /**
+     * \brief The parts of a frame that are timed separately
+     */
+    enum Phase {
+        SIMULATION,     ///< Moving objects, collision handling and status checks
+        RENDER,         ///< Clearing the window and drawing objects and text
+        COLLISION,      ///< Just the object move loop, where collision handling happens. Nested inside SIMULATION.
+        LEVEL_LOAD,     ///< Building the next stage. Nested inside SIMULATION.
+        GHOST,          ///< Stepping the best run raced against (see Ghost). Nested inside SIMULATION.
+        SCRIPTS,        ///< Running the scripts of bricks hit this tick (see BrickScript). Nested inside SIMULATION.
+        PARTICLES,      ///< Moving particles and writing their vertices (see ParticleSystem). Nested inside RENDER.
+        NUM_PHASES
+    };
+
+    /**
+     * \brief Returns a short name for a phase, used when printing results
+     */
+    static const char* getName(Phase phase);
+
+    static const unsigned int HISTORY_LENGTH = 120;     ///< How many frames of history to keep (2 seconds at 60fps)
+
+    Profiler();
+
+    /**
+     * \brief Starts reading the CPU's hardware counters around each phase
+     *
+     * \details Counters are per thread, so this must be called from the thread that runs the game.
+     *
+     * \return true if the counters could be opened, false otherwise (see PerfCounters::open())
+     */
+    bool enableHardwareCounters();
+
+    /**
+     * \brief Returns true if hardware counters are being read
+     */
+    bool hasHardwareCounters() const;
+
+    /**
+     * \brief Marks the start of a frame, resetting the per frame counters
+     */
+    void beginFrame();
+
+    /**
+     * \brief Marks the end of a frame and records the frame's statistics in the history
+     *
+     * \details Phases timed before the first call to beginFrame() (loading the first level for example) are counted
+     *      in the first frame.
+     */
+    void endFrame();
+
+    /**
+     * \brief Starts timing a phase. Must be followed by a call to endPhase() with the same phase.
+     */
+    void beginPhase(Phase phase);
+
+    /**
+     * \brief Stops timing a phase and adds the elapsed time to the phase's total for this frame
+     */
+    void endPhase(Phase phase);
+
+    /**
+     * \brief Gets a recorded statistic from the history
+     *
+     * \param framesAgo 0 for the last completed frame, 1 for the one before that, etc. Must be < HISTORY_LENGTH
+     */
+    float getFrameTime(unsigned int framesAgo = 0) const;          ///< In milliseconds
+    float getPhaseTime(Phase phase, unsigned int framesAgo = 0) const;  ///< In milliseconds
+    unsigned long getAllocations(unsigned int framesAgo = 0) const;
+
+    /**
+     * \brief Gets a hardware counter's value for a phase during the last completed frame. 0 if counters are disabled.
+     */
+    uint64_t getPhaseCount(Phase phase, PerfCounters::Counter counter) const;
+
+    /**
+     * \brief Writes a summary of every phase over all recorded frames
+     *
+     * \details For each phase prints the number of frames the phase ran in, and the average time and hardware
+     *      counts per frame it ran in (per tick for the phases that run every frame, per load for LEVEL_LOAD). Counts
+     *      are averaged only over the frames in which the counters were open.
+     */
+    void writeReport(std::ostream& out) const;
+
+    /**
+     * \brief Returns the number of heap allocations made by the calling thread since it started
+     *
+     * \details Counted by the replacement global operator new in Profiler.cpp
+     */
+    static unsigned long getAllocationCount();
+
+    // Per frame counters, reset by beginFrame() and incremented by the rest of the game //
+    unsigned int collisionTests_;   ///< How many collision() calls were made while moving objects
+    unsigned int drawCalls_;        ///< How many times something was drawn to the window
+    unsigned int numBalls_;         ///< The number of balls in play
+    unsigned int numBricks_;        ///< The number of bricks (including safety bricks) on the stage
+
+private:
+    /**
+     * \brief Converts a "frames ago" value into an index in the history arrays
+     */
+    unsigned int historyIndex(unsigned int framesAgo) const;
+
+    sf::Clock clock_;
+    PerfCounters counters_;
+
+    float frameStart_;                  ///< Clock time at the start of the frame, in seconds
+    float phaseStart_[NUM_PHASES];      ///< Clock time at which each phase was last started, in seconds
+    float phaseTotal_[NUM_PHASES];      ///< Total time spent in each phase this frame, in seconds
+    unsigned long allocationsStart_;    ///< The allocation count at the start of the frame
+    bool phaseRan_[NUM_PHASES];         ///< Whether each phase has been started this frame
+    bool phaseCounted_[NUM_PHASES];     ///< Whether each phase has been started this frame with counters_ open
+
+    // Hardware counts for each phase. Only updated when counters_ is open. //
+    uint64_t phaseStartCounts_[NUM_PHASES][PerfCounters::NUM_COUNTERS];   ///< Counts when the phase last started
+    uint64_t phaseCounts_[NUM_PHASES][PerfCounters::NUM_COUNTERS];        ///< Counts accumulated this frame
+    uint64_t lastPhaseCounts_[NUM_PHASES][PerfCounters::NUM_COUNTERS];    ///< Counts from the last completed frame
+
+    // Totals over every recorded frame, used by writeReport() //
+    unsigned long numFrames_;
+    unsigned long phaseFrames_[NUM_PHASES];     ///< How many frames each phase ran in
+    unsigned long countedFrames_[NUM_PHASES];   ///< How many of those had hardware counts, which may be fewer if
+                                                ///< counters were enabled after the game started
+    double totalPhaseTimes_[NUM_PHASES];        ///< In seconds
+    uint64_t totalPhaseCounts_[NUM_PHASES][PerfCounters::NUM_COUNTERS];
+
+    // Ring buffers holding the history of each statistic, newest entry at historyHead_ //
+    float frameTimes_[HISTORY_LENGTH];
+    float phaseTimes_[NUM_PHASES][HISTORY_LENGTH];
+    unsigned long allocations_[HISTORY_LENGTH];
+    unsigned int historyHead_;
+};
+
+#endif //BRICKBREAKER_PROFILER_H
@@ -0,0 +1,153 @@
+/**
+ * \file Socket.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements helpers for opening the server's and clients' sockets
+ */
+#include <arpa/inet.h>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Socket.h"
+
+using namespace std;
+
+namespace {
+    /**
+     * \brief Makes a socket non-blocking and not inherited by child processes
+     */
+    bool setFlags(int fd) {
+#ifdef SO_NOSIGPIPE
+        // Where send() can't be told not to raise SIGPIPE (see MSG_NOSIGNAL in Socket.h), the socket is told instead
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        return fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0 && fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+    }
+
+    /**
+     * \brief Sends small writes right away. Every message is a whole tick's worth, so there is nothing to wait for.
+     */
+    void setNoDelay(int fd) {
+        // Fails harmlessly on UNIX sockets
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+}
+
+int Socket::listen(const string& address) {
+    sockaddr_storage storage;
+    unsigned int storageSize;
+    int fd = open(address, &storage, storageSize);
+    if (fd < 0)
+        return -1;
+
+    if (storage.ss_family == AF_UNIX) {
+        unlink(reinterpret_cast<sockaddr_un*>(&storage)->sun_path);
+    }
+    else {
+        // Allow restarting the server right away instead of waiting for old connections to time out
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&storage), storageSize) != 0 || ::listen(fd, SOMAXCONN) != 0
+        || !setFlags(fd)) {
+        cerr << "Could not listen on " << address << ": " << strerror(errno) << endl;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int Socket::connect(const string& address) {
+    sockaddr_storage storage;
+    unsigned int storageSize;
+    int fd = open(address, &storage, storageSize);
+    if (fd < 0)
+        return -1;
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&storage), storageSize) != 0 || !setFlags(fd)) {
+        cerr << "Could not connect to " << address << ": " << strerror(errno) << endl;
+        close(fd);
+        return -1;
+    }
+
+    setNoDelay(fd);
+    return fd;
+}
+
+int Socket::accept(int listener) {
+    int fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0)
+        return -1;
+
+    if (!setFlags(fd)) {
+        close(fd);
+        return -1;
+    }
+
+    setNoDelay(fd);
+    return fd;
+}
+
+unsigned long Socket::raiseFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return 0;
+
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+
+    getrlimit(RLIMIT_NOFILE, &limit);
+    return limit.rlim_cur;
+}
+
+int Socket::open(const string& address, void* storage, unsigned int& storageSize) {
+    memset(storage, 0, sizeof(sockaddr_storage));
+
+    // UNIX socket
+    if (address.compare(0, 5, "unix:") == 0) {
+        sockaddr_un* unixAddress = static_cast<sockaddr_un*>(storage);
+        string path = address.substr(5);
+        if (path.empty() || path.size() >= sizeof(unixAddress->sun_path)) {
+            cerr << "Bad socket path " << path << endl;
+            return -1;
+        }
+
+        unixAddress->sun_family = AF_UNIX;
+        strcpy(unixAddress->sun_path, path.c_str());
+        storageSize = sizeof(sockaddr_un);
+    }
+
+    // TCP, with the host defaulting to loopback
+    else {
+        sockaddr_in* inetAddress = static_cast<sockaddr_in*>(storage);
+        unsigned long colon = address.rfind(':');
+        string host = colon == string::npos ? "127.0.0.1" : address.substr(0, colon);
+        string port = colon == string::npos ? address : address.substr(colon + 1);
+
+        inetAddress->sin_family = AF_INET;
+        inetAddress->sin_port = htons(uint16_t(atoi(port.c_str())));
+        if (inetAddress->sin_port == 0 || inet_pton(AF_INET, host.c_str(), &inetAddress->sin_addr) != 1) {
+            cerr << "Bad address " << address << endl;
+            return -1;
+        }
+        storageSize = sizeof(sockaddr_in);
+    }
+
+    int fd = socket(static_cast<sockaddr*>(storage)->sa_family, SOCK_STREAM, 0);
+    if (fd < 0)
+        cerr << "Could not create a socket: " << strerror(errno) << endl;
+    return fd;
+}
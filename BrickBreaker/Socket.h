@@ -0,0 +1,73 @@
+/**
+ * \file Socket.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares helpers for opening the server's and clients' sockets
+ */
+
+#ifndef BRICKBREAKER_SOCKET_H
+#define BRICKBREAKER_SOCKET_H
+
+#include <string>
+#include <sys/socket.h>
+
+// macOS has no MSG_NOSIGNAL. Sockets there are made not to raise SIGPIPE when they are opened instead.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+/**
+ * \class Socket
+ * \brief Opens non-blocking stream sockets from address strings
+ *
+ * \details An address is either "unix:<path>" for a UNIX socket, or "[host:]port" for TCP. The host defaults to
+ *      127.0.0.1 so a server is only reachable from the same machine unless asked otherwise. Errors are printed to
+ *      stderr and reported by returning -1.
+ */
+class Socket {
+public:
+    /**
+     * \brief Opens a socket listening on an address. An existing UNIX socket file at the path is replaced.
+     *
+     * \return The listening socket, or -1 on failure
+     */
+    static int listen(const std::string& address);
+
+    /**
+     * \brief Connects to an address. Blocks until connected, then makes the socket non-blocking.
+     *
+     * \return The connected socket, or -1 on failure
+     */
+    static int connect(const std::string& address);
+
+    /**
+     * \brief Accepts a pending connection on a listening socket
+     *
+     * \return The connected socket (non-blocking), or -1 if there was none
+     */
+    static int accept(int listener);
+
+    /**
+     * \brief Raises the limit on open files as far as allowed, since every session holds a socket
+     *
+     * \return The new limit
+     */
+    static unsigned long raiseFileLimit();
+
+private:
+    /**
+     * \brief Creates a socket for an address and fills in the matching sockaddr
+     *
+     * \param address       The address to parse
+     *        storage       Set to the parsed address
+     *        storageSize   Set to the size of the parsed address
+     *
+     * \return The socket, or -1 if the address couldn't be parsed or the socket couldn't be created
+     */
+    static int open(const std::string& address, void* storage, unsigned int& storageSize);
+};
+
+#endif //BRICKBREAKER_SOCKET_H
@@ -0,0 +1,108 @@
+/**
+ * \file SpectatorViewer.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a thin client that draws a game streamed from a GameServer
+ */
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <SFML/Window/Event.hpp>
+#include "Constants.h"
+#include "Socket.h"
+#include "SpectatorViewer.h"
+
+using namespace sf;
+
+SpectatorViewer::SpectatorViewer(RenderWindow& window)
+        : window_(window),
+          fd_(-1),
+          // The viewer can do without text, so a missing font isn't fatal like it is for the game
+          renderer_(font_.loadFromFile("BrickBreakerData/bebas.ttf") ? &font_ : nullptr)
+{
+}
+
+SpectatorViewer::~SpectatorViewer() {
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+bool SpectatorViewer::connect(const std::string& address, unsigned long sessionId) {
+    fd_ = Socket::connect(address);
+    if (fd_ < 0)
+        return false;
+
+    std::vector<uint8_t> message;
+    MessageWriter writer(message, MESSAGE_WATCH);
+    writer.writeVarint(uint32_t(sessionId));
+    writer.finish();
+    return send(fd_, message.data(), message.size(), MSG_NOSIGNAL) == ssize_t(message.size());
+}
+
+void SpectatorViewer::run() {
+    while (window_.isOpen()) {
+        Event event;
+        while (window_.pollEvent(event)) {
+            if (event.type == Event::Closed)
+                window_.close();
+        }
+
+        if (!receive()) {
+            std::cerr << "The game's stream ended" << std::endl;
+            return;
+        }
+
+        draw();
+    }
+}
+
+bool SpectatorViewer::receive() {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t numRead = ::read(fd_, buffer, sizeof(buffer));
+        if (numRead > 0) {
+            input_.insert(input_.end(), buffer, buffer + numRead);
+        }
+        else if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (numRead < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+
+    bool gotState = false;
+    bool gotKeyframe = false;
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    while (MessageReader::next(input_.data(), input_.size(), offset, type, payload)) {
+        if (type == MESSAGE_WELCOME)
+            continue;
+
+        if (!decoder_.apply(type, payload))
+            return false;
+
+        gotState = true;
+        gotKeyframe = gotKeyframe || type == MESSAGE_KEYFRAME || type == MESSAGE_KEYFRAME_BRICKS;
+    }
+    input_.erase(input_.begin(), input_.begin() + offset);
+
+    // Only the latest state is drawn, so several messages in one frame cost one update
+    if (gotState)
+        renderer_.update(decoder_.getState(), gotKeyframe);
+
+    return true;
+}
+
+void SpectatorViewer::draw() {
+    window_.clear(BACKGROUND_COLOR);
+    renderer_.draw(window_);
+    window_.display();
+}
@@ -0,0 +1,78 @@
+/**
+ * \file SpectatorViewer.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a thin client that draws a game streamed from a GameServer
+ */
+
+#ifndef BRICKBREAKER_SPECTATORVIEWER_H
+#define BRICKBREAKER_SPECTATORVIEWER_H
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "StateDecoder.h"
+#include "StateRenderer.h"
+
+/**
+ * \class SpectatorViewer
+ * \brief Watches a game on a server and draws it from the decoded stream
+ *
+ * \details Runs no simulation at all, it only draws the last state received with a StateRenderer. Brick positions are
+ *      only rebuilt on keyframes, deltas just clear destroyed bricks' colors. Linux only.
+ */
+class SpectatorViewer {
+public:
+    /**
+     * \brief Parametrized constructor for a viewer
+     *
+     * \param window    The window to draw in. It should be WINDOW_WIDTH by WINDOW_HEIGHT, like a headless game.
+     */
+    SpectatorViewer(sf::RenderWindow& window);
+
+    SpectatorViewer(const SpectatorViewer&) = delete;
+    SpectatorViewer& operator=(const SpectatorViewer&) = delete;
+
+    /**
+     * \brief Disconnects from the server
+     */
+    ~SpectatorViewer();
+
+    /**
+     * \brief Connects to a server and asks to watch one of its games
+     *
+     * \param address       The server's address (see Socket for the format)
+     *        sessionId     The id of the game to watch
+     *
+     * \return false if the connection couldn't be made
+     */
+    bool connect(const std::string& address, unsigned long sessionId);
+
+    /**
+     * \brief Draws the game until the window is closed or the server ends the stream
+     */
+    void run();
+
+private:
+    /**
+     * \brief Reads and applies every message that has arrived
+     *
+     * \return false if the connection closed or the stream was malformed
+     */
+    bool receive();
+
+    void draw();
+
+    sf::RenderWindow& window_;
+    int fd_;
+    StateDecoder decoder_;
+    std::vector<uint8_t> input_;    ///< Received bytes that don't make up a whole message yet
+    sf::Font font_;
+    StateRenderer renderer_;
+};
+
+#endif //BRICKBREAKER_SPECTATORVIEWER_H
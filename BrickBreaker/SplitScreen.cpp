@@ -0,0 +1,153 @@
+/**
+ * \file SplitScreen.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a window showing several independent games at once
+ */
+#include <algorithm>
+#include <chrono>
+#include "SplitScreen.h"
+
+using namespace sf;
+using namespace std;
+
+SplitScreen::Instance::Instance(unsigned int seed, const Font* font, const string& label)
+        : game(seed),
+          pilot(game),
+          autopilot(true),
+          renderer(font, label)
+{
+}
+
+SplitScreen::SplitScreen(RenderWindow& window, unsigned int numGames, unsigned int numPlayers, unsigned int seed)
+        : window_(window),
+          hasFont_(false),
+          numPlayers_(min(numPlayers, numGames)),
+          quads_(Quads),
+          triangles_(Triangles),
+          workers_(max(1u, min(numGames, thread::hardware_concurrency()))),
+          numFrames_(0),
+          stepSeconds_(0),
+          drawSeconds_(0),
+          numDrawCalls_(0)
+{
+    // Text is left out if the font can't be loaded
+    hasFont_ = font_.loadFromFile("BrickBreakerData/bebas.ttf");
+    const Font* font = hasFont_ ? &font_ : nullptr;
+
+    for (unsigned int i = 0; i < numGames; ++i) {
+        Instance* instance = new Instance(seed + i, font, (i < numPlayers_ ? "player " : "autopilot ")
+                                                          + to_string(i + 1) + "  ");
+        instance->autopilot = i >= numPlayers_;
+
+        // Two games sit side by side, three or four in a grid, each at half size
+        instance->transform.translate(WINDOW_WIDTH / 2.0f * (i % 2), WINDOW_HEIGHT / 2.0f * (i / 2));
+        instance->transform.scale(.5f, .5f);
+        instances_.push_back(instance);
+    }
+}
+
+SplitScreen::~SplitScreen() {
+    for (Instance* instance : instances_)
+        delete instance;
+}
+
+void SplitScreen::run() {
+    while (window_.isOpen()) {
+        Event event;
+        while (window_.pollEvent(event)) {
+            if (event.type == Event::Closed)
+                window_.close();
+            else if (event.type == Event::KeyPressed || event.type == Event::KeyReleased)
+                handleKey(event);
+        }
+
+        step();
+        draw();
+    }
+}
+
+void SplitScreen::handleKey(const Event& event) {
+    // Return restarts every player's game
+    if (event.key.code == Keyboard::Return) {
+        for (unsigned int i = 0; i < numPlayers_; ++i) {
+            Event restart = event;
+            instances_[i]->game.handleEvent(restart);
+        }
+        return;
+    }
+
+    const Keyboard::Key gameKeys[] = {Keyboard::J, Keyboard::L, Keyboard::A, Keyboard::D, Keyboard::Space};
+    for (unsigned int i = 0; i < numPlayers_; ++i) {
+        for (unsigned int j = 0; j < 5; ++j) {
+            if (event.key.code == SPLIT_SCREEN_KEYS[i][j]) {
+                Event translated = event;
+                translated.key.code = gameKeys[j];
+                instances_[i]->game.handleEvent(translated);
+                return;
+            }
+        }
+    }
+}
+
+void SplitScreen::step() {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    workers_.run([this](unsigned int worker) { stepGames(worker); });
+
+    stepSeconds_ += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ++numFrames_;
+}
+
+void SplitScreen::stepGames(unsigned int worker) {
+    for (unsigned long i = worker; i < instances_.size(); i += workers_.getNumThreads()) {
+        Instance& instance = *instances_[i];
+        if (instance.autopilot)
+            instance.pilot.play();
+        instance.game.step();
+        instance.game.saveState(instance.state);
+    }
+}
+
+void SplitScreen::draw() {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    // Renderers are updated on this thread since text shares the font, whose glyph cache isn't thread safe. The
+    // arrays keep their capacity when cleared, so this doesn't allocate once they have grown.
+    quads_.clear();
+    triangles_.clear();
+    for (Instance* instance : instances_) {
+        instance->renderer.update(instance->state, true);
+        instance->renderer.append(quads_, triangles_, instance->transform);
+    }
+
+    window_.clear(BACKGROUND_COLOR);
+    window_.draw(quads_);
+    window_.draw(triangles_);
+    for (Instance* instance : instances_) {
+        instance->renderer.drawText(window_, instance->transform);
+    }
+    numDrawCalls_ += 2 + (hasFont_ ? instances_.size() : 0);
+
+    drawSeconds_ += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    window_.display();
+}
+
+void SplitScreen::writeSummary(ostream& out) const {
+    if (numFrames_ == 0)
+        return;
+
+    unsigned int unbatchedDrawCalls = 0;
+    for (const Instance* instance : instances_)
+        unbatchedDrawCalls += instance->renderer.getNumDrawCalls();
+
+    out << "Games: " << instances_.size() << " (" << numPlayers_ << " played from the keyboard) on " << workers_.getNumThreads()
+        << " threads" << endl;
+    out << "Frames: " << numFrames_ << ", mean step " << stepSeconds_ / numFrames_ * 1000 << " ms, mean draw "
+        << drawSeconds_ / numFrames_ * 1000 << " ms" << endl;
+    out << "Draw calls per frame: " << double(numDrawCalls_) / numFrames_ << " batched, " << unbatchedDrawCalls
+        << " drawing each game separately" << endl;
+}
@@ -0,0 +1,136 @@
+/**
+ * \file SplitScreen.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a window showing several independent games at once
+ */
+
+#ifndef BRICKBREAKER_SPLITSCREEN_H
+#define BRICKBREAKER_SPLITSCREEN_H
+
+#include <ostream>
+#include <vector>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "Autopilot.h"
+#include "GameState.h"
+#include "GraphicsRunner.h"
+#include "StateRenderer.h"
+#include "WorkerPool.h"
+
+const unsigned int SPLIT_SCREEN_MAX_GAMES = 4;
+
+/**
+ * \class SplitScreen
+ * \brief Two to four games in one window, each in its own quarter or half, played from one keyboard or by autopilots
+ *
+ * \details The games are headless and drawn from snapshots. They are stepped in parallel, one worker thread per game
+ *      (the main thread is one of them), since games share nothing while stepping. Drawing is batched across games:
+ *      every game's renderer is appended into one quad array and one triangle array, already moved into its part of
+ *      the window, so the whole window takes two draw calls plus one text per game however many games there are. All
+ *      the text shares one font, so glyphs are only rendered once.
+ *
+ *      The first numPlayers games are played from the keyboard with the keys in SPLIT_SCREEN_KEYS, and the rest are
+ *      played by autopilots. Return restarts every player's game once it is over.
+ */
+class SplitScreen {
+public:
+    /**
+     * \brief Parametrized constructor for a split screen
+     *
+     * \param window        The window to draw in. Games are drawn at half size, so two games fit in a window
+     *                      WINDOW_WIDTH by WINDOW_HEIGHT / 2 and three or four in one WINDOW_WIDTH by WINDOW_HEIGHT.
+     *        numGames      How many games, 2 to SPLIT_SCREEN_MAX_GAMES
+     *        numPlayers    How many of the games are played from the keyboard
+     *        seed          Seed for the first game. Each game after it gets the next seed.
+     */
+    SplitScreen(sf::RenderWindow& window, unsigned int numGames, unsigned int numPlayers, unsigned int seed);
+
+    SplitScreen(const SplitScreen&) = delete;
+    SplitScreen& operator=(const SplitScreen&) = delete;
+
+    /**
+     * \brief Stops the worker threads and deletes the games
+     */
+    ~SplitScreen();
+
+    /**
+     * \brief Plays until the window is closed
+     */
+    void run();
+
+    /**
+     * \brief Writes how long stepping and drawing took per frame, and how many draw calls batching saved
+     */
+    void writeSummary(std::ostream& out) const;
+
+private:
+    /**
+     * \struct Instance
+     * \brief One game and everything used to play and draw it
+     */
+    struct Instance {
+        Instance(unsigned int seed, const sf::Font* font, const std::string& label);
+
+        GraphicsRunner game;
+        Autopilot pilot;
+        bool autopilot;
+        GameState state;            ///< Reused every frame to hand the game's state to its renderer
+        StateRenderer renderer;
+        sf::Transform transform;    ///< Where the game goes in the window
+    };
+
+    /**
+     * \brief Hands a key event to the game of the player whose key it is
+     */
+    void handleKey(const sf::Event& event);
+
+    /**
+     * \brief Steps every game once, in parallel, and waits for all of them
+     */
+    void step();
+
+    /**
+     * \brief Plays and steps every game whose index is worker plus a multiple of the number of threads
+     */
+    void stepGames(unsigned int worker);
+
+    /**
+     * \brief Updates every renderer and draws all games in one batch
+     */
+    void draw();
+
+    sf::RenderWindow& window_;
+    sf::Font font_;                     ///< Shared by every game's text
+    bool hasFont_;
+    std::vector<Instance*> instances_;
+    unsigned int numPlayers_;
+    sf::VertexArray quads_;             ///< Every game's barrier and bricks
+    sf::VertexArray triangles_;         ///< Every game's paddle and balls
+
+    WorkerPool workers_;                ///< One per game, up to one per hardware thread. The main thread is worker 0.
+
+    // Statistics
+    unsigned long numFrames_;
+    double stepSeconds_;
+    double drawSeconds_;                ///< Time spent building and submitting the batch, not waiting for display
+    unsigned long numDrawCalls_;
+};
+
+/**
+ * \brief The keys each keyboard player uses, standing in for J, L, A, D and Space in that order
+ */
+const sf::Keyboard::Key SPLIT_SCREEN_KEYS[SPLIT_SCREEN_MAX_GAMES][5] = {
+        {sf::Keyboard::A, sf::Keyboard::D, sf::Keyboard::Q, sf::Keyboard::E, sf::Keyboard::W},
+        {sf::Keyboard::J, sf::Keyboard::L, sf::Keyboard::U, sf::Keyboard::O, sf::Keyboard::I},
+        {sf::Keyboard::Left, sf::Keyboard::Right, sf::Keyboard::Delete, sf::Keyboard::PageDown, sf::Keyboard::Up},
+        {sf::Keyboard::Numpad4, sf::Keyboard::Numpad6, sf::Keyboard::Numpad7, sf::Keyboard::Numpad9,
+         sf::Keyboard::Numpad8}
+};
+
+#endif //BRICKBREAKER_SPLITSCREEN_H
@@ -9,12 +9,23 @@
  */
 #include <sys/stat.h>
 #include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "Brick.h"
 #include "StageBuilder.h"
 
-StageBuilder::StageBuilder(std::vector<Object*>& objects, sf::Vector2f stageSize,
+namespace {
+    std::mutex levelCacheMutex;
+    std::map<int, std::vector<std::string>> levelCache;    ///< Entries are never changed or removed once added
+    std::map<int, std::unique_ptr<BrickScript>> scriptCache;    ///< nullptr for levels without (working) scripts
+}
+
+StageBuilder::StageBuilder(std::vector<Object*>& objects, std::minstd_rand& random, sf::Vector2f stageSize,
                            sf::Vector2f origin, float brickHeight, float separation)
         : objects_(objects),
+          random_(random),
           stageSize_(stageSize),
           origin_(origin),
           brickHeight_(brickHeight),
@@ -31,22 +42,19 @@ bool StageBuilder::getLevel(int level) {
         // for placing the bricks.
         float brickWidth = ((stageSize_.x - separation_) / NUM_BRICKS_PER_LINE);
 
-        // See the random number generator for use in the next step
-        srand(time(NULL));
-
         // We want 6 random bricks to be special bricks, so make a vector of 6 brick indices that will be special
         int specials[NUM_SPECIAL_BRICKS];
-        for (int i = 0; i < NUM_SPECIAL_BRICKS; ++i) {
-            specials[i] = rand() % (NUM_BRICKS_PER_LINE * NUM_BRICK_ROWS);
+        for (int i = 0; i < int(NUM_SPECIAL_BRICKS); ++i) {
+            specials[i] = random_() % (NUM_BRICKS_PER_LINE * NUM_BRICK_ROWS);
         }
 
-        for (int row = 0; row < NUM_BRICK_ROWS; ++row) {
-            for (int col = 0; col < NUM_BRICKS_PER_LINE; ++col) {
+        for (int row = 0; row < int(NUM_BRICK_ROWS); ++row) {
+            for (int col = 0; col < int(NUM_BRICKS_PER_LINE); ++col) {
 
                 // Check if this brick is special
                 int k = 0;
-                for (; k < NUM_SPECIAL_BRICKS; k++) {
-                    if (specials[k] == row * NUM_BRICKS_PER_LINE + col) {
+                for (; k < int(NUM_SPECIAL_BRICKS); k++) {
+                    if (specials[k] == row * int(NUM_BRICKS_PER_LINE) + col) {
                         // This brick is in the list of special brick indexes, so mark it as such
                         objects_.push_back(
                                 new Brick(origin_.x + separation_ + brickWidth * col,
@@ -54,7 +62,7 @@ bool StageBuilder::getLevel(int level) {
                                                                             (brickHeight_ + separation_),
                                           brickWidth - separation_,
                                           brickHeight_,
-                                          SPECIALS[rand() % (sizeof(SPECIALS)/sizeof(char))] // Random special character
+                                          SPECIALS[random_() % (sizeof(SPECIALS)/sizeof(char))] // Random special character
                                 )
                         );
                         break;
@@ -99,6 +107,17 @@ void StageBuilder::addSafetyBricks(int numBricks) {
     }
 }
 
+void StageBuilder::addJunkRow(float top, int gap) {
+    float brickWidth = ((stageSize_.x - separation_) / NUM_BRICKS_PER_LINE);
+
+    for (int col = 0; col < int(NUM_BRICKS_PER_LINE); ++col) {
+        if (col != gap) {
+            objects_.push_back(new Brick(origin_.x + separation_ + brickWidth * col, top,
+                                         brickWidth - separation_, brickHeight_, 'j'));
+        }
+    }
+}
+
 void StageBuilder::checkDataFile() {
     // Make sure the data folder exists
     mkdir("BrickBreakerData", ACCESSPERMS);
@@ -115,9 +134,20 @@ void StageBuilder::checkDataFile() {
         // Also a readme file teaching people how to create a level
         std::ofstream readMeFile("BrickBreakerData/levels/README.txt");
         readMeFile << "To create your own level, create a file called \"<level #>.txt\". The stage builder will read "
-                              "spaces as empty slots, dashes as regular bricks, and tildas as special bricks. "
+                              "spaces as empty slots, dashes as regular bricks, and tildas as special bricks. Equals signs "
+                              "are hard bricks that take two hits, number signs reinforced bricks that take three, "
+                              "and at signs armored bricks that can't be destroyed (or need to be). Asterisks are "
+                              "explosive bricks that take out the bricks around them, setting off any other "
+                              "explosives they reach. "
                               "See \"2.txt\" for an example and make sure to put spaces at the end of lines if you want"
-                              " empty space there.";
+                              " empty space there.\n\n"
+                              "Digits are scripted bricks. Put the scripts in \"<level #>.scripts\" next to the level, "
+                              "each starting with a \"script <digit>\" line. A scripted brick runs its script whenever "
+                              "a ball hits it, and is only destroyed when the script says so (a level isn't cleared "
+                              "until every one is). For example, this brick spawns a ball on its third hit:\n\n"
+                              "script 1\n    hits\n    push 3\n    eq\n    jumpif third\n    end\nthird:\n"
+                              "    spawnball\n    destroy\n\n"
+                              "The instructions are listed in BrickScript.h.";
 
         // And close both files
         levelTwoFile.close();
@@ -126,21 +156,24 @@ void StageBuilder::checkDataFile() {
 }
 
 bool StageBuilder::loadLevelFromFile(int level) {
-    // Load the specified level file, and if it isn't found return false
-    std::ifstream levelFile("BrickBreakerData/levels/" + std::to_string(level) + ".txt");
-    if (!levelFile.is_open()) {
+    // Get the specified level's lines, and if the file isn't found return false
+    const std::vector<std::string>* lines = getLevelLines(level);
+    if (lines == nullptr) {
         return false;
     }
 
-    // Various variables used in the while loop below
-    std::string line;
+    // The level's scripts, if it has any
+    const BrickScript* scripts = getScripts(level);
+
+    // Various variables used in the loop below
     char special = '\0';
+    int script = -1;
     unsigned long numBricksPerLines = 0;
     float brickWidth = 0;
     int row = 0;
     int col = 0;
 
-    while (getline(levelFile, line)) {
+    for (const std::string& line : *lines) {
         col = 0;
         // If on the first line, store its length to determine how wide each brick should be
         if (numBricksPerLines == 0) {
@@ -148,18 +181,38 @@ bool StageBuilder::loadLevelFromFile(int level) {
             brickWidth = ((stageSize_.x - separation_) / numBricksPerLines);
         }
 
-        // If the line is too long, shorten it. If it is too short, add spaces.
-        if (line.size() > numBricksPerLines) {
-            line.resize(numBricksPerLines, ' ');
-        }
+        // If the line is too long, only use the start of it. The cached line is shared, so it isn't shortened in place.
+        for (unsigned long i = 0; i < line.size() && i < numBricksPerLines; ++i) {
+            char c = line[i];
 
-        for (char c : line) {
             // Get the appropriate special character based on the character read from file
+            script = -1;
             switch (c) {
                 case '-': special = '\0';
                           break;
 
-                case '~': special = SPECIALS[rand() % (sizeof(SPECIALS)/sizeof(char))]; // Random special character
+                case '~': special = SPECIALS[random_() % (sizeof(SPECIALS)/sizeof(char))]; // Random special character
+                          break;
+
+                case '=': special = 'h'; // Hard brick, takes two hits
+                          break;
+
+                case '#': special = 'r'; // Reinforced brick, takes three hits
+                          break;
+
+                case '@': special = 'a'; // Armored brick, can't be destroyed
+                          break;
+
+                case '*': special = 'e'; // Explosive brick, takes out the bricks around it
+                          break;
+
+                case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+                          // A digit runs that script, or is a regular brick if the level has no such script
+                          special = '\0';
+                          if (scripts != nullptr && scripts->hasScript(c - '0')) {
+                              special = 'x';
+                              script = c - '0';
+                          }
                           break;
 
                 default: c = ' '; // No brick in the default case
@@ -167,21 +220,62 @@ bool StageBuilder::loadLevelFromFile(int level) {
 
             // If the character in the file is a space, don't make a brick
             if (c != ' ') {
-                objects_.push_back(
-                        new Brick(origin_.x + separation_ + brickWidth * col,
-                                  origin_.y + separation_ + row * (brickHeight_ + separation_),
-                                  brickWidth - separation_,
-                                  brickHeight_,
-                                  special
-                        )
+                Brick* brick = new Brick(origin_.x + separation_ + brickWidth * col,
+                                         origin_.y + separation_ + row * (brickHeight_ + separation_),
+                                         brickWidth - separation_,
+                                         brickHeight_,
+                                         special
                 );
+                brick->script_ = script;
+                objects_.push_back(brick);
             }
             ++col;
         }
         ++row;
     }
 
-    // Close the file and return true to mark the load successful
-    levelFile.close();
     return true;
 }
+
+const std::vector<std::string>* StageBuilder::getLevelLines(int level) {
+    std::lock_guard<std::mutex> lock(levelCacheMutex);
+
+    auto cached = levelCache.find(level);
+    if (cached != levelCache.end()) {
+        return &cached->second;
+    }
+
+    std::ifstream levelFile("BrickBreakerData/levels/" + std::to_string(level) + ".txt");
+    if (!levelFile.is_open()) {
+        return nullptr;
+    }
+
+    std::vector<std::string>& lines = levelCache[level];
+    std::string line;
+    while (getline(levelFile, line)) {
+        lines.push_back(line);
+    }
+    return &lines;
+}
+
+const BrickScript* StageBuilder::getScripts(int level) {
+    std::lock_guard<std::mutex> lock(levelCacheMutex);
+
+    auto cached = scriptCache.find(level);
+    if (cached != scriptCache.end()) {
+        return cached->second.get();
+    }
+
+    // Compiled once for every game in the process. A level whose scripts don't compile is played without them.
+    std::unique_ptr<BrickScript>& scripts = scriptCache[level];
+    std::ifstream scriptFile("BrickBreakerData/levels/" + std::to_string(level) + ".scripts");
+    if (scriptFile.is_open()) {
+        std::string error;
+        scripts.reset(new BrickScript());
+        if (!scripts->compile(scriptFile, error)) {
+            std::cerr << "Could not compile the scripts for level " << level << ", " << error << std::endl;
+            scripts.reset();
+        }
+    }
+    return scripts.get();
+}
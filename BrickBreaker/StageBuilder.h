@@ -12,6 +12,10 @@
 #define BRICKBREAKER_STAGEBUILDER_H
 
 
+#include <random>
+#include <string>
+#include <vector>
+#include "BrickScript.h"
 #include "Object.h"
 
 /**
@@ -24,12 +28,13 @@ public:
      * \brief Parametrized constructor for a brick
      *
      * \param objects           A reference to the vector containing the game's objects. Needed to add bricks
+     *        random            The game's random number generator, used for random and special bricks
      *        stageSize         The width and height of the area inside the barrier where the stage builder will work
      *        origin            The position of the top left point of the building area
      *        brickHeight       How tall each brick should be
      *        separation        How much space should be between the bricks
      */
-    StageBuilder(std::vector<Object*>& objects, sf::Vector2f stageSize,
+    StageBuilder(std::vector<Object*>& objects, std::minstd_rand& random, sf::Vector2f stageSize,
                  sf::Vector2f origin, float brickHeight, float separation);
 
     /**
@@ -51,25 +56,47 @@ public:
      */
     void addSafetyBricks(int numBricks);
 
+    /**
+     * \brief Adds a row of junk bricks across the stage, laid out like the rows of level 1, with one brick left out
+     *
+     * \param top   The y position of the top of the row
+     *        gap   The column to leave empty
+     */
+    void addJunkRow(float top, int gap);
+
+    /**
+     * \brief Ensure the BrickBreakerData folder exists, and if it doesn't, populate it
+     *
+     * \details Can create a hard coded readme and sample level in case they were not included with the executable.
+     *      Games running on several threads should call this once before starting them, so none of them reads a level
+     *      file while another is still writing it.
+     */
+    static void checkDataFile();
+
+    /**
+     * \brief Returns a level's compiled brick scripts, or nullptr if it has none
+     *
+     * \details Scripts are read from "<level #>.scripts" next to the level file and compiled the first time any game
+     *      asks for them, then shared read only like the level's lines. Compile errors are printed and the level is
+     *      played with its scripted bricks as regular bricks.
+     */
+    static const BrickScript* getScripts(int level);
+
 private:
     std::vector<Object*>& objects_; ///< The stage builder needs access to the game's list of objects to add bricks
+    std::minstd_rand& random_;      ///< Shared with the game so a game can be replayed from its generator's state
     sf::Vector2f stageSize_;
     sf::Vector2f origin_;
     float brickHeight_;
     float separation_;
 
-    /**
-     * \brief Ensure the BrickBreakerData folder exists, and if it doesn't, populate it
-     *
-     * \details Can create a hard coded readme and sample level in case they were not included with the executable
-     */
-    void checkDataFile();
-
     /**
      * \brief Attempts to load the specified level from file
      *
      * \details Goes through the file line by line. If a dash is found, a brick is added to the game. If a tilda is
-     *          found, a random special brick is added to the game. If a space is found, the next brick will be
+     *          found, a random special brick is added to the game. Equals signs, number signs and at signs add hard,
+     *          reinforced and armored bricks (see BrickBatch). If a digit is found, a brick running that script
+     *          (see getScripts()) is added to the game. If a space is found, the next brick will be
      *          positioned to create an empty space. The number of bricks per line is determined using the first line of
      *          the file. Any other lines that are not long enough will be assumed to have trailing spaces. Lines that
      *          are too long will be cut short.
@@ -77,6 +104,14 @@ private:
      * \return True if the load was successful, false otherwise
      */
     bool loadLevelFromFile(int level);
+
+    /**
+     * \brief Returns the lines of a level file, or nullptr if there is no such file
+     *
+     * \details Each file is read once, the first time any game asks for it, and its lines are then shared read only by
+     *      every game in the process. A ghost or a batch of headless games loading levels doesn't touch the disk again.
+     */
+    static const std::vector<std::string>* getLevelLines(int level);
 };
 
 
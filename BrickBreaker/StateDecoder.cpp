@@ -0,0 +1,236 @@
+/**
+ * \file StateDecoder.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the decoder that rebuilds a game's visible state from keyframe and delta messages
+ */
+#include <algorithm>
+#include "BrickBatch.h"
+#include "Constants.h"
+#include "StateDecoder.h"
+#include "StateEncoder.h"
+
+StateDecoder::StateDecoder()
+        : state_(),
+          hasKeyframe_(false),
+          numBricks_(0)
+{
+}
+
+bool StateDecoder::apply(MessageType type, MessageReader& payload) {
+    if (type == MESSAGE_KEYFRAME) {
+        hasKeyframe_ = false;
+        if (!readKeyframe(payload)) {
+            numBricks_ = 0;
+            return false;
+        }
+        hasKeyframe_ = state_.bricks.size() == numBricks_;
+        return true;
+    }
+
+    // The rest of a keyframe's bricks follow it, before anything else
+    if (type == MESSAGE_KEYFRAME_BRICKS && !hasKeyframe_ && state_.bricks.size() < numBricks_) {
+        if (!readKeyframeBricks(payload)) {
+            numBricks_ = 0;
+            return false;
+        }
+        hasKeyframe_ = state_.bricks.size() == numBricks_;
+        return true;
+    }
+
+    if (type == MESSAGE_DELTA && hasKeyframe_) {
+        return readDelta(payload);
+    }
+
+    return false;
+}
+
+bool StateDecoder::hasKeyframe() const {
+    return hasKeyframe_;
+}
+
+const GameState& StateDecoder::getState() const {
+    return state_;
+}
+
+bool StateDecoder::readKeyframe(MessageReader& payload) {
+    state_.tick = payload.readVarint();
+    state_.level = int(payload.readVarint());
+    state_.status = char(payload.readU8());
+    readPaddle(payload, state_.paddle);
+
+    // Only the first KEYFRAME_MAX_BRICKS bricks are in the keyframe itself, the rest come in the messages after it.
+    // Those are only added once they arrive, so a malformed count can't make the list huge.
+    numBricks_ = payload.readVarint();
+    if (!payload.isValid())
+        return false;
+
+    state_.bricks.resize(std::min<unsigned long>(numBricks_, KEYFRAME_MAX_BRICKS));
+    for (GameState::BrickState& brick : state_.bricks)
+        readBrick(payload, brick);
+
+    return readBalls(payload, true, true);
+}
+
+bool StateDecoder::readKeyframeBricks(MessageReader& payload) {
+    // The messages come in order, each carrying on from the last
+    uint32_t first = payload.readVarint();
+    uint32_t numBricks = payload.readVarint();
+    if (!payload.isValid() || first != state_.bricks.size() || numBricks > KEYFRAME_MAX_BRICKS
+        || first + numBricks > numBricks_)
+        return false;
+
+    state_.bricks.resize(first + numBricks);
+    for (unsigned long i = first; i < state_.bricks.size(); ++i)
+        readBrick(payload, state_.bricks[i]);
+
+    return payload.isValid() && payload.atEnd();
+}
+
+bool StateDecoder::readDelta(MessageReader& payload) {
+    // Read everything before changing the state so a malformed delta leaves it untouched
+    unsigned long tick = payload.readVarint();
+    uint8_t flags = payload.readU8();
+
+    char status = state_.status;
+    if (flags & StateEncoder::DELTA_STATUS)
+        status = char(payload.readU8());
+
+    const uint8_t* destroyed = nullptr;
+    if (flags & StateEncoder::DELTA_BRICKS) {
+        destroyed = payload.readBytes((state_.bricks.size() + 7) / 8);
+        if (destroyed == nullptr)
+            return false;
+    }
+
+    // The damaged bricks' bits are followed by one byte of hit points for each bit set
+    const uint8_t* damaged = nullptr;
+    const uint8_t* hitPoints = nullptr;
+    if (flags & StateEncoder::DELTA_DAMAGE) {
+        damaged = payload.readBytes((state_.bricks.size() + 7) / 8);
+        if (damaged == nullptr)
+            return false;
+
+        unsigned long numDamaged = 0;
+        for (unsigned long i = 0; i < state_.bricks.size(); ++i) {
+            if (damaged[i / 8] & (1 << (i % 8)))
+                ++numDamaged;
+        }
+        hitPoints = payload.readBytes(numDamaged);
+        if (hitPoints == nullptr)
+            return false;
+    }
+
+    GameState::PaddleState paddle = state_.paddle;
+    if (flags & StateEncoder::DELTA_PADDLE)
+        readPaddle(payload, paddle);
+
+    // Balls are last, and readBalls() only changes the state if they are all there
+    if (!payload.isValid() || !readBalls(payload, false, (flags & StateEncoder::DELTA_RADII) != 0))
+        return false;
+
+    state_.tick = tick;
+    state_.status = status;
+    state_.paddle = paddle;
+    if (destroyed != nullptr) {
+        for (unsigned long i = 0; i < state_.bricks.size(); ++i) {
+            if (destroyed[i / 8] & (1 << (i % 8)))
+                state_.bricks[i].deleted = true;
+        }
+    }
+    if (damaged != nullptr) {
+        for (unsigned long i = 0; i < state_.bricks.size(); ++i) {
+            if (damaged[i / 8] & (1 << (i % 8)))
+                state_.bricks[i].hitPoints = *hitPoints++;
+        }
+    }
+
+    return true;
+}
+
+void StateDecoder::readPaddle(MessageReader& payload, GameState::PaddleState& paddle) {
+    paddle.x = StateEncoder::dequantize(payload.readU16());
+    paddle.y = StateEncoder::dequantize(payload.readU16());
+    paddle.width = StateEncoder::dequantize(payload.readU16());
+    paddle.rotation = int16_t(payload.readU16()) / 100.0f;
+}
+
+void StateDecoder::readBrick(MessageReader& payload, GameState::BrickState& brick) {
+    brick.x = StateEncoder::dequantize(payload.readU16());
+    brick.y = StateEncoder::dequantize(payload.readU16());
+    brick.width = StateEncoder::dequantize(payload.readU16());
+    brick.height = StateEncoder::dequantize(payload.readU16());
+    brick.special = char(payload.readU8());
+    brick.deleted = false;
+    brick.hitPoints = BrickBatch::getMaxHitPoints(brick.special) > 1 ? payload.readU8() : uint8_t(0);
+
+    // Scripts run on the server, so scripted bricks are shown in their first shade
+    brick.script = -1;
+    brick.hits = 0;
+    brick.shade = 0;
+}
+
+bool StateDecoder::readBalls(MessageReader& payload, bool keyframe, bool radii) {
+    // A ball takes at least 1 byte, so a count bigger than that can only come from a malformed message
+    uint32_t numBalls = payload.readVarint();
+    if (!payload.isValid() || numBalls > MAX_MESSAGE_SIZE)
+        return false;
+
+    // Decode into scratch tracks first, so the state only changes if every ball is there. This mirrors
+    // StateEncoder::writeBalls().
+    unsigned long numTracked = keyframe ? 0 : std::min<unsigned long>(tracks_.size(), numBalls);
+    newTracks_.resize(numBalls);
+    for (unsigned long i = 0; i < numBalls; ++i) {
+        StateEncoder::BallTrack& track = newTracks_[i];
+
+        if (keyframe) {
+            track.x = payload.readU16();
+            track.y = payload.readU16();
+            track.xVel = 0;
+            track.yVel = 0;
+        }
+        else if (i < numTracked) {
+            track = tracks_[i];
+            int32_t xError, yError;
+            readBallError(payload, xError, yError);
+            track.update(track.x + track.xVel + xError, track.y + track.yVel + yError);
+        }
+        else {
+            readBallError(payload, track.x, track.y);
+            track.xVel = 0;
+            track.yVel = 0;
+            track.radius = StateEncoder::quantize(BALL_RADIUS);
+        }
+
+        if (radii)
+            track.radius = payload.readU16();
+    }
+
+    if (!payload.isValid() || !payload.atEnd())
+        return false;
+
+    tracks_.swap(newTracks_);
+    state_.balls.resize(numBalls);
+    for (unsigned long i = 0; i < numBalls; ++i) {
+        state_.balls[i].x = StateEncoder::dequantize(uint16_t(tracks_[i].x));
+        state_.balls[i].y = StateEncoder::dequantize(uint16_t(tracks_[i].y));
+        state_.balls[i].radius = StateEncoder::dequantize(tracks_[i].radius);
+    }
+
+    return true;
+}
+
+void StateDecoder::readBallError(MessageReader& payload, int32_t& xError, int32_t& yError) {
+    uint32_t first = payload.readVarint();
+    if (first < 64) {
+        xError = StateEncoder::unzigzag(first & 7);
+        yError = StateEncoder::unzigzag(first >> 3);
+    }
+    else {
+        xError = StateEncoder::unzigzag(first - 64);
+        yError = StateEncoder::unzigzag(payload.readVarint());
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * \file StateDecoder.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the decoder that rebuilds a game's visible state from keyframe and delta messages
+ */
+
+#ifndef BRICKBREAKER_STATEDECODER_H
+#define BRICKBREAKER_STATEDECODER_H
+
+#include "GameState.h"
+#include "NetMessage.h"
+#include "StateEncoder.h"
+
+/**
+ * \class StateDecoder
+ * \brief The client side of StateEncoder
+ *
+ * \details Keeps a GameState holding what the server last sent. Only the visible parts of it are filled in: the tick,
+ *      level, status, paddle position, size and rotation, brick positions, sizes, specials and hit points, and ball
+ *      positions and radii. Destroyed bricks stay in the list with deleted set, so brick indices match the last
+ *      keyframe. A keyframe whose bricks were split over several messages only counts as applied once the last of them
+ *      has been.
+ */
+class StateDecoder {
+public:
+    StateDecoder();
+
+    /**
+     * \brief Applies a keyframe, keyframe bricks or delta message to the state
+     *
+     * \return false if the message was malformed, or was a delta or keyframe bricks with no keyframe before it. The
+     *      state is left as it was before a delta that fails, but may be partly updated by a keyframe that fails.
+     */
+    bool apply(MessageType type, MessageReader& payload);
+
+    /**
+     * \brief Returns true once a keyframe has been applied
+     */
+    bool hasKeyframe() const;
+
+    /**
+     * \brief Returns the state as of the last message applied
+     */
+    const GameState& getState() const;
+
+private:
+    bool readKeyframe(MessageReader& payload);
+    bool readKeyframeBricks(MessageReader& payload);
+    bool readDelta(MessageReader& payload);
+    static void readPaddle(MessageReader& payload, GameState::PaddleState& paddle);
+    static void readBrick(MessageReader& payload, GameState::BrickState& brick);
+    bool readBalls(MessageReader& payload, bool keyframe, bool radii);
+    static void readBallError(MessageReader& payload, int32_t& xError, int32_t& yError);
+
+    GameState state_;
+    bool hasKeyframe_;
+    unsigned long numBricks_;   ///< How many bricks the last keyframe has, which may be more than have arrived
+    std::vector<StateEncoder::BallTrack> tracks_;       ///< Each ball as of the last message, to predict the next
+    std::vector<StateEncoder::BallTrack> newTracks_;    ///< Scratch space for reading balls
+};
+
+#endif //BRICKBREAKER_STATEDECODER_H
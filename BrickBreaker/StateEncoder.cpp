@@ -0,0 +1,304 @@
+/**
+ * \file StateEncoder.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements the encoder that turns game snapshots into compact keyframe and delta messages
+ */
+#include <algorithm>
+#include <cmath>
+#include "BrickBatch.h"
+#include "Constants.h"
+#include "StateEncoder.h"
+
+bool StateEncoder::QuantizedPaddle::operator!=(const QuantizedPaddle& other) const {
+    return x != other.x || y != other.y || width != other.width || rotation != other.rotation;
+}
+
+void StateEncoder::BallTrack::update(int32_t newX, int32_t newY) {
+    xVel = newX - x;
+    yVel = newY - y;
+    x = newX;
+    y = newY;
+}
+
+StateEncoder::StateEncoder()
+        : needsKeyframe_(true),
+          wroteKeyframe_(false),
+          level_(0),
+          status_('\0'),
+          paddle_()
+{
+}
+
+void StateEncoder::encode(const GameState& state, std::vector<uint8_t>& out) {
+    wroteKeyframe_ = needsKeyframe_ || state.level != level_ || !writeDelta(state, out);
+    if (wroteKeyframe_) {
+        writeKeyframe(state, out);
+    }
+}
+
+bool StateEncoder::wroteKeyframe() const {
+    return wroteKeyframe_;
+}
+
+uint32_t StateEncoder::zigzag(int32_t value) {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+}
+
+int32_t StateEncoder::unzigzag(uint32_t value) {
+    return int32_t(value >> 1) ^ -int32_t(value & 1);
+}
+
+void StateEncoder::reset() {
+    needsKeyframe_ = true;
+}
+
+uint16_t StateEncoder::quantize(float position) {
+    // Balls leave through the bottom of the stage, so clamp rather than let them wrap around
+    return uint16_t(std::min(std::max(std::round(position * POSITION_SCALE), 0.0f), 65535.0f));
+}
+
+float StateEncoder::dequantize(uint16_t value) {
+    return value / POSITION_SCALE;
+}
+
+unsigned long StateEncoder::getHeapBytes() const {
+    return bricks_.capacity() * sizeof(GameState::BrickState) + alive_.capacity() / 8 + destroyed_.capacity()
+           + damaged_.capacity() + hitPoints_.capacity() + balls_.capacity() * sizeof(BallTrack);
+}
+
+StateEncoder::QuantizedPaddle StateEncoder::quantize(const GameState::PaddleState& paddle) {
+    QuantizedPaddle quantized;
+    quantized.x = quantize(paddle.x);
+    quantized.y = quantize(paddle.y);
+    quantized.width = quantize(paddle.width);
+    quantized.rotation = int16_t(std::round(paddle.rotation * 100));
+    return quantized;
+}
+
+void StateEncoder::writeKeyframe(const GameState& state, std::vector<uint8_t>& out) {
+    needsKeyframe_ = false;
+    level_ = state.level;
+    status_ = state.status;
+    paddle_ = quantize(state.paddle);
+
+    // Remember the bricks that are still standing, later deltas refer to them by their index in this list
+    bricks_.clear();
+    for (const GameState::BrickState& brick : state.bricks) {
+        if (!brick.deleted)
+            bricks_.push_back(brick);
+    }
+    alive_.assign(bricks_.size(), true);
+
+    MessageWriter message(out, MESSAGE_KEYFRAME);
+    message.writeVarint(uint32_t(state.tick));
+    message.writeVarint(uint32_t(state.level));
+    message.writeU8(uint8_t(state.status));
+    writePaddle(message);
+
+    // The count is every brick, even if only the first KEYFRAME_MAX_BRICKS of them fit
+    unsigned long numBricks = std::min<unsigned long>(bricks_.size(), KEYFRAME_MAX_BRICKS);
+    message.writeVarint(uint32_t(bricks_.size()));
+    for (unsigned long i = 0; i < numBricks; ++i)
+        writeBrick(message, bricks_[i]);
+
+    writeBalls(message, state, true, true);
+
+    // A keyframe that doesn't fit in a message can't be sent, so try again next time
+    if (!message.finish()) {
+        needsKeyframe_ = true;
+        return;
+    }
+
+    // Then the rest of the bricks, which always fit since each message holds as many as the keyframe
+    for (unsigned long first = numBricks; first < bricks_.size(); first += KEYFRAME_MAX_BRICKS) {
+        unsigned long last = std::min<unsigned long>(first + KEYFRAME_MAX_BRICKS, bricks_.size());
+
+        MessageWriter more(out, MESSAGE_KEYFRAME_BRICKS);
+        more.writeVarint(uint32_t(first));
+        more.writeVarint(uint32_t(last - first));
+        for (unsigned long i = first; i < last; ++i)
+            writeBrick(more, bricks_[i]);
+        more.finish();
+    }
+}
+
+bool StateEncoder::writeDelta(const GameState& state, std::vector<uint8_t>& out) {
+    // Walk the keyframe's bricks alongside the current ones. Any living keyframe brick that isn't next in the current
+    // list has been destroyed since the last message, and any that is but has fewer hit points has been damaged.
+    destroyed_.assign((bricks_.size() + 7) / 8, 0);
+    damaged_.assign(destroyed_.size(), 0);
+    hitPoints_.clear();
+    bool anyDestroyed = false;
+
+    unsigned long current = 0;
+    for (unsigned long i = 0; i < bricks_.size(); ++i) {
+        if (!alive_[i])
+            continue;
+
+        // Skip bricks that are only marked for deletion, they are gone as far as the client is concerned
+        while (current < state.bricks.size() && state.bricks[current].deleted)
+            ++current;
+
+        if (current < state.bricks.size() && state.bricks[current].x == bricks_[i].x
+            && state.bricks[current].y == bricks_[i].y) {
+            if (state.bricks[current].hitPoints != bricks_[i].hitPoints) {
+                damaged_[i / 8] |= uint8_t(1 << (i % 8));
+                hitPoints_.push_back(state.bricks[current].hitPoints);
+                bricks_[i].hitPoints = state.bricks[current].hitPoints;
+            }
+            ++current;
+        }
+        else {
+            destroyed_[i / 8] |= uint8_t(1 << (i % 8));
+            anyDestroyed = true;
+        }
+    }
+
+    // Bricks the keyframe doesn't know about can only be sent in a new keyframe
+    while (current < state.bricks.size() && state.bricks[current].deleted)
+        ++current;
+    if (current != state.bricks.size())
+        return false;
+
+    QuantizedPaddle paddle = quantize(state.paddle);
+
+    uint8_t flags = 0;
+    if (state.status != status_)
+        flags |= DELTA_STATUS;
+    if (anyDestroyed)
+        flags |= DELTA_BRICKS;
+    if (paddle != paddle_)
+        flags |= DELTA_PADDLE;
+    if (!hitPoints_.empty())
+        flags |= DELTA_DAMAGE;
+    if (radiiChanged(state))
+        flags |= DELTA_RADII;
+
+    MessageWriter message(out, MESSAGE_DELTA);
+    message.writeVarint(uint32_t(state.tick));
+    message.writeU8(flags);
+
+    if (flags & DELTA_STATUS) {
+        status_ = state.status;
+        message.writeU8(uint8_t(status_));
+    }
+
+    if (flags & DELTA_BRICKS) {
+        message.writeBytes(destroyed_.data(), destroyed_.size());
+        for (unsigned long i = 0; i < bricks_.size(); ++i) {
+            if (destroyed_[i / 8] & (1 << (i % 8)))
+                alive_[i] = false;
+        }
+    }
+
+    if (flags & DELTA_DAMAGE) {
+        message.writeBytes(damaged_.data(), damaged_.size());
+        message.writeBytes(hitPoints_.data(), hitPoints_.size());
+    }
+
+    if (flags & DELTA_PADDLE) {
+        paddle_ = paddle;
+        writePaddle(message);
+    }
+
+    writeBalls(message, state, false, (flags & DELTA_RADII) != 0);
+
+    if (!message.finish())
+        needsKeyframe_ = true;
+    return true;
+}
+
+void StateEncoder::writePaddle(MessageWriter& message) const {
+    message.writeU16(paddle_.x);
+    message.writeU16(paddle_.y);
+    message.writeU16(paddle_.width);
+    message.writeU16(uint16_t(paddle_.rotation));
+}
+
+void StateEncoder::writeBrick(MessageWriter& message, const GameState::BrickState& brick) {
+    message.writeU16(quantize(brick.x));
+    message.writeU16(quantize(brick.y));
+    message.writeU16(quantize(brick.width));
+    message.writeU16(quantize(brick.height));
+    message.writeU8(uint8_t(brick.special));
+    if (BrickBatch::getMaxHitPoints(brick.special) > 1)
+        message.writeU8(brick.hitPoints);
+}
+
+void StateEncoder::writeBalls(MessageWriter& message, const GameState& state, bool keyframe, bool radii) {
+    uint32_t numBalls = 0;
+    for (const GameState::BallState& ball : state.balls) {
+        if (!ball.deleted)
+            ++numBalls;
+    }
+
+    // Balls without a track yet are predicted to be at 0, 0, and start their track still
+    unsigned long numTracked = keyframe ? 0 : std::min<unsigned long>(balls_.size(), numBalls);
+    balls_.resize(numBalls);
+
+    message.writeVarint(numBalls);
+    unsigned long i = 0;
+    for (const GameState::BallState& ball : state.balls) {
+        if (ball.deleted)
+            continue;
+
+        BallTrack& track = balls_[i];
+        int32_t x = quantize(ball.x);
+        int32_t y = quantize(ball.y);
+
+        if (keyframe) {
+            message.writeU16(uint16_t(x));
+            message.writeU16(uint16_t(y));
+        }
+        else if (i < numTracked) {
+            writeBallError(message, zigzag(x - (track.x + track.xVel)), zigzag(y - (track.y + track.yVel)));
+        }
+        else {
+            writeBallError(message, zigzag(x), zigzag(y));
+        }
+
+        track.radius = quantize(ball.radius);
+        if (radii)
+            message.writeU16(track.radius);
+
+        if (i < numTracked) {
+            track.update(x, y);
+        }
+        else {
+            track.x = x;
+            track.y = y;
+            track.xVel = 0;
+            track.yVel = 0;
+        }
+        ++i;
+    }
+}
+
+bool StateEncoder::radiiChanged(const GameState& state) const {
+    unsigned long i = 0;
+    for (const GameState::BallState& ball : state.balls) {
+        if (ball.deleted)
+            continue;
+
+        uint16_t radius = i < balls_.size() ? balls_[i].radius : quantize(BALL_RADIUS);
+        if (quantize(ball.radius) != radius)
+            return true;
+        ++i;
+    }
+    return false;
+}
+
+void StateEncoder::writeBallError(MessageWriter& message, uint32_t xError, uint32_t yError) {
+    // Both errors are usually tiny, so pack them into one byte when they fit in 3 bits each
+    if (xError < 8 && yError < 8) {
+        message.writeU8(uint8_t(xError | (yError << 3)));
+    }
+    else {
+        message.writeVarint(xError + 64);
+        message.writeVarint(yError);
+    }
+}
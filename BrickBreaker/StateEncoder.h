@@ -0,0 +1,172 @@
+/**
+ * \file StateEncoder.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the encoder that turns game snapshots into compact keyframe and delta messages
+ */
+
+#ifndef BRICKBREAKER_STATEENCODER_H
+#define BRICKBREAKER_STATEENCODER_H
+
+#include <vector>
+#include "GameState.h"
+#include "NetMessage.h"
+
+/**
+ * \class StateEncoder
+ * \brief Encodes the visible part of each tick's GameState as a delta from the previous one
+ *
+ * \details Only what a client needs to draw the game is sent, with positions quantized to 1/POSITION_SCALE of a
+ *      pixel. A keyframe holds the tick, level, status, paddle, every brick and every ball. A delta holds the tick,
+ *      the status and paddle only if they changed, one bit per keyframe brick with the bits of newly destroyed bricks
+ *      set (only if any were destroyed), the same again for bricks that lost hit points followed by what each has
+ *      left (only if any did), and every ball.
+ *
+ *      Ball radii are quantized like positions. A keyframe sends every ball's radius, and a delta sends them all only
+ *      when one has changed since the last message (a new ball is taken to have been BALL_RADIUS).
+ *
+ *      Balls in a delta are sent as the difference from where they would be if they kept moving as they did over the
+ *      last two messages. Between bounces that difference is just quantization noise, so most balls take a single
+ *      byte no matter how many there are. A ball with no history (a new one, or a keyframe's) is predicted to be
+ *      at 0, 0. Balls are matched up by their order, so a ball leaving shifts the rest, which only costs bytes.
+ *
+ *      Bricks are never added during a level and always stay in the same order, so the encoder can tell which bricks
+ *      are gone by walking the keyframe's bricks alongside the current ones. A new keyframe is written when the level
+ *      changes, when bricks appear, and after reset(). A stage with more than KEYFRAME_MAX_BRICKS bricks doesn't fit
+ *      in one message, so the keyframe holds the first KEYFRAME_MAX_BRICKS and MESSAGE_KEYFRAME_BRICKS messages right
+ *      behind it hold the rest.
+ *
+ *      Keyframe payload:   tick (varint), level (varint), status (u8), paddle, brick count (varint), bricks
+ *                          (x, y, width, height as u16, special as u8, then hit points as u8 for bricks that take
+ *                          several hits), ball count (varint), balls (x, y, radius as u16)
+ *      Keyframe bricks:    index of the first brick (varint), brick count (varint), bricks as in a keyframe
+ *      Delta payload:      tick (varint), flags (u8), [status (u8)], [destroyed brick bits], [damaged brick bits,
+ *                          then hit points (u8) per bit set], [paddle], ball count (varint), balls (x, y differences
+ *                          from the prediction, see writeBallError(), then [radius as u16])
+ *      Paddle:             x, y, width as u16, rotation as a signed u16 in hundredths of a degree
+ */
+class StateEncoder {
+public:
+    /**
+     * \brief Bits of the flags byte at the start of a delta, saying which optional parts follow
+     */
+    enum DeltaFlags : uint8_t {
+        DELTA_STATUS = 1,
+        DELTA_BRICKS = 2,
+        DELTA_PADDLE = 4,
+        DELTA_DAMAGE = 8,
+        DELTA_RADII = 16,
+    };
+
+    StateEncoder();
+
+    /**
+     * \brief Appends a keyframe or delta message for a snapshot to a buffer
+     *
+     * \details Deltas are relative to the snapshot passed to the previous call, so every message has to reach the
+     *      client. If one has to be dropped, call reset() so the next message is a keyframe.
+     */
+    void encode(const GameState& state, std::vector<uint8_t>& out);
+
+    /**
+     * \brief Makes the next encode() write a keyframe
+     */
+    void reset();
+
+    /**
+     * \brief Returns true if the last encode() wrote a keyframe
+     */
+    bool wroteKeyframe() const;
+
+    /**
+     * \struct BallTrack
+     * \brief A ball's last quantized position and radius, and how far it moved in the last message, shared with
+     *      StateDecoder
+     */
+    struct BallTrack {
+        int32_t x, y;
+        int32_t xVel, yVel;
+        uint16_t radius;
+
+        /**
+         * \brief Moves the track to a new position, remembering how far it moved
+         */
+        void update(int32_t newX, int32_t newY);
+    };
+
+    /**
+     * \brief Maps a signed value to an unsigned one so small magnitudes of either sign make short varints
+     */
+    static uint32_t zigzag(int32_t value);
+    static int32_t unzigzag(uint32_t value);
+
+    /**
+     * \brief Converts a position to the fixed point value sent over the network
+     */
+    static uint16_t quantize(float position);
+
+    /**
+     * \brief Converts a fixed point value sent over the network back to a position
+     */
+    static float dequantize(uint16_t value);
+
+    /**
+     * \brief Returns the number of bytes the encoder holds on the heap
+     */
+    unsigned long getHeapBytes() const;
+
+private:
+    /**
+     * \brief The paddle as it was last sent
+     */
+    struct QuantizedPaddle {
+        uint16_t x, y, width;
+        int16_t rotation;
+
+        bool operator!=(const QuantizedPaddle& other) const;
+    };
+
+    void writeKeyframe(const GameState& state, std::vector<uint8_t>& out);
+
+    /**
+     * \brief Writes a delta, or returns false if the snapshot can't be described as one
+     */
+    bool writeDelta(const GameState& state, std::vector<uint8_t>& out);
+
+    void writePaddle(MessageWriter& message) const;
+    static void writeBrick(MessageWriter& message, const GameState::BrickState& brick);
+    void writeBalls(MessageWriter& message, const GameState& state, bool keyframe, bool radii);
+
+    /**
+     * \brief Returns true if any ball's quantized radius differs from the one last sent for it
+     */
+    bool radiiChanged(const GameState& state) const;
+
+    /**
+     * \brief Writes a ball's zigzagged prediction errors. Values under 64 are both errors packed 3 bits each, anything
+     *      else is the x error plus 64 followed by the y error as another varint.
+     */
+    static void writeBallError(MessageWriter& message, uint32_t xError, uint32_t yError);
+    static QuantizedPaddle quantize(const GameState::PaddleState& paddle);
+
+    bool needsKeyframe_;
+    bool wroteKeyframe_;
+    int level_;
+    char status_;
+    QuantizedPaddle paddle_;
+    std::vector<GameState::BrickState> bricks_;     ///< The bricks as of the last keyframe, hit points as last sent
+    std::vector<bool> alive_;                       ///< Which of those bricks haven't been destroyed yet
+    std::vector<uint8_t> destroyed_;                ///< Scratch space for a delta's destroyed brick bits
+    std::vector<uint8_t> damaged_;                  ///< And for its damaged brick bits
+    std::vector<uint8_t> hitPoints_;                ///< And for the hit points the damaged bricks have left
+    std::vector<BallTrack> balls_;                  ///< Each ball as it was last sent, in order
+};
+
+const float POSITION_SCALE = 8;     ///< Positions are sent in 1/8ths of a pixel
+
+const unsigned int KEYFRAME_MAX_BRICKS = 4096;  ///< Most bricks in one message, 40KB, leaving a keyframe room for balls
+
+#endif //BRICKBREAKER_STATEENCODER_H
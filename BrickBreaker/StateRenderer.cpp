@@ -0,0 +1,213 @@
+/**
+ * \file StateRenderer.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a renderer that draws a game from a snapshot of its state
+ */
+#include <cmath>
+#include "BrickBatch.h"
+#include "Constants.h"
+#include "StateRenderer.h"
+
+using namespace sf;
+
+namespace {
+    const unsigned int BARRIER_VERTICES = 3 * 4;    ///< The barrier's three walls at the start of quads_
+
+    const unsigned int PADDLE_VERTICES = 2 * 3 + 2 * RENDER_PADDLE_END_SEGMENTS * 3;   ///< At the start of triangles_
+
+    /**
+     * \brief Writes a rectangle into four vertices of a quads array
+     */
+    void writeQuad(Vertex* quad, float left, float top, float width, float height, const Color& color) {
+        quad[0] = Vertex(Vector2f(left, top), color);
+        quad[1] = Vertex(Vector2f(left + width, top), color);
+        quad[2] = Vertex(Vector2f(left + width, top + height), color);
+        quad[3] = Vertex(Vector2f(left, top + height), color);
+    }
+}
+
+StateRenderer::StateRenderer(const Font* font, const std::string& label)
+        : quads_(Quads, BARRIER_VERTICES),
+          triangles_(Triangles, PADDLE_VERTICES),
+          label_(label),
+          alpha_(255),
+          hasFont_(font != nullptr),
+          hasState_(false)
+{
+    // The barrier never moves, laid out like Barrier's walls
+    writeQuad(&quads_[0], BARRIER_BUFFER, BARRIER_BUFFER + BANNER_HEIGHT,
+              BARRIER_WIDTH, WINDOW_HEIGHT - BARRIER_BUFFER - BANNER_HEIGHT, DEFAULT_COLOR);
+    writeQuad(&quads_[4], BARRIER_BUFFER, BARRIER_BUFFER + BANNER_HEIGHT,
+              WINDOW_WIDTH - 2 * BARRIER_BUFFER - BARRIER_WIDTH, BARRIER_WIDTH, DEFAULT_COLOR);
+    writeQuad(&quads_[8], WINDOW_WIDTH - BARRIER_BUFFER - BARRIER_WIDTH, BARRIER_BUFFER + BANNER_HEIGHT,
+              BARRIER_WIDTH, WINDOW_HEIGHT - BARRIER_BUFFER - BANNER_HEIGHT, DEFAULT_COLOR);
+
+    if (hasFont_) {
+        text_.setFont(*font);
+        text_.setCharacterSize((unsigned int)(BANNER_HEIGHT - 2 * BARRIER_BUFFER));
+        text_.setColor(DEFAULT_COLOR);
+        text_.setPosition(BARRIER_BUFFER, 0);
+    }
+}
+
+void StateRenderer::update(const GameState& state, bool layoutChanged) {
+    updateBricks(state, layoutChanged || !hasState_);
+    updatePaddle(state);
+    updateBalls(state);
+
+    if (hasFont_) {
+        std::string status = state.status == 'p' ? "  paused" : state.status == 'o' ? "  game over"
+                             : state.status == 'c' ? "  level cleared" : "";
+        text_.setString(label_ + "level " + std::to_string(state.level) + status);
+    }
+
+    hasState_ = true;
+}
+
+void StateRenderer::updateMoving(const GameState& state) {
+    updatePaddle(state);
+    updateBalls(state);
+    hasState_ = true;
+}
+
+void StateRenderer::setAlpha(Uint8 alpha) {
+    alpha_ = alpha;
+}
+
+void StateRenderer::updateBricks(const GameState& state, bool layoutChanged) {
+    const std::vector<GameState::BrickState>& bricks = state.bricks;
+
+    if (layoutChanged) {
+        quads_.resize(BARRIER_VERTICES + bricks.size() * 4);
+        for (unsigned long i = 0; i < bricks.size(); ++i) {
+            const GameState::BrickState& brick = bricks[i];
+            writeQuad(&quads_[BARRIER_VERTICES + i * 4], brick.x, brick.y, brick.width, brick.height, Color());
+        }
+    }
+
+    // Same colors as Brick, and fully transparent once destroyed
+    for (unsigned long i = 0; i < bricks.size(); ++i) {
+        const GameState::BrickState& brick = bricks[i];
+        Color color = brick.deleted ? Color::Transparent
+                      : brick.special == 's' ? SAFETY_BRICK_COLOR
+                      : brick.special == 'j' ? JUNK_BRICK_COLOR
+                      : brick.special == 'x' ? SCRIPTED_BRICK_COLORS[brick.shade % NUM_SCRIPTED_BRICK_COLORS]
+                      : brick.special == 'h' || brick.special == 'r' ? BrickBatch::getHitPointColor(brick.hitPoints)
+                      : brick.special == 'a' ? ARMORED_BRICK_COLOR
+                      : brick.special == 'e' ? EXPLOSIVE_BRICK_COLOR
+                      : brick.special != '\0' ? SPECIAL_BRICK_COLOR
+                      : BRICK_COLOR;
+        for (unsigned int j = 0; j < 4; ++j) {
+            quads_[BARRIER_VERTICES + i * 4 + j].color = color;
+        }
+    }
+}
+
+void StateRenderer::updatePaddle(const GameState& state) {
+    // The rectangle hangs down from the paddle's position and turns around it (see Paddle)
+    float rotation = state.paddle.rotation * .017453294f;
+    Vector2f along(cosf(rotation), sinf(rotation));
+    Vector2f down(-along.y, along.x);
+    Vector2f position(state.paddle.x, state.paddle.y);
+    Vector2f halfLength = state.paddle.width / 2 * along;
+    Vector2f height = PADDLE_HEIGHT * down;
+    Color color = fade(DEFAULT_COLOR);
+
+    Vertex* paddle = &triangles_[0];
+    paddle[0] = Vertex(position - halfLength, color);
+    paddle[1] = Vertex(position + halfLength, color);
+    paddle[2] = Vertex(position + halfLength + height, color);
+    paddle[3] = Vertex(position - halfLength, color);
+    paddle[4] = Vertex(position + halfLength + height, color);
+    paddle[5] = Vertex(position - halfLength + height, color);
+
+    // The ends sit either side of a point half the paddle's height below its position, as Paddle places them
+    Vector2f edge[RENDER_PADDLE_END_SEGMENTS + 1];
+    for (unsigned int j = 0; j <= RENDER_PADDLE_END_SEGMENTS; ++j) {
+        float angle = 2 * float(M_PI) * j / RENDER_PADDLE_END_SEGMENTS;
+        edge[j] = PADDLE_HEIGHT / 2 * Vector2f(cosf(angle), sinf(angle));
+    }
+    Vector2f center(state.paddle.x, state.paddle.y + PADDLE_HEIGHT / 2);
+    writeFan(&paddle[6], center - halfLength, edge, RENDER_PADDLE_END_SEGMENTS, color);
+    writeFan(&paddle[6 + RENDER_PADDLE_END_SEGMENTS * 3], center + halfLength, edge, RENDER_PADDLE_END_SEGMENTS,
+             color);
+}
+
+void StateRenderer::updateBalls(const GameState& state) {
+    const std::vector<GameState::BallState>& balls = state.balls;
+    triangles_.resize(PADDLE_VERTICES + balls.size() * RENDER_BALL_SEGMENTS * 3);
+
+    // The points around the edge of a ball of radius 1 centered on 0, 0
+    Vector2f unit[RENDER_BALL_SEGMENTS + 1];
+    for (unsigned int j = 0; j <= RENDER_BALL_SEGMENTS; ++j) {
+        float angle = 2 * float(M_PI) * j / RENDER_BALL_SEGMENTS;
+        unit[j] = Vector2f(cosf(angle), sinf(angle));
+    }
+
+    // Scaled to each ball's radius, which is usually the same as the last ball's
+    Vector2f edge[RENDER_BALL_SEGMENTS + 1];
+    float edgeRadius = 0;
+    for (unsigned long i = 0; i < balls.size(); ++i) {
+        if (balls[i].radius != edgeRadius) {
+            edgeRadius = balls[i].radius;
+            for (unsigned int j = 0; j <= RENDER_BALL_SEGMENTS; ++j)
+                edge[j] = unit[j] * edgeRadius;
+        }
+        writeFan(&triangles_[PADDLE_VERTICES + i * RENDER_BALL_SEGMENTS * 3], Vector2f(balls[i].x, balls[i].y),
+                 edge, RENDER_BALL_SEGMENTS, fade(BALL_COLOR));
+    }
+}
+
+Color StateRenderer::fade(Color color) const {
+    color.a = Uint8(color.a * alpha_ / 255);
+    return color;
+}
+
+void StateRenderer::writeFan(Vertex* fan, const Vector2f& center, const Vector2f* edge, unsigned int segments,
+                             const Color& color) {
+    for (unsigned int j = 0; j < segments; ++j) {
+        fan[j * 3] = Vertex(center, color);
+        fan[j * 3 + 1] = Vertex(center + edge[j], color);
+        fan[j * 3 + 2] = Vertex(center + edge[j + 1], color);
+    }
+}
+
+void StateRenderer::draw(RenderWindow& window, const Transform& transform) const {
+    window.draw(quads_, transform);
+    if (hasState_)
+        window.draw(triangles_, transform);
+
+    drawText(window, transform);
+}
+
+void StateRenderer::drawMoving(RenderWindow& window) const {
+    if (hasState_)
+        window.draw(triangles_);
+}
+
+void StateRenderer::append(VertexArray& quads, VertexArray& triangles, const Transform& transform) const {
+    for (unsigned long i = 0; i < quads_.getVertexCount(); ++i) {
+        const Vertex& vertex = quads_[i];
+        quads.append(Vertex(transform.transformPoint(vertex.position), vertex.color));
+    }
+
+    if (hasState_) {
+        for (unsigned long i = 0; i < triangles_.getVertexCount(); ++i) {
+            const Vertex& vertex = triangles_[i];
+            triangles.append(Vertex(transform.transformPoint(vertex.position), vertex.color));
+        }
+    }
+}
+
+void StateRenderer::drawText(RenderWindow& window, const Transform& transform) const {
+    if (hasFont_)
+        window.draw(text_, transform);
+}
+
+unsigned int StateRenderer::getNumDrawCalls() const {
+    return 1 + (hasState_ ? 1 : 0) + (hasFont_ ? 1 : 0);
+}
@@ -0,0 +1,131 @@
+/**
+ * \file StateRenderer.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a renderer that draws a game from a snapshot of its state
+ */
+
+#ifndef BRICKBREAKER_STATERENDERER_H
+#define BRICKBREAKER_STATERENDERER_H
+
+#include <string>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "GameState.h"
+
+/**
+ * \class StateRenderer
+ * \brief Draws a game from a GameState instead of from the game's objects
+ *
+ * \details Used to draw games that aren't drawn by their own GraphicsRunner: games streamed from a server, and games
+ *      simulated headless (versus, split screen and ghosts). Everything is in two vertex arrays, one of quads for the
+ *      barrier and bricks and one of triangles for the paddle and balls, so a game of any size takes two draw calls
+ *      plus one for its text. Several renderers can also be appended into one pair of arrays and drawn together (see
+ *      SplitScreen). Everything is laid out as in a WINDOW_WIDTH by WINDOW_HEIGHT window, so draw with a view or
+ *      transform to put it somewhere else.
+ */
+class StateRenderer {
+public:
+    /**
+     * \brief Parametrized constructor for a renderer
+     *
+     * \param font      The font for the banner text, or nullptr to leave the text out. It can be shared by any number
+     *                  of renderers, as long as they are all used from one thread.
+     *        label     Written in the banner before the level
+     */
+    StateRenderer(const sf::Font* font, const std::string& label = "");
+
+    /**
+     * \brief Rebuilds the vertices from a state
+     *
+     * \param state             The state to draw
+     *        layoutChanged     Whether bricks may have been added, removed or moved since the last update. If not,
+     *                          only their colors are rewritten so destroyed bricks disappear.
+     */
+    void update(const GameState& state, bool layoutChanged);
+
+    /**
+     * \brief Rebuilds only the paddle and balls from a state, for drawing with drawMoving()
+     */
+    void updateMoving(const GameState& state);
+
+    /**
+     * \brief Sets how opaque the paddle and balls are from the next update on, 255 being fully opaque
+     */
+    void setAlpha(sf::Uint8 alpha);
+
+    /**
+     * \brief Draws the last state given to update(), without clearing or displaying the window
+     *
+     * \param window        The window to draw in
+     *        transform     Where in the window to draw, applied on top of the window's view
+     */
+    void draw(sf::RenderWindow& window, const sf::Transform& transform = sf::Transform::Identity) const;
+
+    /**
+     * \brief Draws only the paddle and balls, in one draw call. Used for ghosts, whose bricks aren't shown.
+     */
+    void drawMoving(sf::RenderWindow& window) const;
+
+    /**
+     * \brief Appends the renderer's vertices, moved by a transform, to shared arrays so they can be drawn in a batch
+     *
+     * \param quads         Vertex array of quads to append the barrier and bricks to
+     *        triangles     Vertex array of triangles to append the paddle and balls to
+     *        transform     Where the game goes in the arrays' coordinates
+     */
+    void append(sf::VertexArray& quads, sf::VertexArray& triangles, const sf::Transform& transform) const;
+
+    /**
+     * \brief Draws only the banner text, for renderers whose vertices were appended to a batch
+     */
+    void drawText(sf::RenderWindow& window, const sf::Transform& transform) const;
+
+    /**
+     * \brief Returns how many draw calls draw() makes
+     */
+    unsigned int getNumDrawCalls() const;
+
+private:
+    void updateBricks(const GameState& state, bool layoutChanged);
+
+    void updatePaddle(const GameState& state);
+
+    void updateBalls(const GameState& state);
+
+    /**
+     * \brief Returns a color with the renderer's alpha
+     */
+    sf::Color fade(sf::Color color) const;
+
+    /**
+     * \brief Writes a fan of triangles approximating a circle
+     *
+     * \param fan           Where to write the fan's segments * 3 vertices
+     *        center        The circle's center
+     *        edge          The offsets of segments + 1 points around the edge from the center
+     *        segments      How many triangles the fan has
+     */
+    static void writeFan(sf::Vertex* fan, const sf::Vector2f& center, const sf::Vector2f* edge, unsigned int segments,
+                         const sf::Color& color);
+
+    sf::VertexArray quads_;         ///< The barrier's three walls, then four vertices per brick in the state's order
+    sf::VertexArray triangles_;     ///< The paddle's rectangle and two end fans, then a fan per ball
+    sf::Text text_;
+    std::string label_;
+    sf::Uint8 alpha_;               ///< Opacity of the paddle and balls
+    bool hasFont_;
+    bool hasState_;                 ///< Only the barrier and text are drawn until the first update
+};
+
+const unsigned int RENDER_BALL_SEGMENTS = 12;       ///< Triangles in each ball's fan
+
+const unsigned int RENDER_PADDLE_END_SEGMENTS = 8;  ///< Triangles in each of the paddle's rounded ends
+
+#endif //BRICKBREAKER_STATERENDERER_H
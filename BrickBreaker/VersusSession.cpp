@@ -0,0 +1,495 @@
+/**
+ * \file VersusSession.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a two player versus match kept in sync between two processes with rollback
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Autopilot.h"
+#include "Socket.h"
+#include "StateRenderer.h"
+#include "VersusSession.h"
+
+using namespace sf;
+using namespace std;
+
+VersusSession::VersusSession()
+        : fd_(-1),
+          localPlayer_(0),
+          inputDelay_(VERSUS_INPUT_DELAY),
+          games_{nullptr, nullptr},
+          tick_(0),
+          rollbackTick_(0),
+          outputSent_(0),
+          latency_(0),
+          nextChecksumTick_(VERSUS_CHECKSUM_INTERVAL),
+          numFrames_(0),
+          numStalls_(0),
+          numRollbacks_(0),
+          numTicksResimulated_(0),
+          maxRollbackTicks_(0),
+          rollbackSeconds_(0),
+          maxRollbackSeconds_(0),
+          numChecksumsMatched_(0),
+          numDesyncs_(0)
+{
+}
+
+VersusSession::~VersusSession() {
+    if (fd_ >= 0)
+        close(fd_);
+
+    delete games_[0];
+    delete games_[1];
+}
+
+bool VersusSession::host(const string& address, unsigned int seed, unsigned int inputDelay) {
+    int listener = Socket::listen(address);
+    if (listener < 0)
+        return false;
+
+    cout << "Waiting for an opponent on " << address << endl;
+    pollfd waiting = {listener, POLLIN, 0};
+    while (fd_ < 0) {
+        if (poll(&waiting, 1, -1) < 0 && errno != EINTR) {
+            cerr << "Could not wait for an opponent: " << strerror(errno) << endl;
+            close(listener);
+            return false;
+        }
+        fd_ = Socket::accept(listener);
+    }
+    close(listener);
+
+    localPlayer_ = 0;
+    start(seed, min(inputDelay, VERSUS_MAX_INPUT_DELAY));
+
+    MessageWriter writer(message_, MESSAGE_VERSUS_HELLO);
+    writer.writeVarint(seed);
+    writer.writeVarint(inputDelay_);
+    writer.finish();
+    send(message_);
+    return flush();
+}
+
+bool VersusSession::join(const string& address) {
+    fd_ = Socket::connect(address);
+    if (fd_ < 0)
+        return false;
+
+    // The host's greeting is the first message, but its first inputs may arrive right behind it
+    chrono::steady_clock::time_point giveUp = chrono::steady_clock::now() + chrono::seconds(5);
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    while (!MessageReader::next(input_.data(), input_.size(), offset, type, payload)) {
+        pollfd waiting = {fd_, POLLIN, 0};
+        if (chrono::steady_clock::now() > giveUp || (poll(&waiting, 1, 100) < 0 && errno != EINTR)) {
+            cerr << "The host didn't answer" << endl;
+            return false;
+        }
+
+        uint8_t buffer[4096];
+        ssize_t numRead = ::read(fd_, buffer, sizeof(buffer));
+        if (numRead > 0) {
+            input_.insert(input_.end(), buffer, buffer + numRead);
+        }
+        else if (numRead == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            cerr << "The host closed the connection" << endl;
+            return false;
+        }
+    }
+
+    unsigned int seed = payload.readVarint();
+    unsigned int inputDelay = payload.readVarint();
+    if (type != MESSAGE_VERSUS_HELLO || !payload.isValid() || inputDelay > VERSUS_MAX_INPUT_DELAY) {
+        cerr << "The host sent an invalid greeting" << endl;
+        return false;
+    }
+    input_.erase(input_.begin(), input_.begin() + offset);
+
+    localPlayer_ = 1;
+    start(seed, inputDelay);
+    return true;
+}
+
+void VersusSession::setLatency(double seconds) {
+    latency_ = seconds;
+}
+
+void VersusSession::start(unsigned int seed, unsigned int inputDelay) {
+    inputDelay_ = inputDelay;
+    games_[0] = new GraphicsRunner(seed);
+    games_[1] = new GraphicsRunner(seed);
+
+    // Neither player has pressed anything during the first inputDelay ticks
+    tick_ = games_[0]->getTick();
+    for (unsigned int player = 0; player < 2; ++player) {
+        fill(inputs_[player], inputs_[player] + VERSUS_INPUT_HISTORY, 0);
+        fill(usedInputs_[player], usedInputs_[player] + VERSUS_INPUT_HISTORY, 0);
+        numInputs_[player] = tick_ + inputDelay_;
+    }
+    rollbackTick_ = tick_;
+    nextChecksumTick_ = tick_ + VERSUS_CHECKSUM_INTERVAL;
+}
+
+bool VersusSession::advance(uint8_t localInput) {
+    ++numFrames_;
+    unsigned int remotePlayer = 1 - localPlayer_;
+
+    if (!receive())
+        return false;
+
+    if (rollbackTick_ < tick_)
+        rollback();
+    checkSums();
+
+    // Going further would mean predicting more than VERSUS_MAX_ROLLBACK ticks of the opponent's input
+    if (tick_ >= numInputs_[remotePlayer] + VERSUS_MAX_ROLLBACK) {
+        ++numStalls_;
+        return flush();
+    }
+
+    // The local input is for inputDelay_ ticks from now, and the opponent gets it right away
+    unsigned long inputTick = numInputs_[localPlayer_]++;
+    inputs_[localPlayer_][inputTick % VERSUS_INPUT_HISTORY] = localInput;
+
+    MessageWriter writer(message_, MESSAGE_VERSUS_INPUT);
+    writer.writeVarint(uint32_t(inputTick));
+    writer.writeU8(localInput);
+    writer.finish();
+    send(message_);
+
+    simulate(tick_);
+    ++tick_;
+    rollbackTick_ = tick_;
+
+    return flush();
+}
+
+void VersusSession::simulate(unsigned long tick) {
+    for (unsigned int player = 0; player < 2; ++player) {
+        games_[player]->saveState(snapshots_[player][tick % (VERSUS_MAX_ROLLBACK + 1)]);
+
+        // Until a player's input for the tick arrives, assume they are still holding the same keys
+        unsigned long known = min(tick, numInputs_[player] - 1);
+        uint8_t input = numInputs_[player] > 0 ? inputs_[player][known % VERSUS_INPUT_HISTORY] : 0;
+        uint8_t previous = tick > 0 ? usedInputs_[player][(tick - 1) % VERSUS_INPUT_HISTORY] : 0;
+
+        usedInputs_[player][tick % VERSUS_INPUT_HISTORY] = input;
+        applyInput(*games_[player], previous, input);
+    }
+
+    games_[0]->step();
+    games_[1]->step();
+
+    for (unsigned int player = 0; player < 2; ++player) {
+        for (unsigned int i = 0; i < games_[player]->getNumSpecialsCleared(); ++i) {
+            games_[1 - player]->addJunkRow();
+        }
+    }
+}
+
+void VersusSession::rollback() {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    games_[0]->restoreState(snapshots_[0][rollbackTick_ % (VERSUS_MAX_ROLLBACK + 1)]);
+    games_[1]->restoreState(snapshots_[1][rollbackTick_ % (VERSUS_MAX_ROLLBACK + 1)]);
+
+    for (unsigned long tick = rollbackTick_; tick < tick_; ++tick) {
+        simulate(tick);
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ++numRollbacks_;
+    numTicksResimulated_ += tick_ - rollbackTick_;
+    maxRollbackTicks_ = max(maxRollbackTicks_, tick_ - rollbackTick_);
+    rollbackSeconds_ += seconds;
+    maxRollbackSeconds_ = max(maxRollbackSeconds_, seconds);
+
+    rollbackTick_ = tick_;
+}
+
+void VersusSession::applyInput(GraphicsRunner& game, uint8_t previous, uint8_t current) {
+    uint8_t changed = previous ^ current;
+    for (unsigned int i = 0; changed != 0; ++i, changed >>= 1) {
+        if (changed & 1) {
+            game.processKey(current & (1 << i) ? Event::KeyPressed : Event::KeyReleased, VERSUS_KEYS[i]);
+        }
+    }
+}
+
+bool VersusSession::receive() {
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t numRead = ::read(fd_, buffer, sizeof(buffer));
+        if (numRead > 0) {
+            input_.insert(input_.end(), buffer, buffer + numRead);
+        }
+        else if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        else if (numRead < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+
+    unsigned int remotePlayer = 1 - localPlayer_;
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    while (MessageReader::next(input_.data(), input_.size(), offset, type, payload)) {
+        if (type == MESSAGE_VERSUS_INPUT) {
+            // Inputs arrive in order over the stream, so each one is for the next tick
+            unsigned long tick = payload.readVarint();
+            uint8_t keys = payload.readU8();
+            if (!payload.isValid() || tick != numInputs_[remotePlayer]
+                || tick >= tick_ + VERSUS_MAX_ROLLBACK + 2 * VERSUS_MAX_INPUT_DELAY) {
+                cerr << "The opponent sent input out of order" << endl;
+                return false;
+            }
+
+            inputs_[remotePlayer][tick % VERSUS_INPUT_HISTORY] = keys;
+            ++numInputs_[remotePlayer];
+
+            // Ticks already simulated with a different guess have to be simulated again
+            if (tick < tick_ && keys != usedInputs_[remotePlayer][tick % VERSUS_INPUT_HISTORY])
+                rollbackTick_ = min(rollbackTick_, tick);
+        }
+        else if (type == MESSAGE_VERSUS_CHECKSUM) {
+            unsigned long tick = payload.readVarint();
+            uint32_t hash = payload.readVarint();
+            if (!payload.isValid()) {
+                cerr << "The opponent sent an invalid checksum" << endl;
+                return false;
+            }
+            remoteChecksums_.push_back(make_pair(tick, hash));
+        }
+        else {
+            cerr << "The opponent sent an unexpected message" << endl;
+            return false;
+        }
+    }
+    input_.erase(input_.begin(), input_.begin() + offset);
+
+    return true;
+}
+
+void VersusSession::checkSums() {
+    // A tick's snapshots are final once both players' input before it is known and any rollback has been done
+    unsigned int remotePlayer = 1 - localPlayer_;
+    if (nextChecksumTick_ < tick_ && nextChecksumTick_ <= numInputs_[remotePlayer]) {
+        ostringstream text;
+        snapshots_[0][nextChecksumTick_ % (VERSUS_MAX_ROLLBACK + 1)].write(text);
+        snapshots_[1][nextChecksumTick_ % (VERSUS_MAX_ROLLBACK + 1)].write(text);
+
+        // FNV-1a of both games written out
+        uint32_t hash = 2166136261u;
+        for (char c : text.str()) {
+            hash = (hash ^ uint8_t(c)) * 16777619u;
+        }
+        localChecksums_.push_back(make_pair(nextChecksumTick_, hash));
+
+        MessageWriter writer(message_, MESSAGE_VERSUS_CHECKSUM);
+        writer.writeVarint(uint32_t(nextChecksumTick_));
+        writer.writeVarint(hash);
+        writer.finish();
+        send(message_);
+
+        nextChecksumTick_ += VERSUS_CHECKSUM_INTERVAL;
+    }
+
+    // Both peers check the same ticks in the same order
+    while (!localChecksums_.empty() && !remoteChecksums_.empty()) {
+        if (localChecksums_.front() == remoteChecksums_.front()) {
+            ++numChecksumsMatched_;
+        }
+        else {
+            if (numDesyncs_ == 0)
+                cerr << "The games went out of sync by tick " << localChecksums_.front().first << endl;
+            ++numDesyncs_;
+        }
+        localChecksums_.pop_front();
+        remoteChecksums_.pop_front();
+    }
+}
+
+void VersusSession::send(const vector<uint8_t>& message) {
+    if (latency_ > 0) {
+        delayed_.insert(delayed_.end(), message.begin(), message.end());
+        delayedSizes_.push_back(make_pair(now() + latency_, message.size()));
+    }
+    else {
+        output_.insert(output_.end(), message.begin(), message.end());
+    }
+    message_.clear();
+}
+
+bool VersusSession::flush() {
+    // Move the messages that have waited out the latency to the output, oldest first
+    double time = now();
+    unsigned long numDue = 0;
+    while (!delayedSizes_.empty() && delayedSizes_.front().first <= time) {
+        numDue += delayedSizes_.front().second;
+        delayedSizes_.pop_front();
+    }
+    if (numDue > 0) {
+        output_.insert(output_.end(), delayed_.begin(), delayed_.begin() + numDue);
+        delayed_.erase(delayed_.begin(), delayed_.begin() + numDue);
+    }
+
+    while (outputSent_ < output_.size()) {
+        ssize_t numSent = ::send(fd_, output_.data() + outputSent_, output_.size() - outputSent_, MSG_NOSIGNAL);
+        if (numSent > 0) {
+            outputSent_ += numSent;
+        }
+        else if (numSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        else if (numSent < 0 && errno == EINTR) {
+            continue;
+        }
+        else {
+            return false;
+        }
+    }
+
+    output_.clear();
+    outputSent_ = 0;
+    return true;
+}
+
+void VersusSession::run(RenderWindow& window, bool autopilot) {
+    // Each game is laid out for a whole window, and drawn at half size on its half of this one
+    View views[2];
+    for (unsigned int side = 0; side < 2; ++side) {
+        views[side].reset(FloatRect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT));
+        views[side].setViewport(FloatRect(.5f * side, 0, .5f, 1));
+    }
+
+    // The font is shared by both renderers. Text is left out if it can't be loaded.
+    Font font;
+    const Font* textFont = font.loadFromFile("BrickBreakerData/bebas.ttf") ? &font : nullptr;
+    StateRenderer renderers[2] = {StateRenderer(textFont, "you  "), StateRenderer(textFont, "opponent  ")};
+    GameState state;
+
+    vector<Event> events;
+    Autopilot pilot(getGame(localPlayer_), &events);
+    uint8_t input = 0;
+
+    while (window.isOpen()) {
+        Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == Event::Closed)
+                window.close();
+            else if (!autopilot)
+                input = updateInput(input, event);
+        }
+
+        if (autopilot) {
+            events.clear();
+            pilot.play();
+            for (const Event& pilotEvent : events) {
+                input = updateInput(input, pilotEvent);
+            }
+        }
+
+        if (!advance(input)) {
+            cerr << "The opponent left" << endl;
+            return;
+        }
+
+        window.clear(BACKGROUND_COLOR);
+        for (unsigned int side = 0; side < 2; ++side) {
+            // The local player is always on the left, and bricks come and go every tick so the layout is redone
+            games_[side == 0 ? localPlayer_ : 1 - localPlayer_]->saveState(state);
+            renderers[side].update(state, true);
+            window.setView(views[side]);
+            renderers[side].draw(window);
+        }
+        window.display();
+    }
+}
+
+void VersusSession::runHeadless(double seconds) {
+    vector<Event> events;
+    Autopilot pilot(getGame(localPlayer_), &events);
+    uint8_t input = 0;
+
+    chrono::steady_clock::duration frame = chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(1.0 / FRAME_RATE));
+    chrono::steady_clock::time_point nextFrame = chrono::steady_clock::now();
+    chrono::steady_clock::time_point end = nextFrame + chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(seconds));
+
+    while (nextFrame < end) {
+        events.clear();
+        pilot.play();
+        for (const Event& event : events) {
+            input = updateInput(input, event);
+        }
+
+        if (!advance(input)) {
+            cerr << "The opponent left" << endl;
+            return;
+        }
+
+        nextFrame += frame;
+        this_thread::sleep_until(nextFrame);
+    }
+}
+
+void VersusSession::writeSummary(ostream& out) const {
+    double budget = SLOW_FRAME_TIME / 1000;
+    out << "Player " << localPlayer_ + 1 << " of 2, input delay " << inputDelay_ << " ticks, latency "
+        << latency_ * 1000 << " ms each way" << endl;
+    out << "Frames: " << numFrames_ << ", ticks " << tick_ << ", stalled " << numStalls_ << endl;
+    out << "Rollbacks: " << numRollbacks_ << ", " << numTicksResimulated_ << " ticks re-simulated, longest "
+        << maxRollbackTicks_ << " ticks (at most " << VERSUS_MAX_ROLLBACK << ")" << endl;
+    if (numRollbacks_ > 0) {
+        out << "Rollback time: mean " << rollbackSeconds_ / numRollbacks_ * 1000 << " ms, longest "
+            << maxRollbackSeconds_ * 1000 << " ms, budget " << budget * 1000 << " ms" << endl;
+    }
+    out << "Checksums: " << numChecksumsMatched_ << " matched, " << numDesyncs_ << " out of sync" << endl;
+    for (unsigned int player = 0; player < 2; ++player) {
+        out << "Player " << player + 1 << ": level " << games_[player]->getLevel() << ", status '"
+            << (games_[player]->getStatus() == '\0' ? ' ' : games_[player]->getStatus()) << "'" << endl;
+    }
+}
+
+GraphicsRunner& VersusSession::getGame(unsigned int player) {
+    return *games_[player];
+}
+
+unsigned int VersusSession::getLocalPlayer() const {
+    return localPlayer_;
+}
+
+uint8_t VersusSession::updateInput(uint8_t input, const Event& event) {
+    if (event.type != Event::KeyPressed && event.type != Event::KeyReleased)
+        return input;
+
+    for (unsigned int i = 0; i < sizeof(VERSUS_KEYS) / sizeof(VERSUS_KEYS[0]); ++i) {
+        if (event.key.code == VERSUS_KEYS[i]) {
+            return event.type == Event::KeyPressed ? uint8_t(input | (1 << i)) : uint8_t(input & ~(1 << i));
+        }
+    }
+    return input;
+}
+
+double VersusSession::now() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,232 @@
+/**
+ * \file VersusSession.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a two player versus match kept in sync between two processes with rollback
+ */
+
+#ifndef BRICKBREAKER_VERSUSSESSION_H
+#define BRICKBREAKER_VERSUSSESSION_H
+
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Window/Event.hpp>
+#include "GameState.h"
+#include "GraphicsRunner.h"
+#include "NetMessage.h"
+
+const unsigned int VERSUS_MAX_ROLLBACK = 8;         ///< Most ticks a game may run ahead of its opponent's input
+
+const unsigned int VERSUS_INPUT_DELAY = 2;          ///< Default ticks between sampling an input and applying it
+
+const unsigned int VERSUS_MAX_INPUT_DELAY = 15;     ///< Keeps every input that might be needed in the history
+
+const unsigned int VERSUS_INPUT_HISTORY = 64;       ///< Ticks of input kept for each player
+
+const unsigned long VERSUS_CHECKSUM_INTERVAL = FRAME_RATE;     ///< Ticks between checks that both peers agree
+
+/**
+ * \class VersusSession
+ * \brief Two players, each with their own stage, played from two processes connected by a socket
+ *
+ * \details Both processes simulate both games (headless, from the same seed) and only send each other their input,
+ *      one byte of held keys per tick. Nothing else needs to be sent since the games are deterministic. Clearing an
+ *      extra ball or long paddle brick sends a junk row to the opponent's stage.
+ *
+ *      Local input is applied inputDelay ticks after it is sampled, which hides that much latency completely. The
+ *      opponent's input for ticks it hasn't arrived for yet is predicted to be the same as its last known input. When
+ *      the real input arrives and differs from the prediction, both games are restored from the snapshot taken at the
+ *      start of that tick and re-simulated up to the present (a rollback). A game never runs more than
+ *      VERSUS_MAX_ROLLBACK ticks past its opponent's last known input, so a rollback re-simulates at most that many
+ *      ticks; past that it waits (stalls) instead.
+ *
+ *      Every VERSUS_CHECKSUM_INTERVAL ticks, once a tick's input is known from both players, each peer sends a hash
+ *      of both games at that tick so a desync is noticed. An artificial latency can be added to everything sent, to
+ *      try the match with two processes on one machine. Linux only.
+ */
+class VersusSession {
+public:
+    VersusSession();
+
+    VersusSession(const VersusSession&) = delete;
+    VersusSession& operator=(const VersusSession&) = delete;
+
+    /**
+     * \brief Closes the connection and deletes the games
+     */
+    ~VersusSession();
+
+    /**
+     * \brief Waits for an opponent to connect to an address, then starts the match. The host is player 0.
+     *
+     * \param address       Where to listen (see Socket for the format)
+     *        seed          Seed for both games, so both players get the same stages
+     *        inputDelay    Ticks of input delay, at most VERSUS_MAX_INPUT_DELAY. The guest uses the host's.
+     *
+     * \return false if the address couldn't be listened on or the opponent couldn't be greeted
+     */
+    bool host(const std::string& address, unsigned int seed, unsigned int inputDelay = VERSUS_INPUT_DELAY);
+
+    /**
+     * \brief Connects to a host and starts the match once it answers. The guest is player 1.
+     *
+     * \return false if the connection couldn't be made or the host didn't answer properly
+     */
+    bool join(const std::string& address);
+
+    /**
+     * \brief Delays everything sent by a number of seconds, to imitate a slow network
+     */
+    void setLatency(double seconds);
+
+    /**
+     * \brief Handles the opponent's input, rolls back if it was mispredicted, then applies local input and steps
+     *      both games by one tick (unless too far ahead of the opponent). Call once per frame.
+     *
+     * \param localInput    The keys the local player is holding, as from updateInput()
+     *
+     * \return false if the opponent disconnected or sent something invalid
+     */
+    bool advance(uint8_t localInput);
+
+    /**
+     * \brief Plays the match in a window, local player on the left, until the window is closed or the opponent leaves
+     *
+     * \param window        A window WINDOW_WIDTH wide and WINDOW_HEIGHT / 2 high, each game is drawn at half size
+     *        autopilot     If true, an Autopilot plays for the local player instead of the keyboard
+     */
+    void run(sf::RenderWindow& window, bool autopilot);
+
+    /**
+     * \brief Plays the match with an Autopilot and no window for a number of seconds, or until the opponent leaves
+     */
+    void runHeadless(double seconds);
+
+    /**
+     * \brief Writes how often the match rolled back and stalled, how long rollbacks took, and whether the peers agreed
+     */
+    void writeSummary(std::ostream& out) const;
+
+    /**
+     * \brief Returns a player's game. Player 0 is the host.
+     */
+    GraphicsRunner& getGame(unsigned int player);
+
+    /**
+     * \brief Returns which player is playing in this process
+     */
+    unsigned int getLocalPlayer() const;
+
+    /**
+     * \brief Updates a set of held keys from a key event
+     *
+     * \return The keys held after the event, one bit per key in VERSUS_KEYS
+     */
+    static uint8_t updateInput(uint8_t input, const sf::Event& event);
+
+private:
+    /**
+     * \brief Creates both games and clears the input history, once the seed and input delay are agreed on
+     */
+    void start(unsigned int seed, unsigned int inputDelay);
+
+    /**
+     * \brief Saves a snapshot of both games, applies both players' input for the tick, and steps both games
+     *
+     * \details The opponent's input is predicted if it isn't known yet. Junk rows are handed out after both games have
+     *      stepped so neither game's tick depends on the order they are stepped in.
+     */
+    void simulate(unsigned long tick);
+
+    /**
+     * \brief Restores both games to the start of rollbackTick_ and re-simulates them up to tick_
+     */
+    void rollback();
+
+    /**
+     * \brief Sends the key presses and releases that turn one tick's input into the next one's
+     */
+    void applyInput(GraphicsRunner& game, uint8_t previous, uint8_t current);
+
+    /**
+     * \brief Reads everything the opponent has sent and handles each complete message
+     *
+     * \return false if the connection closed or a message was invalid
+     */
+    bool receive();
+
+    /**
+     * \brief Hashes the snapshots of both games at a tick, and compares hashes with the opponent's
+     */
+    void checkSums();
+
+    /**
+     * \brief Queues a message to be sent once the artificial latency has passed
+     */
+    void send(const std::vector<uint8_t>& message);
+
+    /**
+     * \brief Sends every queued message whose latency has passed, as much as the socket takes
+     *
+     * \return false if the connection failed
+     */
+    bool flush();
+
+    /**
+     * \brief Returns seconds on a steady clock
+     */
+    static double now();
+
+    int fd_;
+    unsigned int localPlayer_;
+    unsigned int inputDelay_;
+    GraphicsRunner* games_[2];
+
+    unsigned long tick_;                                ///< The next tick to simulate
+    uint8_t inputs_[2][VERSUS_INPUT_HISTORY];           ///< Each player's known input, indexed by tick
+    uint8_t usedInputs_[2][VERSUS_INPUT_HISTORY];       ///< The input each tick was last simulated with
+    unsigned long numInputs_[2];                        ///< Input is known for every tick before this
+    unsigned long rollbackTick_;                        ///< The earliest mispredicted tick, tick_ if there is none
+    GameState snapshots_[2][VERSUS_MAX_ROLLBACK + 1];   ///< Both games at the start of each of the last ticks
+
+    // Connection
+    std::vector<uint8_t> input_;        ///< Received bytes that don't make up a whole message yet
+    std::vector<uint8_t> output_;       ///< Bytes whose latency has passed, waiting to be sent
+    unsigned long outputSent_;
+    std::vector<uint8_t> delayed_;      ///< Bytes waiting out the artificial latency
+    std::deque<std::pair<double, unsigned long>> delayedSizes_;    ///< When each delayed message is due, and its size
+    std::vector<uint8_t> message_;      ///< Reused to encode each message
+    double latency_;
+
+    // Desync checks
+    unsigned long nextChecksumTick_;
+    std::deque<std::pair<unsigned long, uint32_t>> localChecksums_;     ///< Sent but not yet compared
+    std::deque<std::pair<unsigned long, uint32_t>> remoteChecksums_;    ///< Received but not yet compared
+
+    // Statistics
+    unsigned long numFrames_;
+    unsigned long numStalls_;           ///< Frames the games didn't advance because the opponent's input was late
+    unsigned long numRollbacks_;
+    unsigned long numTicksResimulated_;
+    unsigned long maxRollbackTicks_;
+    double rollbackSeconds_;
+    double maxRollbackSeconds_;
+    unsigned long numChecksumsMatched_;
+    unsigned long numDesyncs_;
+};
+
+/**
+ * \brief The keys that make up a player's input, in bit order. Pausing isn't allowed in versus.
+ */
+const sf::Keyboard::Key VERSUS_KEYS[] = {sf::Keyboard::J, sf::Keyboard::L, sf::Keyboard::A, sf::Keyboard::D,
+                                         sf::Keyboard::Space, sf::Keyboard::Return};
+
+#endif //BRICKBREAKER_VERSUSSESSION_H
@@ -0,0 +1,108 @@
+/**
+ * \file WorkerPool.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Implements a fixed set of worker threads that run one job together and wait for each other
+ */
+#include <algorithm>
+#include "WorkerPool.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+WorkerPool::WorkerPool(unsigned int numThreads, bool pinned)
+        : numThreads_(numThreads == 0 ? max(1u, thread::hardware_concurrency()) : numThreads),
+          job_(nullptr),
+          generation_(0),
+          running_(0),
+          stopping_(false)
+{
+    if (pinned)
+        pinThread(0);
+
+    for (unsigned int i = 1; i < numThreads_; ++i) {
+        threads_.emplace_back(&WorkerPool::work, this, i, pinned);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    started_.notify_all();
+    for (thread& worker : threads_) {
+        worker.join();
+    }
+}
+
+unsigned int WorkerPool::getNumThreads() const {
+    return numThreads_;
+}
+
+void WorkerPool::run(const function<void(unsigned int)>& job) {
+    // Start the other workers, take this thread's share, then wait for the rest
+    {
+        lock_guard<mutex> lock(mutex_);
+        job_ = &job;
+        running_ = (unsigned int)threads_.size();
+        ++generation_;
+    }
+    started_.notify_all();
+
+    job(0);
+
+    {
+        unique_lock<mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return running_ == 0; });
+        job_ = nullptr;
+    }
+}
+
+void WorkerPool::work(unsigned int worker, bool pinned) {
+    if (pinned)
+        pinThread(worker);
+
+    unsigned long generation = 0;
+    while (true) {
+        const function<void(unsigned int)>* job;
+        {
+            unique_lock<mutex> lock(mutex_);
+            started_.wait(lock, [&] { return stopping_ || generation_ != generation; });
+            if (stopping_)
+                return;
+            generation = generation_;
+            job = job_;
+        }
+
+        (*job)(worker);
+
+        {
+            lock_guard<mutex> lock(mutex_);
+            if (--running_ == 0)
+                finished_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::pinThread(unsigned int cpu) {
+#ifdef __linux__
+    unsigned int numCpus = max(1u, thread::hardware_concurrency());
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu % numCpus, &cpus);
+
+    // Not being able to pin is fine, the thread just runs wherever the scheduler puts it
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#else
+    (void)cpu;
+#endif
+}
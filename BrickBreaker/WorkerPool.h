@@ -0,0 +1,81 @@
+/**
+ * \file WorkerPool.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares a fixed set of worker threads that run one job together and wait for each other
+ */
+
+#ifndef BRICKBREAKER_WORKERPOOL_H
+#define BRICKBREAKER_WORKERPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \class WorkerPool
+ * \brief Runs a job on every worker at once and waits for all of them, the way batch runs, the server and split
+ *      screen step their games
+ *
+ * \details The thread calling run() is worker 0 and does its share of the job rather than waiting idle, so a pool of
+ *      n workers only starts n - 1 threads. They are started once and wait between jobs, so running a job costs a
+ *      wake up rather than a thread creation. Each job is given the worker's index, and usually takes every item
+ *      whose index is the worker plus a multiple of getNumThreads().
+ */
+class WorkerPool {
+public:
+    /**
+     * \brief Parametrized constructor for a worker pool
+     *
+     * \param numThreads    How many workers, including the thread that calls run(). 0 for one per hardware thread.
+     *        pinned        Pin each worker to its own cpu, worker 0 being the thread creating the pool, so whatever a
+     *                      worker allocates stays local to the core that uses it
+     */
+    explicit WorkerPool(unsigned int numThreads, bool pinned = false);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * \brief Stops and joins the worker threads
+     */
+    ~WorkerPool();
+
+    /**
+     * \brief Returns the number of workers, including the thread that calls run()
+     */
+    unsigned int getNumThreads() const;
+
+    /**
+     * \brief Calls job(worker) once for each worker, worker 0 on this thread, and returns once every call has
+     */
+    void run(const std::function<void(unsigned int)>& job);
+
+    /**
+     * \brief Pins the calling thread to a single cpu, if the platform allows it
+     */
+    static void pinThread(unsigned int cpu);
+
+private:
+    /**
+     * \brief The body of each worker thread. Waits for a job, runs it, and repeats.
+     */
+    void work(unsigned int worker, bool pinned);
+
+    unsigned int numThreads_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable started_;
+    std::condition_variable finished_;
+    const std::function<void(unsigned int)>* job_;  ///< The job being run, only valid during run()
+    unsigned long generation_;                      ///< Incremented to start each job
+    unsigned int running_;                          ///< Worker threads (other than worker 0) still running this job
+    bool stopping_;
+};
+
+#endif //BRICKBREAKER_WORKERPOOL_H
@@ -1,6 +1,13 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <unistd.h>
+#include "BatchRunner.h"
+#include "SpectatorViewer.h"
+#include "SplitScreen.h"
+#include "VersusSession.h"
 #include "GraphicsRunner.h"
 
 using namespace sf;
@@ -22,14 +29,139 @@ int main( int numArgs, char *args[]) {
     chdir(aux.substr(0,pos+1).c_str());
     // // // // // // // // // // // // // // // // // // // // // // // // //
 
+    // Run many headless games played by the autopilot instead of opening a window: --batch <instances> <ticks>
+    for (int i = 1; i + 2 < numArgs; ++i) {
+        if (strcmp(args[i], "--batch") == 0) {
+            BatchRunner batch((unsigned int)atoi(args[i + 1]), (unsigned int)time(0));
+            batch.run(strtoul(args[i + 2], nullptr, 10));
+            batch.writeSummary(std::cout);
+            return 0;
+        }
+    }
+
+    // Play a versus match against another process:
+    // --versus <host|join> <address> [--latency <ms>] [--input-delay <ticks>] [--autopilot] [--headless <seconds>]
+    for (int i = 1; i + 2 < numArgs; ++i) {
+        if (strcmp(args[i], "--versus") == 0) {
+            double latency = 0;
+            unsigned int inputDelay = VERSUS_INPUT_DELAY;
+            bool autopilot = false;
+            double headlessSeconds = 0;
+            for (int j = 1; j < numArgs; ++j) {
+                if (strcmp(args[j], "--latency") == 0 && j + 1 < numArgs)
+                    latency = atof(args[++j]) / 1000;
+                else if (strcmp(args[j], "--input-delay") == 0 && j + 1 < numArgs)
+                    inputDelay = (unsigned int)atoi(args[++j]);
+                else if (strcmp(args[j], "--autopilot") == 0)
+                    autopilot = true;
+                else if (strcmp(args[j], "--headless") == 0 && j + 1 < numArgs)
+                    headlessSeconds = atof(args[++j]);
+            }
+
+            VersusSession versus;
+            bool connected = strcmp(args[i + 1], "host") == 0
+                             ? versus.host(args[i + 2], (unsigned int)time(0), inputDelay)
+                             : versus.join(args[i + 2]);
+            if (!connected)
+                return 1;
+            versus.setLatency(latency);
+
+            // Headless matches are always played by the autopilot
+            if (headlessSeconds > 0) {
+                versus.runHeadless(headlessSeconds);
+            }
+            else {
+                sf::ContextSettings settings;
+                settings.antialiasingLevel = 8;
+                RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT / 2), "Brick Breaker Versus",
+                                    Style::Default, settings);
+                window.setFramerateLimit(FRAME_RATE);
+                versus.run(window, autopilot);
+            }
+
+            versus.writeSummary(std::cout);
+            return 0;
+        }
+    }
+
+    // Play two to four games in one window, the first <players> of them from the keyboard and the rest by autopilots:
+    // --split <games> [<players>]
+    for (int i = 1; i + 1 < numArgs; ++i) {
+        if (strcmp(args[i], "--split") == 0) {
+            unsigned int numGames = (unsigned int)atoi(args[i + 1]);
+            if (numGames < 2 || numGames > SPLIT_SCREEN_MAX_GAMES) {
+                std::cerr << "Split screen takes 2 to " << SPLIT_SCREEN_MAX_GAMES << " games" << std::endl;
+                return 1;
+            }
+            unsigned int numPlayers = i + 2 < numArgs ? (unsigned int)atoi(args[i + 2]) : 1;
+
+            sf::ContextSettings settings;
+            settings.antialiasingLevel = 8;
+            RenderWindow window(sf::VideoMode(WINDOW_WIDTH, numGames == 2 ? WINDOW_HEIGHT / 2 : WINDOW_HEIGHT),
+                                "Brick Breaker Split Screen", Style::Default, settings);
+            window.setFramerateLimit(FRAME_RATE);
+
+            SplitScreen split(window, numGames, numPlayers, (unsigned int)time(0));
+            split.run();
+            split.writeSummary(std::cout);
+            return 0;
+        }
+    }
+
     // Initialize the window with antialiasing and a fixed frame rate
     sf::ContextSettings settings;
     settings.antialiasingLevel = 8;
     RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Brick Breaker", Style::Default, settings);
-    window.setFramerateLimit(60);
+    window.setFramerateLimit(FRAME_RATE);
+
+    // Watch a game on a server instead of playing: --watch <address> <game id>
+    for (int i = 1; i + 2 < numArgs; ++i) {
+        if (strcmp(args[i], "--watch") == 0) {
+            SpectatorViewer viewer(window);
+            if (!viewer.connect(args[i + 1], strtoul(args[i + 2], nullptr, 10)))
+                return 1;
+            viewer.run();
+            return 0;
+        }
+    }
 
     // Create a graphics runner to hold all the game's objects and handle the clear draw display loop
-    GraphicsRunner game = GraphicsRunner(window);
+    GraphicsRunner game(window);
+
+    // Command line options
+    bool perfCounters = false;
+    for (int i = 1; i < numArgs; ++i) {
+        // Read the CPU's hardware counters around each phase of a frame and print a report on exit
+        if (strcmp(args[i], "--perf-counters") == 0) {
+            perfCounters = true;
+            if (!game.profiler_.enableHardwareCounters()) {
+                std::cerr << "Could not open hardware performance counters" << std::endl;
+            }
+        }
+
+        // Run the game slower or faster, in ticks per frame
+        else if (strcmp(args[i], "--time-scale") == 0 && i + 1 < numArgs) {
+            game.setTimeScale((float)atof(args[++i]));
+        }
+
+        // Race each level against the best run through it
+        else if (strcmp(args[i], "--ghost") == 0) {
+            game.enableGhost();
+        }
+
+        // Special bricks drop their power-ups, which only take effect if caught
+        else if (strcmp(args[i], "--drops") == 0) {
+            game.enablePowerUpDrops();
+        }
+
+        // Replay a slow frame capture from BrickBreakerData/slowframes
+        else if (strcmp(args[i], "--replay") == 0 && i + 1 < numArgs) {
+            ++i;
+            if (!game.loadReplay(args[i])) {
+                std::cerr << "Could not load replay " << args[i] << std::endl;
+            }
+        }
+    }
 
     while (window.isOpen()) {
         Event event;
@@ -39,6 +171,10 @@ int main( int numArgs, char *args[]) {
 
         game.update();
     }
+
+    if (perfCounters) {
+        game.profiler_.writeReport(std::cout);
+    }
     return 0;
 }
 
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include "GameServer.h"
+#include "LoadTester.h"
+
+// The headless server and its load tester, built as their own executable since they are Linux only:
+//     BrickBreakerServer --server <address> [--server <address> ...]
+//     BrickBreakerServer --load-test <address> <clients> <seconds> [<spectators per client>]
+int main(int numArgs, char *args[]) {
+    // Change the working directory to the location of the executable, where the levels are
+    std::string aux(args[0]);
+    unsigned long pos = aux.rfind('/');
+    chdir(aux.substr(0, pos + 1).c_str());
+
+    // Host remote play sessions, on as many addresses as are given
+    GameServer* server = nullptr;
+    for (int i = 1; i + 1 < numArgs; ++i) {
+        if (strcmp(args[i], "--server") == 0) {
+            if (server == nullptr)
+                server = new GameServer((unsigned int)time(0));
+            if (!server->listen(args[++i])) {
+                delete server;
+                return 1;
+            }
+        }
+    }
+    if (server != nullptr) {
+        bool ran = server->run();
+        server->writeSummary(std::cout);
+        delete server;
+        return ran ? 0 : 1;
+    }
+
+    // Connect many clients to a server and check its stream
+    for (int i = 1; i + 3 < numArgs; ++i) {
+        if (strcmp(args[i], "--load-test") == 0) {
+            unsigned int spectators = i + 4 < numArgs ? (unsigned int)atoi(args[i + 4]) : 0;
+            LoadTester tester(args[i + 1], (unsigned int)atoi(args[i + 2]), spectators);
+            bool ran = tester.run(atof(args[i + 3]));
+            tester.writeSummary(std::cout);
+            return ran ? 0 : 1;
+        }
+    }
+
+    std::cerr << "Usage: " << args[0] << " --server <address> [--server <address> ...]" << std::endl;
+    std::cerr << "       " << args[0] << " --load-test <address> <clients> <seconds> [<spectators per client>]"
+              << std::endl;
+    return 1;
+}
@@ -0,0 +1,117 @@
+/**
+ * \file BallContactsTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests that BallContacts finds every touching pair of balls exactly once, in the same order however they're
+ *      listed
+ */
+#include <algorithm>
+#include <random>
+#include "../Ball.h"
+#include "../BallContacts.h"
+#include "../GraphicsRunner.h"
+#include "Check.h"
+
+using namespace sf;
+using namespace std;
+
+namespace {
+    /**
+     * \brief Returns the ids of every pair of balls touching, found by testing each against every other
+     */
+    vector<uint64_t> bruteForce(const vector<Object*>& objects, long firstBall) {
+        vector<uint64_t> ids;
+        Contact contact;
+        for (long i = firstBall; i < long(objects.size()); ++i) {
+            for (long j = firstBall; j < long(objects.size()); ++j) {
+                Ball* first = static_cast<Ball*>(objects[i]);
+                Ball* second = static_cast<Ball*>(objects[j]);
+                if (first->getId() >= second->getId() || first->isAttached() || second->isAttached()
+                    || first->delete_ || second->delete_) {
+                    continue;
+                }
+                if (collide(first->getShape(), second->getShape(), contact))
+                    ids.push_back(uint64_t(first->getId()) << 32 | second->getId());
+            }
+        }
+        sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    /**
+     * \brief Returns the ids of the pairs found
+     */
+    vector<uint64_t> pairIds(const BallContacts& contacts) {
+        vector<uint64_t> ids;
+        for (const BallContacts::Pair& pair : contacts.getPairs())
+            ids.push_back(pair.id);
+        return ids;
+    }
+}
+
+void testBallContacts() {
+    GraphicsRunner game(1);
+    vector<Object*> objects;
+
+    // Three balls with the same left edge, each touching the next, then a crowd of every size. The first object
+    // stands in for the game's other objects and overlaps every ball, but is before the first ball so isn't one.
+    objects.push_back(new Ball(game, 100, 100, 0, 0, BALL_COLOR, 200));
+    objects.push_back(new Ball(game, 20, 20, 0, 0));
+    objects.push_back(new Ball(game, 20, 35, 0, 0));
+    objects.push_back(new Ball(game, 20, 50, 0, 0));
+
+    mt19937 random(7);
+    uniform_real_distribution<float> position(0, 200);
+    const float radii[] = {BALL_RADIUS, BALL_BIG_RADIUS, BALL_RADIUS / 2};
+    for (int i = 0; i < 60; ++i)
+        objects.push_back(new Ball(game, position(random), position(random), 0, 0, BALL_COLOR, radii[i % 3]));
+
+    // Neither attached balls nor those about to be deleted are paired
+    objects.push_back(new Ball(game));
+    objects.push_back(new Ball(game, 20, 20, 0, 0));
+    objects.back()->delete_ = true;
+
+    BallContacts contacts;
+    contacts.find(objects, 1);
+    vector<uint64_t> expected = bruteForce(objects, 1);
+    CHECK(pairIds(contacts) == expected);
+    CHECK(expected.size() > 10);
+
+    Ball* top = static_cast<Ball*>(objects[1]);
+    Ball* middle = static_cast<Ball*>(objects[2]);
+    CHECK(!contacts.getPairs().empty() && contacts.getPairs()[0].first == top
+          && contacts.getPairs()[0].second == middle);
+
+    // Each pair is seen from its lower id, with the contact Collider<Circle, Circle> gives
+    Contact contact{};
+    for (const BallContacts::Pair& pair : contacts.getPairs()) {
+        CHECK(pair.first->getId() < pair.second->getId());
+        CHECK(collide(pair.first->getShape(), pair.second->getShape(), contact));
+        CHECK(pair.contact.normal == contact.normal && pair.contact.depth == contact.depth);
+    }
+
+    // Listed in any other order, the same pairs are found in the same order
+    for (int i = 0; i < 5; ++i) {
+        shuffle(objects.begin() + 1, objects.end(), random);
+        BallContacts shuffled;
+        shuffled.find(objects, 1);
+        CHECK(pairIds(shuffled) == expected);
+    }
+
+    // Two balls coming together swap their velocities along the normal, and are left alone once moving apart
+    Ball left(game, 0, 0, 3, 1);
+    Ball right(game, 15, 0, -2, 1);
+    vector<Object*> pair = {&left, &right};
+    contacts.find(pair, 0);
+    contacts.resolve();
+    CHECK(left.getVelocity() == Vector2f(-2, 1) && right.getVelocity() == Vector2f(3, 1));
+    contacts.find(pair, 0);
+    contacts.resolve();
+    CHECK(left.getVelocity() == Vector2f(-2, 1) && right.getVelocity() == Vector2f(3, 1));
+
+    for (Object* object : objects)
+        delete object;
+}
@@ -0,0 +1,123 @@
+/**
+ * \file BrickGridTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests BrickGrid's ray casts and queries against testing every brick on the stage
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "../Brick.h"
+#include "../BrickGrid.h"
+#include "../Constants.h"
+#include "Check.h"
+
+using namespace sf;
+using namespace std;
+
+namespace {
+    /**
+     * \brief Returns how far along a line a circle moving along it enters a box grown by its radius, or infinity if it
+     *      doesn't within maxDistance or already overlaps it
+     */
+    float entry(const Box& box, const Vector2f& origin, const Vector2f& direction, float maxDistance, float radius) {
+        const float infinity = numeric_limits<float>::infinity();
+        float enter = -infinity, leave = maxDistance;
+        const float starts[] = {origin.x, origin.y};
+        const float steps[] = {direction.x, direction.y};
+        const float lows[] = {box.left - radius, box.top - radius};
+        const float highs[] = {box.right + radius, box.bottom + radius};
+
+        for (int axis = 0; axis < 2; ++axis) {
+            if (steps[axis] == 0) {
+                if (starts[axis] <= lows[axis] || starts[axis] >= highs[axis])
+                    return infinity;
+                continue;
+            }
+
+            float in = (lows[axis] - starts[axis]) / steps[axis];
+            float out = (highs[axis] - starts[axis]) / steps[axis];
+            enter = max(enter, min(in, out));
+            leave = min(leave, max(in, out));
+        }
+        return enter >= 0 && enter < leave ? enter : infinity;
+    }
+}
+
+void testBrickGrid() {
+    // Bricks of every size scattered over the stage, overlapping each other, after a couple of objects that aren't
+    // bricks as far as the grid knows
+    const Vector2u stageSize(800, 600);
+    mt19937 random(3);
+    uniform_real_distribution<float> x(0, 760), y(0, 400), width(10, 40), height(5, 20);
+
+    vector<Object*> objects;
+    const long first = 2;
+    for (int i = 0; i < 250; ++i)
+        objects.push_back(new Brick(x(random), y(random), width(random), height(random)));
+
+    BrickGrid grid;
+    grid.build(objects, first, long(objects.size()), stageSize, BALL_RADIUS);
+    CHECK(grid.isValid());
+
+    // Rays and moving circles of each size, smaller and bigger than the margin, in every direction and straight along
+    // each axis. The grid has to find the same nearest brick as testing every one.
+    uniform_real_distribution<float> originX(0, 800), originY(0, 600), angle(0, 6.2831853f), length(0, 900);
+    const float radii[] = {0, BALL_RADIUS / 2, BALL_RADIUS, BALL_BIG_RADIUS, 60};
+    const Vector2f axes[] = {Vector2f(0, -1), Vector2f(1, 0), Vector2f(0, 1), Vector2f(-1, 0)};
+    unsigned int numHits = 0;
+    for (int i = 0; i < 2000; ++i) {
+        Vector2f origin(originX(random), originY(random));
+        float turn = angle(random);
+        Vector2f direction = i % 5 == 0 ? axes[i / 5 % 4] : Vector2f(cosf(turn), sinf(turn));
+        float maxDistance = length(random);
+        float radius = radii[i % 5];
+
+        float nearest = numeric_limits<float>::infinity();
+        for (long brick = first; brick < long(objects.size()); ++brick) {
+            const Box& box = static_cast<Brick*>(objects[brick])->getShape();
+            nearest = min(nearest, entry(box, origin, direction, maxDistance, radius));
+        }
+
+        BrickGrid::Hit hit;
+        bool found = grid.rayCast(origin, direction, maxDistance, radius, hit);
+        CHECK(found == (nearest < maxDistance));
+        if (!found || nearest >= maxDistance)
+            continue;
+
+        ++numHits;
+        CHECK(hit.index >= first && hit.index < long(objects.size()));
+        float tolerance = 1e-3f * max(1.f, nearest);
+        CHECK(fabsf(hit.distance - nearest) <= tolerance);
+        if (hit.index >= first && hit.index < long(objects.size())) {
+            const Box& box = static_cast<Brick*>(objects[hit.index])->getShape();
+            CHECK(fabsf(entry(box, origin, direction, maxDistance, radius) - hit.distance) <= tolerance);
+        }
+    }
+    CHECK(numHits > 200);
+
+    // Every brick a circle touches is listed once, in increasing order, whatever the circle's size
+    for (int i = 0; i < 2000; ++i) {
+        Circle circle{Vector2f(originX(random), originY(random)), radii[i % 5], Vector2f(0, 0)};
+        const vector<long>& found = grid.query(circle);
+        CHECK(is_sorted(found.begin(), found.end()) && adjacent_find(found.begin(), found.end()) == found.end());
+
+        for (long brick = 0; brick < long(objects.size()); ++brick) {
+            const Box& box = static_cast<Brick*>(objects[brick])->getShape();
+            float dx = min(max(circle.center.x, box.left), box.right) - circle.center.x;
+            float dy = min(max(circle.center.y, box.top), box.bottom) - circle.center.y;
+            bool touching = dx * dx + dy * dy < circle.radius * circle.radius;
+            bool listed = binary_search(found.begin(), found.end(), brick);
+            CHECK(!listed || brick >= first);
+            if (brick >= first && touching)
+                CHECK(listed);
+        }
+    }
+
+    for (Object* object : objects)
+        delete object;
+}
@@ -0,0 +1,103 @@
+/**
+ * \file BrickScriptTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests that the script compiler keeps the stack in bounds and that runs are cut off where they should be
+ */
+#include <fstream>
+#include <sstream>
+#include "../BrickScript.h"
+#include "../GameState.h"
+#include "../GraphicsRunner.h"
+#include "Check.h"
+
+using namespace std;
+
+namespace {
+    bool compiles(const string& source) {
+        BrickScript scripts;
+        istringstream in(source);
+        string error;
+        return scripts.compile(in, error);
+    }
+
+    /**
+     * \brief Returns a script of n pushes, then as many pops
+     */
+    string pushes(unsigned int n) {
+        string source = "script 1\n";
+        for (unsigned int i = 0; i < n; ++i)
+            source += "    push 1\n";
+        for (unsigned int i = 0; i < n; ++i)
+            source += "    pop\n";
+        return source;
+    }
+
+    const int LEVEL = 50;   ///< Far past the game's own levels, so this pack never clashes with one
+}
+
+void testBrickScript() {
+    // The stack may get exactly BRICK_SCRIPT_STACK deep, on every path through the script
+    CHECK(compiles(pushes(BRICK_SCRIPT_STACK)));
+    CHECK(!compiles(pushes(BRICK_SCRIPT_STACK + 1)));
+    CHECK(!compiles("script 1\n    pop\n"));
+    CHECK(!compiles("script 1\n    add\n"));
+    CHECK(!compiles("script 1\nloop:\n    push 1\n    jump loop\n"));
+    CHECK(!compiles("script 1\n    hits\n    jumpif skip\n    push 1\nskip:\n    pop\n"));
+    CHECK(compiles("script 1\n    push 1\nloop:\n    dup\n    jumpif loop\n    pop\n"));
+
+    // A run that never ends is cut off at BRICK_SCRIPT_STEPS_PER_RUN, or sooner if the tick's budget runs out first
+    BrickScript scripts;
+    istringstream source("script 1\nloop:\n    jump loop\n");
+    string error;
+    CHECK(scripts.compile(source, error));
+
+    int16_t registers[BRICK_SCRIPT_REGISTERS] = {};
+    BrickScriptRun run;
+    run.hits = 1;
+    run.signaled = false;
+    run.registers = registers;
+
+    unsigned int budget = BRICK_SCRIPT_STEPS_PER_TICK;
+    CHECK(scripts.run(1, run, budget) == BRICK_SCRIPT_STEPS_PER_RUN);
+    CHECK(budget == BRICK_SCRIPT_STEPS_PER_TICK - BRICK_SCRIPT_STEPS_PER_RUN);
+
+    budget = 10;
+    CHECK(scripts.run(1, run, budget) == 10);
+    CHECK(budget == 0);
+
+    // A game with two scripted bricks, one whose script ends straight away and one that always runs out of steps.
+    // The stage builder made BrickBreakerData in the working directory when the game was created.
+    GraphicsRunner game(1);
+    ofstream("BrickBreakerData/levels/" + to_string(LEVEL) + ".scripts")
+            << "script 1\n    end\nscript 2\nloop:\n    jump loop\n";
+
+    GameState state;
+    game.saveState(state);
+    state.level = LEVEL;
+    long quick = state.numSafetyBricks;
+    long slow = quick + 1;
+    for (long i : {quick, slow}) {
+        state.bricks[i].special = 'x';
+        state.bricks[i].hitPoints = 0;
+        state.bricks[i].script = int8_t(i == quick ? 1 : 2);
+    }
+    game.restoreState(state);
+
+    // Hits past the end of the queue are dropped, and aren't counted
+    for (unsigned int i = 0; i < BRICK_SCRIPT_MAX_EVENTS + 6; ++i)
+        game.hitBrick(game.indexOfFirstSafetyBrick_ + quick);
+    game.step();
+    game.saveState(state);
+    CHECK(state.bricks[quick].hits == int(BRICK_SCRIPT_MAX_EVENTS));
+
+    // Hits whose scripts the tick had no steps left for are dropped too, and aren't counted either
+    for (unsigned int i = 0; i < BRICK_SCRIPT_MAX_EVENTS; ++i)
+        game.hitBrick(game.indexOfFirstSafetyBrick_ + slow);
+    game.step();
+    game.saveState(state);
+    CHECK(state.bricks[slow].hits == int(BRICK_SCRIPT_STEPS_PER_TICK / BRICK_SCRIPT_STEPS_PER_RUN));
+}
@@ -0,0 +1,38 @@
+/**
+ * \file Check.h
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Declares the check the unit tests make and the tests TestMain.cpp runs
+ */
+
+#ifndef BRICKBREAKER_CHECK_H
+#define BRICKBREAKER_CHECK_H
+
+#include <iostream>
+
+extern unsigned int numFailedChecks;    ///< Counted by CHECK(), a test fails if any of its checks did
+
+/**
+ * \brief Prints a condition and where it is if it is false, then carries on with the test
+ */
+#define CHECK(condition)                                                                                    \
+    do {                                                                                                    \
+        if (!(condition)) {                                                                                 \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #condition ") failed" << std::endl;      \
+            ++numFailedChecks;                                                                              \
+        }                                                                                                   \
+    } while (false)
+
+// One per test file, each run by ctest as its own test (see TestMain.cpp)
+void testGameState();
+void testBrickScript();
+void testStateEncoder();
+void testCollision();
+void testBallContacts();
+void testExplosions();
+void testBrickGrid();
+
+#endif //BRICKBREAKER_CHECK_H
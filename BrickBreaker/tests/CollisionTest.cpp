@@ -0,0 +1,105 @@
+/**
+ * \file CollisionTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests the contacts Collision.h finds between a circle and each shape a ball can hit
+ */
+#include <cmath>
+#include "../Collision.h"
+#include "Check.h"
+
+using namespace sf;
+
+namespace {
+    /**
+     * \brief Returns true if two vectors are the same, give or take rounding
+     */
+    bool near(const Vector2f& first, const Vector2f& second) {
+        return std::fabs(first.x - second.x) < 1e-4f && std::fabs(first.y - second.y) < 1e-4f;
+    }
+
+    /**
+     * \brief Checks that a contact was found, and is the one expected
+     */
+    template <typename Second>
+    void checkContact(const Circle& circle, const Second& second, Vector2f normal, Vector2f point, float depth) {
+        Contact contact;
+        bool touching = collide(circle, second, contact);
+        CHECK(touching);
+        if (!touching)
+            return;
+
+        CHECK(near(contact.normal, normal));
+        CHECK(near(contact.point, point));
+        CHECK(std::fabs(contact.depth - depth) < 1e-4f);
+    }
+
+    /**
+     * \brief Checks that no contact was found
+     */
+    template <typename Second>
+    void checkMiss(const Circle& circle, const Second& second) {
+        Contact contact;
+        CHECK(!collide(circle, second, contact));
+    }
+
+    /**
+     * \brief Returns a still circle
+     */
+    Circle circle(float x, float y, float radius) {
+        return Circle{Vector2f(x, y), radius, Vector2f(0, 0)};
+    }
+}
+
+void testCollision() {
+    // A box's top, bottom and sides, by the point of the circle the box holds
+    const Box box{0, 0, 100, 20};
+    checkContact(circle(50, -5, 10), box, Vector2f(0, -1), Vector2f(50, 0), 5);
+    checkContact(circle(50, 25, 10), box, Vector2f(0, 1), Vector2f(50, 20), 5);
+    checkContact(circle(-5, 10, 10), box, Vector2f(-1, 0), Vector2f(0, 10), 5);
+    checkContact(circle(105, 10, 10), box, Vector2f(1, 0), Vector2f(100, 10), 5);
+    checkMiss(circle(50, -20, 10), box);
+
+    // Its corners, only once the circle itself and not just the square around it overlaps
+    float diagonal = std::sqrt(50.f);
+    checkContact(circle(-5, -5, 10), box, Vector2f(-5, -5) / diagonal, Vector2f(0, 0), 10 - diagonal);
+    checkContact(circle(105, 25, 10), box, Vector2f(5, 5) / diagonal, Vector2f(100, 20), 10 - diagonal);
+    checkMiss(circle(-8, -8, 10), box);
+
+    // A circle whose center is inside, pushed out of the side it is least far past
+    const Box deep{0, 0, 100, 40};
+    checkContact(circle(50, 8, 5), deep, Vector2f(0, -1), Vector2f(50, 0), 13);
+    checkContact(circle(50, 33, 5), deep, Vector2f(0, 1), Vector2f(50, 40), 12);
+    checkContact(circle(97, 20, 5), deep, Vector2f(1, 0), Vector2f(100, 20), 8);
+
+    // Boxes thinner than the circle, which hold none of its extreme points, hit on the side facing its center
+    const Box flat{0, 0, 100, 4};
+    checkContact(circle(50, 6, 10), flat, Vector2f(0, 1), Vector2f(50, 4), 8);
+    checkContact(circle(50, -1, 10), flat, Vector2f(0, -1), Vector2f(50, 0), 9);
+    const Box upright{0, 0, 4, 100};
+    checkContact(circle(-3, 50, 10), upright, Vector2f(-1, 0), Vector2f(0, 50), 7);
+    checkContact(circle(7, 50, 10), upright, Vector2f(1, 0), Vector2f(4, 50), 7);
+
+    // A capsule's flat sides use its own normal, its rounded ends the direction to the circle
+    const Capsule paddle{Vector2f(0, 0), Vector2f(100, 0), 5, Vector2f(0, -1), Vector2f(1, 0)};
+    checkContact(circle(50, -12, 10), paddle, Vector2f(0, -1), Vector2f(50, -5), 3);
+    checkContact(circle(50, 12, 10), paddle, Vector2f(0, 1), Vector2f(50, 5), 3);
+    Vector2f end = Vector2f(10, -6) / std::sqrt(136.f);
+    checkContact(circle(110, -6, 10), paddle, end, Vector2f(100, 0) + end * 5.f, 15 - std::sqrt(136.f));
+    checkContact(circle(100, 0, 10), paddle, Vector2f(0, 1), Vector2f(100, 5), 15);
+    checkMiss(circle(50, -16, 10), paddle);
+    checkMiss(circle(115, 0, 10), paddle);
+
+    Contact contact;
+    CHECK(collide(circle(50, -12, 10), paddle, contact) && contact.otherVel == paddle.vel);
+
+    // Another circle, except one at almost the same spot, which has no sensible normal
+    const Circle other{Vector2f(15, 0), 10, Vector2f(2, 3)};
+    checkContact(circle(0, 0, 10), other, Vector2f(-1, 0), Vector2f(5, 0), 5);
+    CHECK(collide(circle(0, 0, 10), other, contact) && contact.otherVel == other.vel);
+    checkMiss(circle(-5, 0, 10), other);
+    checkMiss(circle(13, 0, 10), other);
+}
@@ -0,0 +1,143 @@
+/**
+ * \file ExplosionsTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests that chain reactions reach the bricks they should and leave armored and scripted bricks standing
+ */
+#include <random>
+#include "../Brick.h"
+#include "../BrickBatch.h"
+#include "../BrickGrid.h"
+#include "../Constants.h"
+#include "../Explosions.h"
+#include "Check.h"
+
+using namespace sf;
+using namespace std;
+
+namespace {
+    /**
+     * \brief A row or grid of bricks, with everything Explosions::spread() needs of the game
+     */
+    struct Stage {
+        vector<Object*> objects;
+        BrickBatch bricks;
+        BrickGrid grid;
+
+        ~Stage() {
+            for (Object* object : objects)
+                delete object;
+        }
+
+        void add(float x, float y, char special) {
+            Brick* brick = new Brick(x, y, 30, 10, special);
+            objects.push_back(brick);
+            bricks.add(*brick);
+        }
+
+        void build() {
+            grid.build(objects, 0, long(objects.size()), Vector2u(800, 600), BALL_RADIUS);
+        }
+    };
+
+    /**
+     * \brief Returns whether a brick is in a set of bits
+     */
+    bool contains(const vector<uint64_t>& set, unsigned long brick) {
+        return brick / 64 < set.size() && (set[brick / 64] >> (brick % 64) & 1) != 0;
+    }
+
+    /**
+     * \brief Returns the bricks a reaction destroys, found ring by ring by testing every brick against every blast
+     */
+    vector<bool> bruteForce(const Stage& stage, const vector<unsigned long>& triggered) {
+        vector<bool> destroyed(stage.objects.size(), false);
+        vector<unsigned long> ring = triggered;
+        for (unsigned long brick : triggered)
+            destroyed[brick] = true;
+
+        while (!ring.empty()) {
+            vector<unsigned long> next;
+            for (unsigned long exploding : ring) {
+                const Box& blast = static_cast<Brick*>(stage.objects[exploding])->getShape();
+                Vector2f center((blast.left + blast.right) / 2, (blast.top + blast.bottom) / 2);
+
+                for (unsigned long brick = 0; brick < stage.objects.size(); ++brick) {
+                    char type = stage.bricks.getType(brick);
+                    if (destroyed[brick] || type == 'a' || type == 'x')
+                        continue;
+
+                    const Box& box = static_cast<Brick*>(stage.objects[brick])->getShape();
+                    float x = min(max(center.x, box.left), box.right) - center.x;
+                    float y = min(max(center.y, box.top), box.bottom) - center.y;
+                    if (x * x + y * y > BRICK_EXPLOSION_RADIUS * BRICK_EXPLOSION_RADIUS)
+                        continue;
+
+                    destroyed[brick] = true;
+                    if (type == 'e')
+                        next.push_back(brick);
+                }
+            }
+            ring = next;
+        }
+        return destroyed;
+    }
+}
+
+void testExplosions() {
+    // A row where each blast only reaches the bricks either side. Setting off brick 2 sets off 3 and 4 in turn, which
+    // take out 5, while the armored brick 1 survives right next to it. Brick 7 is explosive but out of reach.
+    const char row[] = {'\0', 'a', 'e', 'e', 'e', '\0', '\0', 'e', 'x', '\0'};
+    Stage line;
+    for (unsigned long i = 0; i < sizeof(row); ++i)
+        line.add(float(i * 32), 100, row[i]);
+    line.build();
+
+    Explosions explosions;
+    CHECK(!explosions.isPending());
+    explosions.trigger(2);
+    CHECK(explosions.isPending());
+    CHECK(explosions.spread(line.objects, 0, long(line.objects.size()), line.bricks, line.grid) > 0);
+    CHECK(!explosions.isPending());
+
+    const bool chained[] = {false, false, true, true, true, true, false, false, false, false};
+    for (unsigned long i = 0; i < sizeof(row); ++i)
+        CHECK(contains(explosions.getDestroyed(), i) == chained[i]);
+
+    // The next reaction starts over, and the scripted brick next to it is left standing like the armored one
+    explosions.trigger(7);
+    explosions.spread(line.objects, 0, long(line.objects.size()), line.bricks, line.grid);
+    const bool alone[] = {false, false, false, false, false, false, true, true, false, false};
+    for (unsigned long i = 0; i < sizeof(row); ++i)
+        CHECK(contains(explosions.getDestroyed(), i) == alone[i]);
+
+    // A full stage of mixed bricks, over more than one word of bits, against testing every brick with every blast
+    Stage stage;
+    mt19937 random(11);
+    uniform_int_distribution<int> pick(0, 19);
+    for (int y = 0; y < 12; ++y) {
+        for (int x = 0; x < 24; ++x) {
+            int roll = pick(random);
+            stage.add(float(x * 32), float(y * 12), roll < 6 ? 'e' : roll < 8 ? 'a' : roll < 9 ? 'x' : '\0');
+        }
+    }
+    stage.build();
+
+    vector<unsigned long> triggered;
+    for (unsigned long brick = 5; brick < stage.objects.size(); brick += 97) {
+        explosions.trigger(brick);
+        triggered.push_back(brick);
+    }
+    explosions.spread(stage.objects, 0, long(stage.objects.size()), stage.bricks, stage.grid);
+
+    vector<bool> expected = bruteForce(stage, triggered);
+    unsigned long numDestroyed = 0;
+    for (unsigned long i = 0; i < stage.objects.size(); ++i) {
+        CHECK(contains(explosions.getDestroyed(), i) == expected[i]);
+        numDestroyed += expected[i];
+    }
+    CHECK(numDestroyed > triggered.size());
+}
@@ -0,0 +1,95 @@
+/**
+ * \file GameStateTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests that snapshots read back exactly as they were written
+ */
+#include <sstream>
+#include "../GameState.h"
+#include "../GraphicsRunner.h"
+#include "Check.h"
+
+using namespace std;
+
+namespace {
+    /**
+     * \brief Writes a state, reads it back, and checks that nothing changed on the way
+     */
+    void checkRoundTrip(const GameState& state) {
+        ostringstream out;
+        state.write(out);
+
+        GameState read;
+        istringstream in(out.str());
+        CHECK(read.read(in));
+        CHECK(read == state);
+
+        // Writing what was read gives the same text, so a snapshot can be read and written any number of times
+        ostringstream again;
+        read.write(again);
+        CHECK(again.str() == out.str());
+    }
+}
+
+void testGameState() {
+    // A game part way through its first level
+    GraphicsRunner game(1234);
+    game.releaseBall();
+    for (int i = 0; i < 300; ++i)
+        game.step();
+
+    GameState state;
+    game.saveState(state);
+    checkRoundTrip(state);
+
+    // Restored, the game hands out the same ball ids it would have, even past balls that have since been lost
+    GameState lost = state;
+    lost.nextBallId += 5;
+    game.restoreState(lost);
+    GameState restored;
+    game.saveState(restored);
+    CHECK(restored == lost);
+    CHECK(restored.nextBallId == state.nextBallId + 5);
+
+    // Every kind of value a snapshot holds, with floats that only read back exactly with every digit written
+    state.random.discard(17);
+    state.paddle.x = 1.0f / 3;
+    state.timerStart = 2.0 / 3;
+    state.bricks[0].special = 'r';
+    state.bricks[0].hitPoints = 2;
+    state.bricks[1].special = 'x';
+    state.bricks[1].script = 7;
+    state.bricks[1].hits = 300;
+    state.bricks[1].shade = 3;
+    state.bricks[1].registers[0] = -2;
+    state.bricks[1].registers[BRICK_SCRIPT_REGISTERS - 1] = 32767;
+    state.bricks[2].special = '\0';
+    state.bricks[2].deleted = true;
+    state.balls[0].radius = 0.1f;
+    state.balls[0].resizeTimer = 12.25;
+    state.nextBallId = 4000000000u;
+    state.dropPowerUps = true;
+    state.powerUps.push_back(GameState::PowerUpState{10.5f, 20.0f / 7, 'z'});
+    state.powerUps.push_back(GameState::PowerUpState{0, 0, 'p'});
+    state.laserTimer = 40.0 / 3;
+    state.lasers.push_back(GameState::LaserState{100.0f / 9, 5});
+    checkRoundTrip(state);
+
+    // Nothing at all, which can still be read back
+    GameState empty = state;
+    empty.bricks.clear();
+    empty.balls.clear();
+    empty.powerUps.clear();
+    empty.lasers.clear();
+    checkRoundTrip(empty);
+
+    // A snapshot cut off part way through doesn't read as complete
+    ostringstream out;
+    state.write(out);
+    GameState truncated;
+    istringstream in(out.str().substr(0, out.str().size() / 2));
+    CHECK(!truncated.read(in));
+}
@@ -0,0 +1,187 @@
+/**
+ * \file StateEncoderTest.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Tests that what StateDecoder rebuilds from StateEncoder's keyframes and deltas matches the game
+ */
+#include <cmath>
+#include "../Constants.h"
+#include "../GraphicsRunner.h"
+#include "../StateDecoder.h"
+#include "../StateEncoder.h"
+#include "Check.h"
+
+using namespace std;
+
+namespace {
+    /**
+     * \brief Returns true if a position survived being quantized
+     */
+    bool near(float sent, float received) {
+        return fabs(sent - received) <= 0.5f / POSITION_SCALE;
+    }
+
+    /**
+     * \brief Applies every message in a buffer, returning the number applied or -1 if one was rejected
+     */
+    int applyAll(StateDecoder& decoder, const vector<uint8_t>& buffer) {
+        int numMessages = 0;
+        size_t offset = 0;
+        MessageType type;
+        MessageReader payload;
+        while (MessageReader::next(buffer.data(), buffer.size(), offset, type, payload)) {
+            if (!decoder.apply(type, payload))
+                return -1;
+            ++numMessages;
+        }
+        return offset == buffer.size() ? numMessages : -1;
+    }
+
+    /**
+     * \brief Checks that the decoder holds everything visible in a state
+     */
+    void checkDecoded(const GameState& state, const StateDecoder& decoder) {
+        const GameState& decoded = decoder.getState();
+        CHECK(decoder.hasKeyframe());
+        CHECK(decoded.tick == state.tick);
+        CHECK(decoded.level == state.level);
+        CHECK(decoded.status == state.status);
+
+        CHECK(near(state.paddle.x, decoded.paddle.x));
+        CHECK(near(state.paddle.y, decoded.paddle.y));
+        CHECK(near(state.paddle.width, decoded.paddle.width));
+        CHECK(fabs(state.paddle.rotation - decoded.paddle.rotation) <= 0.005f);
+
+        // The decoder keeps destroyed bricks in its list, so compare the ones still standing
+        vector<const GameState::BrickState*> sent, received;
+        for (const GameState::BrickState& brick : state.bricks) {
+            if (!brick.deleted)
+                sent.push_back(&brick);
+        }
+        for (const GameState::BrickState& brick : decoded.bricks) {
+            if (!brick.deleted)
+                received.push_back(&brick);
+        }
+        CHECK(sent.size() == received.size());
+        for (unsigned long i = 0; i < sent.size() && i < received.size(); ++i) {
+            CHECK(near(sent[i]->x, received[i]->x) && near(sent[i]->y, received[i]->y));
+            CHECK(near(sent[i]->width, received[i]->width) && near(sent[i]->height, received[i]->height));
+            CHECK(sent[i]->special == received[i]->special);
+            CHECK(sent[i]->hitPoints == received[i]->hitPoints);
+        }
+
+        unsigned long numBalls = 0;
+        for (const GameState::BallState& ball : state.balls) {
+            if (ball.deleted)
+                continue;
+
+            CHECK(numBalls < decoded.balls.size());
+            if (numBalls < decoded.balls.size()) {
+                const GameState::BallState& received = decoded.balls[numBalls];
+                CHECK(near(ball.x, received.x) && near(ball.y, received.y));
+                CHECK(near(ball.radius, received.radius));
+            }
+            ++numBalls;
+        }
+        CHECK(numBalls == decoded.balls.size());
+    }
+}
+
+void testStateEncoder() {
+    // A game streamed tick by tick, with a brick that gets damaged, one that gets destroyed and a ball that grows
+    // part way through, none of which the game would do by itself in time
+    GraphicsRunner game(99);
+    game.releaseBall();
+
+    StateEncoder encoder;
+    StateDecoder decoder;
+    GameState state;
+    vector<uint8_t> buffer;
+    unsigned int numDeltas = 0;
+    for (int i = 0; i < 200; ++i) {
+        game.step();
+        game.saveState(state);
+
+        GameState::BrickState& hard = state.bricks[state.numSafetyBricks];
+        hard.special = 'r';
+        hard.hitPoints = uint8_t(i < 100 ? 3 : 1);
+        if (i >= 50)
+            state.bricks[state.numSafetyBricks + 1].deleted = true;
+        if (i >= 150)
+            state.balls[0].radius = BALL_BIG_RADIUS;
+
+        buffer.clear();
+        encoder.encode(state, buffer);
+        CHECK(applyAll(decoder, buffer) == 1);
+        CHECK(encoder.wroteKeyframe() == (i == 0));
+        numDeltas += !encoder.wroteKeyframe();
+        checkDecoded(state, decoder);
+    }
+    CHECK(numDeltas == 199);
+
+    // A keyframe starting over from scratch reads the same
+    StateDecoder late;
+    encoder.reset();
+    buffer.clear();
+    encoder.encode(state, buffer);
+    CHECK(encoder.wroteKeyframe());
+    CHECK(applyAll(late, buffer) == 1);
+    checkDecoded(state, late);
+
+    // A stage too big for one message has its keyframe split, and deltas after it work as usual
+    GameState big = state;
+    big.bricks.resize(KEYFRAME_MAX_BRICKS * 2 + 100);
+    for (unsigned long i = 0; i < big.bricks.size(); ++i) {
+        GameState::BrickState& brick = big.bricks[i];
+        brick.x = float(i % 128) * 6;
+        brick.y = float(i / 128) * 3;
+        brick.width = 5;
+        brick.height = 2;
+        brick.special = i % 7 == 0 ? 'h' : '\0';
+        brick.hitPoints = uint8_t(brick.special == 'h' ? 2 : 0);
+        brick.deleted = false;
+    }
+
+    StateEncoder bigEncoder;
+    StateDecoder bigDecoder;
+    buffer.clear();
+    bigEncoder.encode(big, buffer);
+    CHECK(bigEncoder.wroteKeyframe());
+    CHECK(applyAll(bigDecoder, buffer) == 3);
+    checkDecoded(big, bigDecoder);
+
+    ++big.tick;
+    big.bricks[KEYFRAME_MAX_BRICKS + 1].deleted = true;
+    big.bricks[(KEYFRAME_MAX_BRICKS * 2 / 7 + 1) * 7].hitPoints = 1;   // A hard brick in the last message
+    buffer.clear();
+    bigEncoder.encode(big, buffer);
+    CHECK(!bigEncoder.wroteKeyframe());
+    CHECK(applyAll(bigDecoder, buffer) == 1);
+    checkDecoded(big, bigDecoder);
+
+    // Only the whole keyframe counts, and nothing but a keyframe can start a stream
+    buffer.clear();
+    bigEncoder.reset();
+    bigEncoder.encode(big, buffer);
+    StateDecoder partial;
+    size_t offset = 0;
+    MessageType type;
+    MessageReader payload;
+    CHECK(MessageReader::next(buffer.data(), buffer.size(), offset, type, payload) && type == MESSAGE_KEYFRAME);
+    CHECK(partial.apply(type, payload));
+    CHECK(!partial.hasKeyframe());
+    CHECK(MessageReader::next(buffer.data(), buffer.size(), offset, type, payload) && type == MESSAGE_KEYFRAME_BRICKS);
+    CHECK(partial.apply(type, payload));
+    CHECK(!partial.hasKeyframe());
+
+    StateDecoder fresh;
+    CHECK(!fresh.apply(type, payload));
+    buffer.clear();
+    ++big.tick;
+    bigEncoder.encode(big, buffer);
+    CHECK(!bigEncoder.wroteKeyframe());
+    CHECK(applyAll(fresh, buffer) == -1);
+}
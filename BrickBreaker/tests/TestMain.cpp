@@ -0,0 +1,50 @@
+/**
+ * \file TestMain.cpp
+ *
+ * \author Gus Callaway
+ *
+ * \date 10/18/26
+ *
+ * \brief Runs the unit tests, one named on the command line or all of them
+ */
+#include <cstring>
+#include "Check.h"
+
+unsigned int numFailedChecks = 0;
+
+namespace {
+    struct Test {
+        const char* name;
+        void (*run)();
+    };
+
+    const Test TESTS[] = {
+        {"GameState", testGameState},
+        {"BrickScript", testBrickScript},
+        {"StateEncoder", testStateEncoder},
+        {"Collision", testCollision},
+        {"BallContacts", testBallContacts},
+        {"Explosions", testExplosions},
+        {"BrickGrid", testBrickGrid},
+    };
+}
+
+// BrickBreakerTests [<test name>]
+int main(int numArgs, char *args[]) {
+    bool found = false;
+    for (const Test& test : TESTS) {
+        if (numArgs > 1 && strcmp(args[1], test.name) != 0)
+            continue;
+
+        found = true;
+        unsigned int failedBefore = numFailedChecks;
+        test.run();
+        std::cout << test.name << (numFailedChecks == failedBefore ? " passed" : " failed") << std::endl;
+    }
+
+    if (!found) {
+        std::cerr << "No test named " << args[1] << std::endl;
+        return 1;
+    }
+    return numFailedChecks == 0 ? 0 : 1;
+}